@@ -258,31 +258,40 @@ end
 
 flags {"NoIncrementalLink", "NoMinimalRebuild", "MultiProcessorCompile", "No64BitChecks"}
 
-filter "platforms:x64"
+filter {"platforms:x64", "system:windows"}
 	defines {"_WINDOWS", "WIN32"}
 filter {}
 
 filter "configurations:Release"
 	optimize "Size"
-	buildoptions {"/bigobj"}
-	linkoptions { "/IGNORE:4702" }
 	defines {"NDEBUG"}
 	flags {"FatalCompileWarnings"}
 filter {}
 
 filter "configurations:Debug"
 	optimize "Debug"
-	buildoptions {"/bigobj"}
 	defines {"DEBUG", "_DEBUG"}
 filter {}
 
+filter "toolset:msc*"
+	buildoptions {"/bigobj"}
+filter {}
+
+filter {"configurations:Release", "toolset:msc*"}
+	linkoptions { "/IGNORE:4702" }
+filter {}
+
 include "src/zonetool.lua"
 include "src/common.lua"
 include "src/tlsdll.lua"
+include "src/zoneinspect.lua"
+include "src/tests.lua"
 
 common:project()
 zonetool:project()
 tlsdll:project()
+zoneinspect:project()
+tests:project()
 
 group "Dependencies"
 dependencies.projects()
\ No newline at end of file
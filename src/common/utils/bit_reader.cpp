@@ -0,0 +1,178 @@
+#include "bit_reader.hpp"
+
+#include <cassert>
+#include <cstring>
+
+namespace utils
+{
+	namespace
+	{
+		std::uint64_t byteswap(const std::uint64_t value)
+		{
+			return ((value & 0x00000000000000FFull) << 56) | ((value & 0x000000000000FF00ull) << 40) |
+				((value & 0x0000000000FF0000ull) << 24) | ((value & 0x00000000FF000000ull) << 8) |
+				((value & 0x000000FF00000000ull) >> 8) | ((value & 0x0000FF0000000000ull) >> 24) |
+				((value & 0x00FF000000000000ull) >> 40) | ((value & 0xFF00000000000000ull) >> 56);
+		}
+
+		// largest read served straight from the accumulator, a refill always leaves at least this many bits
+		constexpr std::size_t max_direct_bits = 56;
+	}
+
+	template <std::endian Order>
+	bit_reader<Order>::bit_reader(const std::span<const std::uint8_t> data)
+		: data_(data)
+	{
+	}
+
+	template <std::endian Order>
+	bit_reader<Order>::bit_reader(const void* data, const std::size_t size)
+		: data_(static_cast<const std::uint8_t*>(data), size)
+	{
+	}
+
+	template <std::endian Order>
+	void bit_reader<Order>::refill()
+	{
+		if (this->cursor_ + sizeof(std::uint64_t) <= this->data_.size())
+		{
+			std::uint64_t word{};
+			std::memcpy(&word, this->data_.data() + this->cursor_, sizeof(word));
+
+			if constexpr (Order != std::endian::native)
+			{
+				word = byteswap(word);
+			}
+
+			// bits past the whole bytes we keep are the real next bits, so or-ing them in again later is harmless
+			if constexpr (Order == std::endian::little)
+			{
+				this->accumulator_ |= word << this->accumulator_bits_;
+			}
+			else
+			{
+				this->accumulator_ |= word >> this->accumulator_bits_;
+			}
+
+			const auto bytes = (63 - this->accumulator_bits_) >> 3;
+			this->cursor_ += bytes;
+			this->accumulator_bits_ += bytes * 8;
+			return;
+		}
+
+		while (this->accumulator_bits_ <= max_direct_bits && this->cursor_ < this->data_.size())
+		{
+			const std::uint64_t byte = this->data_[this->cursor_++];
+
+			if constexpr (Order == std::endian::little)
+			{
+				this->accumulator_ |= byte << this->accumulator_bits_;
+			}
+			else
+			{
+				this->accumulator_ |= byte << (max_direct_bits - this->accumulator_bits_);
+			}
+
+			this->accumulator_bits_ += 8;
+		}
+	}
+
+	template <std::endian Order>
+	std::uint64_t bit_reader<Order>::take(const std::size_t num_bits)
+	{
+		assert(num_bits > 0 && num_bits <= max_direct_bits);
+
+		if (this->accumulator_bits_ < num_bits)
+		{
+			this->refill();
+		}
+
+		std::uint64_t value{};
+		if constexpr (Order == std::endian::little)
+		{
+			value = this->accumulator_ & ((1ull << num_bits) - 1);
+			this->accumulator_ >>= num_bits;
+		}
+		else
+		{
+			value = this->accumulator_ >> (64 - num_bits);
+			this->accumulator_ <<= num_bits;
+		}
+
+		this->accumulator_bits_ -= num_bits;
+		return value;
+	}
+
+	template <std::endian Order>
+	std::uint64_t bit_reader<Order>::read_bits(const std::size_t num_bits)
+	{
+		assert(num_bits <= 64);
+
+		if (!num_bits)
+		{
+			return 0;
+		}
+
+		if (this->position_ + num_bits > this->data_.size() * 8)
+		{
+			this->set_bit(this->position_ + num_bits);
+			return 0;
+		}
+
+		this->position_ += num_bits;
+
+		if (num_bits <= max_direct_bits)
+		{
+			return this->take(num_bits);
+		}
+
+		if constexpr (Order == std::endian::little)
+		{
+			const auto low = this->take(32);
+			return low | (this->take(num_bits - 32) << 32);
+		}
+		else
+		{
+			const auto high = this->take(num_bits - 32);
+			return (high << 32) | this->take(32);
+		}
+	}
+
+	template <std::endian Order>
+	std::uint64_t bit_reader<Order>::read_bits(const std::size_t bit_index, const std::size_t num_bits) const
+	{
+		auto reader = *this;
+		reader.set_bit(bit_index);
+		return reader.read_bits(num_bits);
+	}
+
+	template <std::endian Order>
+	void bit_reader<Order>::read_buffer(std::uint8_t* buffer, const std::size_t num_bits)
+	{
+		assert(num_bits % 8 == 0);
+
+		for (auto i = 0u; i < num_bits / 8; i++)
+		{
+			buffer[i] = this->read_bits<std::uint8_t>(8);
+		}
+	}
+
+	template <std::endian Order>
+	void bit_reader<Order>::set_bit(const std::size_t bit)
+	{
+		this->position_ = bit;
+		this->cursor_ = bit >> 3;
+		this->accumulator_ = 0;
+		this->accumulator_bits_ = 0;
+
+		const auto skip = bit & 7;
+		if (skip && this->cursor_ < this->data_.size())
+		{
+			this->refill();
+			this->take(skip);
+		}
+	}
+
+	template class bit_reader<std::endian::big>;
+	template class bit_reader<std::endian::little>;
+}
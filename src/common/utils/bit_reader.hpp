@@ -0,0 +1,60 @@
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <span>
+
+namespace utils
+{
+	// non-owning bit reader, bits are pulled out of a 64-bit accumulator that is refilled a word at a time
+	// big endian reads the most significant bit of each byte first (flac), little endian the least significant (dxbc)
+	template <std::endian Order>
+	class bit_reader
+	{
+	public:
+		bit_reader(std::span<const std::uint8_t> data);
+		bit_reader(const void* data, std::size_t size);
+
+		// reads past the end return 0 but still advance the position
+		std::uint64_t read_bits(std::size_t num_bits);
+		std::uint64_t read_bits(std::size_t bit_index, std::size_t num_bits) const;
+
+		std::uint64_t read_bytes(std::size_t num_bytes)
+		{
+			return this->read_bits(num_bytes * 8);
+		}
+
+		template <typename T> T read_bits(std::size_t num_bits)
+		{
+			return static_cast<T>(this->read_bits(num_bits));
+		}
+
+		template <typename T> T read_bits(std::size_t bit_index, std::size_t num_bits) const
+		{
+			return static_cast<T>(this->read_bits(bit_index, num_bits));
+		}
+
+		void read_buffer(std::uint8_t* buffer, std::size_t num_bits);
+
+		std::size_t total() const
+		{
+			return this->position_;
+		}
+
+		void set_bit(std::size_t bit);
+
+	private:
+		void refill();
+		std::uint64_t take(std::size_t num_bits);
+
+		std::span<const std::uint8_t> data_;
+		std::size_t position_{};
+		std::size_t cursor_{};
+
+		std::uint64_t accumulator_{};
+		std::size_t accumulator_bits_{};
+	};
+
+	using bit_reader_be = bit_reader<std::endian::big>;
+	using bit_reader_le = bit_reader<std::endian::little>;
+}
@@ -0,0 +1,38 @@
+tests = {}
+function tests:project()
+    project "tests"
+		kind "ConsoleApp"
+		language "C++"
+
+		targetname "tests"
+
+		files {
+			"./src/tests/**.hpp", 
+			"./src/tests/**.cpp", 
+			"./src/zonetool/zonetool/utils/hash_index.hpp", 
+			"./src/common/utils/bit_reader.hpp", 
+			"./src/common/utils/bit_reader.cpp", 
+			"./src/zonetool/zonetool/utils/dxbc_decoder.hpp", 
+			"./src/zonetool/zonetool/utils/dxbc_decoder.cpp", 
+			"./src/zonetool/zonetool/utils/vertex_convert.hpp", 
+			"./src/zonetool/zonetool/utils/vertex_convert.cpp", 
+			"./src/zonetool/game/half_float.hpp", 
+			"./src/zonetool/game/half_float.cpp", 
+			"./src/zonetool/zonetool/utils/json_fields.hpp", 
+			"./src/zonetool/zonetool/utils/json_fields.cpp"
+		}
+
+		-- sources under test are compiled without the precompiled header, src/tests/std_include.hpp stands in for it
+		includedirs {
+			"./src/tests", 
+			"./src/zonetool", 
+			"./src/common"
+		}
+
+		filter "system:linux"
+			links {"pthread"}
+		filter {}
+
+		json.includes()
+		zlib.import()
+end
@@ -0,0 +1,191 @@
+#include "test.hpp"
+#include "reference/bit_buffer.hpp"
+
+#include <utils/bit_reader.hpp>
+
+#include <chrono>
+#include <vector>
+
+namespace
+{
+	std::string random_bytes(tests::random& random, const std::size_t size)
+	{
+		std::string data(size, '\0');
+		for (auto& c : data)
+		{
+			c = static_cast<char>(random.next(256));
+		}
+
+		return data;
+	}
+
+	// 10, 14 and 1 bit fields like the dxbc token walk reads
+	std::vector<std::size_t> field_widths(const std::size_t total_bits)
+	{
+		constexpr std::size_t pattern[] = {10, 14, 1, 7};
+
+		std::vector<std::size_t> widths;
+		for (auto bits = 0ull, i = 0ull; bits + pattern[i % 4] <= total_bits; bits += pattern[i % 4], i++)
+		{
+			widths.push_back(pattern[i % 4]);
+		}
+
+		return widths;
+	}
+
+	template <typename Callback>
+	double measure(Callback&& callback)
+	{
+		const auto start = std::chrono::steady_clock::now();
+		callback();
+		return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	volatile std::uint64_t sink;
+}
+
+TEST_CASE(bit_reader_be_matches_bit_buffer)
+{
+	tests::random random;
+
+	for (auto round = 0; round < 200; round++)
+	{
+		const auto data = random_bytes(random, random.next(64) + 1);
+		const auto total_bits = data.size() * 8;
+
+		tests::reference::bit_buffer expected(data);
+		utils::bit_reader_be reader(data.data(), data.size());
+
+		// the old reader returns 0 for reads that don't fit but still advances, so sequential reads stay comparable
+		while (reader.total() < total_bits + 64)
+		{
+			const auto num_bits = random.next(64) + 1;
+			CHECK(reader.read_bits(num_bits) == expected.read_bits(num_bits));
+		}
+
+		for (auto i = 0; i < 64; i++)
+		{
+			const auto bit_index = random.next(total_bits + 8);
+			const auto num_bits = random.next(64) + 1;
+			CHECK(reader.read_bits(bit_index, num_bits) == expected.read_bits(bit_index, num_bits));
+		}
+	}
+}
+
+TEST_CASE(bit_reader_le_matches_bit_buffer_le)
+{
+	tests::random random;
+
+	for (auto round = 0; round < 200; round++)
+	{
+		const auto data = random_bytes(random, random.next(64) + 1);
+		const auto total_bits = data.size() * 8;
+
+		tests::reference::bit_buffer_le expected(data);
+		utils::bit_reader_le reader(data.data(), data.size());
+
+		for (auto i = 0; i < 256; i++)
+		{
+			const auto action = random.next(8);
+			if (action == 0)
+			{
+				const auto bit = random.next(total_bits + 1);
+				expected.set_bit(bit);
+				reader.set_bit(bit);
+			}
+			else if (action == 1)
+			{
+				const auto num_bytes = random.next(8) + 1;
+				if (reader.total() + num_bytes * 8 <= total_bits)
+				{
+					CHECK(reader.read_bytes(num_bytes) == expected.read_bytes(static_cast<unsigned int>(num_bytes)));
+				}
+			}
+			else
+			{
+				const auto num_bits = random.next(64) + 1;
+				if (reader.total() + num_bits <= total_bits)
+				{
+					CHECK(reader.read_bits(num_bits) == expected.read_bits(static_cast<unsigned int>(num_bits)));
+				}
+				else
+				{
+					// the old reader returned 0 without advancing, bit_reader advances so callers see the overrun
+					CHECK(reader.read_bits(num_bits) == 0);
+					CHECK(reader.total() > total_bits);
+					reader.set_bit(expected.total());
+				}
+			}
+
+			CHECK(reader.total() == expected.total());
+		}
+	}
+}
+
+TEST_CASE(bit_reader_read_buffer)
+{
+	tests::random random;
+	const auto data = random_bytes(random, 40);
+
+	// flac md5 starts 18 bytes into the streaminfo block
+	utils::bit_reader_be reader(data.data(), data.size());
+	reader.set_bit(18 * 8);
+
+	std::uint8_t md5[16]{};
+	reader.read_buffer(md5, sizeof(md5) * 8);
+
+	for (auto i = 0u; i < sizeof(md5); i++)
+	{
+		CHECK(md5[i] == static_cast<std::uint8_t>(data[18 + i]));
+	}
+
+	CHECK(reader.total() == 34 * 8);
+}
+
+BENCHMARK_CASE(bit_reader_fields)
+{
+	tests::random random;
+
+	const auto data = random_bytes(random, 1024 * 1024);
+	const auto widths = field_widths(data.size() * 8);
+
+	const auto be_old = measure([&]
+	{
+		tests::reference::bit_buffer buffer(data);
+		for (const auto width : widths)
+		{
+			sink = sink + buffer.read_bits(width);
+		}
+	});
+
+	const auto be_new = measure([&]
+	{
+		utils::bit_reader_be reader(data.data(), data.size());
+		for (const auto width : widths)
+		{
+			sink = sink + reader.read_bits(width);
+		}
+	});
+
+	const auto le_old = measure([&]
+	{
+		tests::reference::bit_buffer_le buffer(data);
+		for (const auto width : widths)
+		{
+			sink = sink + buffer.read_bits(static_cast<unsigned int>(width));
+		}
+	});
+
+	const auto le_new = measure([&]
+	{
+		utils::bit_reader_le reader(data.data(), data.size());
+		for (const auto width : widths)
+		{
+			sink = sink + reader.read_bits(width);
+		}
+	});
+
+	std::printf("  %zu fields over 1 MiB\n", widths.size());
+	std::printf("  big endian:    bit_buffer %.2f ms, bit_reader %.2f ms\n", be_old, be_new);
+	std::printf("  little endian: bit_buffer_le %.2f ms, bit_reader %.2f ms\n", le_old, le_new);
+}
@@ -0,0 +1,342 @@
+#include "test.hpp"
+
+#include <zonetool/utils/dxbc_decoder.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+	using program = std::vector<std::uint32_t>;
+
+	struct expected_reference
+	{
+		std::uint32_t slot;
+		std::uint32_t reg;
+		// dword index in the program, counted from the version token
+		std::size_t index;
+		bool relative;
+	};
+
+	void append(std::vector<unsigned char>& data, const void* value, const std::size_t size)
+	{
+		const auto bytes = static_cast<const unsigned char*>(value);
+		data.insert(data.end(), bytes, bytes + size);
+	}
+
+	// wraps the program in a dxbc container the way fxc lays it out, a reflection chunk and the shader chunk
+	std::vector<unsigned char> make_container(program tokens, const char* chunk_name = "SHEX",
+		std::size_t* program_offset = nullptr)
+	{
+		tokens[1] = static_cast<std::uint32_t>(tokens.size());
+
+		const std::uint32_t rdef[4]{};
+		const std::uint32_t chunk_count = 2;
+		const std::uint32_t header_size = 32 + chunk_count * 4;
+		const std::uint32_t rdef_offset = header_size;
+		const std::uint32_t shex_offset = rdef_offset + 8 + sizeof(rdef);
+		const std::uint32_t shex_size = static_cast<std::uint32_t>(tokens.size() * 4);
+		const std::uint32_t total_size = shex_offset + 8 + shex_size;
+		const std::uint32_t checksum[4]{};
+		const std::uint32_t version = 1;
+		const std::uint32_t rdef_size = sizeof(rdef);
+
+		std::vector<unsigned char> data;
+		append(data, "DXBC", 4);
+		append(data, checksum, sizeof(checksum));
+		append(data, &version, 4);
+		append(data, &total_size, 4);
+		append(data, &chunk_count, 4);
+		append(data, &rdef_offset, 4);
+		append(data, &shex_offset, 4);
+
+		append(data, "RDEF", 4);
+		append(data, &rdef_size, 4);
+		append(data, rdef, sizeof(rdef));
+
+		append(data, chunk_name, 4);
+		append(data, &shex_size, 4);
+		append(data, tokens.data(), shex_size);
+
+		if (program_offset)
+		{
+			*program_offset = shex_offset + 8;
+		}
+
+		return data;
+	}
+
+	void check_references(const program& tokens, const std::vector<expected_reference>& expected,
+		const char* chunk_name = "SHEX")
+	{
+		std::size_t program_offset{};
+		const auto data = make_container(tokens, chunk_name, &program_offset);
+
+		std::vector<shader::decoder::constant_buffer_reference> references;
+		CHECK(shader::decoder::get_constant_buffer_references(data.data(), data.size(), references));
+		CHECK(references.size() == expected.size());
+
+		for (const auto& reference : expected)
+		{
+			const auto found = std::find_if(references.begin(), references.end(), [&](const auto& entry)
+			{
+				return entry.offset == program_offset + reference.index * 4;
+			});
+
+			CHECK(found != references.end());
+			if (found != references.end())
+			{
+				CHECK(found->slot == reference.slot);
+				CHECK(found->reg == reference.reg);
+				CHECK(found->relative == reference.relative);
+
+				std::uint32_t value{};
+				std::memcpy(&value, data.data() + found->offset, sizeof(value));
+				CHECK(value == reference.reg);
+			}
+		}
+	}
+
+	bool decode(const program& tokens)
+	{
+		const auto data = make_container(tokens);
+		std::vector<shader::decoder::constant_buffer_reference> references;
+		return shader::decoder::get_constant_buffer_references(data.data(), data.size(), references);
+	}
+
+	// vs_5_0
+	// dcl_globalFlags refactoringAllowed
+	// dcl_constantbuffer CB0[4], immediateIndexed
+	// dcl_constantbuffer CB2[70], dynamicIndexed
+	// dcl_input v0.xyzw
+	// dcl_input v1.x
+	// dcl_output_siv o0.xyzw, position
+	// dcl_temps 2
+	// mul r0.xyzw, v0.yyyy, cb0[1].xyzw
+	// mad r0.xyzw, cb0[0].xyzw, v0.xxxx, r0.xyzw
+	// ftou r1.x, v1.x
+	// add o0.xyzw, r0.xyzw, cb2[r1.x + 15].xyzw
+	// ret
+	const program vertex_shader =
+	{
+		0x00010050, 0,
+		0x0100086A,
+		0x04000059, 0x00208E46, 0, 4,
+		0x04000859, 0x00208E46, 2, 70,
+		0x0300005F, 0x001010F2, 0,
+		0x0300005F, 0x00101012, 1,
+		0x04000067, 0x001020F2, 0, 1,
+		0x02000068, 2,
+		0x08000038, 0x001000F2, 0, 0x00101556, 0, 0x00208E46, 0, 1,
+		0x0A000032, 0x001000F2, 0, 0x00208E46, 0, 0, 0x00101006, 0, 0x00100E46, 0,
+		0x0500001C, 0x00100012, 1, 0x0010100A, 1,
+		0x0A000000, 0x001020F2, 0, 0x00100E46, 0, 0x06208E46, 2, 15, 0x0010000A, 1,
+		0x0100003E,
+	};
+
+	const std::vector<expected_reference> vertex_shader_references =
+	{
+		{0, 4, 6, false},
+		{2, 70, 10, false},
+		{0, 1, 30, false},
+		{0, 0, 36, false},
+		{2, 15, 53, true},
+	};
+
+	// ps_5_0
+	// dcl_globalFlags refactoringAllowed
+	// dcl_immediateConstantBuffer { { 1.0, 0, 0, 0 }, { 0x00208E46, 0, 5, 1.0 } }
+	// dcl_constantbuffer CB1[8], immediateIndexed
+	// dcl_sampler s0, mode_default
+	// dcl_resource_texture2d (float,float,float,float) t0
+	// dcl_input_ps linear v0.xy
+	// dcl_output o0.xyzw
+	// dcl_temps 1
+	// sample_aoffimmi(1,0,0) r0.xyzw, v0.xyxx, t0.xyzw, s0
+	// mul r0.xyzw, r0.xyzw, -cb1[3].xyzw
+	// add r0.xyzw, r0.xyzw, icb[r0.x + 0].xyzw
+	// mad o0.xyzw, r0.xyzw, l(0.5, 0.5, 0.5, 1.0), cb1[7].xyzw
+	// ret
+	const program pixel_shader =
+	{
+		0x00000050, 0,
+		0x0100086A,
+		0x00001835, 10, 0x3F800000, 0, 0, 0, 0x00208E46, 0, 5, 0x3F800000,
+		0x04000059, 0x00208E46, 1, 8,
+		0x0300005A, 0x00106000, 0,
+		0x04001858, 0x00107000, 0, 0x00005555,
+		0x03001062, 0x00101032, 0,
+		0x03000065, 0x001020F2, 0,
+		0x02000068, 1,
+		0x8A000045, 0x00000201, 0x001000F2, 0, 0x00101046, 0, 0x00107E46, 0, 0x00106000, 0,
+		0x09000038, 0x001000F2, 0, 0x00100E46, 0, 0x80208E46, 0x00000041, 1, 3,
+		0x09000000, 0x001000F2, 0, 0x00100E46, 0, 0x00D0AE46, 0, 0x0010000A, 0,
+		0x0D000032, 0x001020F2, 0, 0x00100E46, 0, 0x00004002, 0x3F000000, 0x3F000000, 0x3F000000, 0x3F800000,
+			0x00208E46, 1, 7,
+		0x0100003E,
+	};
+
+	const std::vector<expected_reference> pixel_shader_references =
+	{
+		{1, 8, 16, false},
+		{1, 3, 50, false},
+		{1, 7, 72, false},
+	};
+
+	// cs_5_0
+	// dcl_globalFlags refactoringAllowed
+	// dcl_constantbuffer CB0[2], immediateIndexed
+	// dcl_resource_structured t0, 16
+	// dcl_uav_typed_texture2d (float,float,float,float) u0
+	// dcl_input vThreadID.xy
+	// dcl_temps 1
+	// dcl_thread_group 8, 8, 1
+	// ld_structured r0.x, vThreadID.x, l(0), t0.xxxx
+	// mul r0.x, r0.x, cb0[1].x
+	// store_uav_typed u0.xyzw, vThreadID.xyyy, r0.xxxx
+	// ret
+	const program compute_shader =
+	{
+		0x00050050, 0,
+		0x0100086A,
+		0x04000059, 0x00208E46, 0, 2,
+		0x040000A2, 0x00107000, 0, 16,
+		0x0400189C, 0x0011E000, 0, 0x00005555,
+		0x0200005F, 0x00020032,
+		0x02000068, 1,
+		0x0400009B, 8, 8, 1,
+		0x080000A7, 0x00100012, 0, 0x0002000A, 0x00004001, 0, 0x00107006, 0,
+		0x08000038, 0x00100012, 0, 0x0010000A, 0, 0x0020800A, 0, 1,
+		0x060000A4, 0x0011E0F2, 0, 0x00020546, 0x00100006, 0,
+		0x0100003E,
+	};
+
+	const std::vector<expected_reference> compute_shader_references =
+	{
+		{0, 2, 6, false},
+		{0, 1, 38, false},
+	};
+
+	// vs_5_0
+	// dcl_constantbuffer CB0[6], immediateIndexed
+	// dcl_temps 1
+	// dmov r0.xy, d(1.0)
+	// mul r0.x, r0.x, cb0[5].x
+	// ret
+	const program double_shader =
+	{
+		0x00010050, 0,
+		0x04000059, 0x00208E46, 0, 6,
+		0x02000068, 1,
+		0x060000C7, 0x00100032, 0, 0x00005001, 0, 0x3FF00000,
+		0x08000038, 0x00100012, 0, 0x0010000A, 0, 0x0020800A, 0, 5,
+		0x0100003E,
+	};
+
+	const std::vector<expected_reference> double_shader_references =
+	{
+		{0, 6, 5, false},
+		{0, 5, 21, false},
+	};
+}
+
+TEST_CASE(dxbc_vertex_shader)
+{
+	check_references(vertex_shader, vertex_shader_references);
+}
+
+TEST_CASE(dxbc_vertex_shader_shdr)
+{
+	auto sm4 = vertex_shader;
+	sm4[0] = 0x00010040;
+	check_references(sm4, vertex_shader_references, "SHDR");
+}
+
+TEST_CASE(dxbc_pixel_shader)
+{
+	check_references(pixel_shader, pixel_shader_references);
+}
+
+TEST_CASE(dxbc_compute_shader)
+{
+	check_references(compute_shader, compute_shader_references);
+}
+
+TEST_CASE(dxbc_immediate64)
+{
+	check_references(double_shader, double_shader_references);
+}
+
+TEST_CASE(dxbc_no_shader_chunk)
+{
+	auto data = make_container(vertex_shader);
+	std::memcpy(data.data() + 32 + 8 + 8 + 16, "ISGN", 4);
+
+	std::vector<shader::decoder::constant_buffer_reference> references;
+	CHECK(!shader::decoder::get_constant_buffer_references(data.data(), data.size(), references));
+	CHECK(references.empty());
+
+	CHECK(!shader::decoder::get_constant_buffer_references(data.data(), 16, references));
+}
+
+TEST_CASE(dxbc_malformed_programs)
+{
+	// zero length instruction
+	CHECK(!decode({0x00010050, 0, 0x00000038, 0x0100003E}));
+
+	// instruction longer than the program
+	CHECK(!decode({0x00010050, 0, 0x08000038, 0x001000F2, 0}));
+
+	// operand running past its instruction
+	CHECK(!decode({0x00010050, 0, 0x03000038, 0x00208E46, 0, 1, 0x0100003E}));
+
+	// customdata without a length
+	CHECK(!decode({0x00010050, 0, 0x00001835, 0}));
+
+	// relative indices nested without end
+	program nested = {0x00010050, 0, 0x7F000036};
+	for (auto i = 0; i < 0x7E; i++)
+	{
+		nested.push_back(0x00900000);
+	}
+	CHECK(!decode(nested));
+
+	// n component operand
+	CHECK(!decode({0x00010050, 0, 0x03000036, 0x00100003, 0, 0x0100003E}));
+}
+
+TEST_CASE(dxbc_random_programs_terminate)
+{
+	tests::random random;
+
+	for (auto round = 0; round < 20000; round++)
+	{
+		program tokens = {0x00010050, 0};
+
+		const auto count = random.next(64);
+		for (auto i = 0u; i < count; i++)
+		{
+			auto token = static_cast<std::uint32_t>(random.next());
+
+			// keep lengths short so most instructions fit
+			if (random.next(2))
+			{
+				token = (token & 0x80FFFFFF) | static_cast<std::uint32_t>((random.next(8) + 1) << 24);
+			}
+
+			tokens.push_back(token);
+		}
+
+		std::size_t program_offset{};
+		const auto data = make_container(tokens, "SHEX", &program_offset);
+
+		std::vector<shader::decoder::constant_buffer_reference> references;
+		shader::decoder::get_constant_buffer_references(data.data(), data.size(), references);
+
+		for (const auto& reference : references)
+		{
+			CHECK(reference.offset >= program_offset + 8 && reference.offset + 4 <= data.size());
+		}
+	}
+}
@@ -0,0 +1,96 @@
+#include "test.hpp"
+
+#include <zonetool/utils/hash_index.hpp>
+
+#include <set>
+
+namespace
+{
+	// same layout as iw7 SndIndexEntry
+	struct index_entry
+	{
+		std::uint16_t value;
+		std::uint16_t next;
+	};
+
+	void check_every_id_found(const std::vector<std::uint32_t>& ids)
+	{
+		std::vector<index_entry> index(ids.size());
+		const auto get_id = [&](const std::size_t i)
+		{
+			return ids[i];
+		};
+
+		CHECK(zonetool::hash_index::build(index.data(), ids.size(), get_id));
+
+		std::set<std::uint16_t> values;
+		for (auto i = 0u; i < ids.size(); i++)
+		{
+			const auto found = zonetool::hash_index::find(index.data(), ids.size(), ids[i], get_id);
+			CHECK(found.has_value() && ids[found.value()] == ids[i]);
+
+			// every slot is used exactly once
+			values.emplace(index[i].value);
+		}
+
+		CHECK(values.size() == ids.size());
+	}
+}
+
+TEST_CASE(hash_index_empty)
+{
+	index_entry entry{};
+	CHECK(zonetool::hash_index::build(&entry, 0, [](std::size_t) { return 0u; }));
+	CHECK(!zonetool::hash_index::find(&entry, 0, 0, [](std::size_t) { return 0u; }).has_value());
+}
+
+TEST_CASE(hash_index_random_ids)
+{
+	tests::random random;
+	for (auto round = 0; round < 200; round++)
+	{
+		std::vector<std::uint32_t> ids(1 + random.next(2000));
+		for (auto& id : ids)
+		{
+			id = static_cast<std::uint32_t>(random.next());
+		}
+
+		check_every_id_found(ids);
+	}
+}
+
+TEST_CASE(hash_index_colliding_ids)
+{
+	tests::random random;
+	for (auto round = 0; round < 200; round++)
+	{
+		// every id lands in one of a few buckets
+		const auto count = 1 + random.next(500);
+		std::vector<std::uint32_t> ids(count);
+		for (auto i = 0u; i < count; i++)
+		{
+			ids[i] = static_cast<std::uint32_t>(random.next(4) + count * i);
+		}
+
+		check_every_id_found(ids);
+	}
+}
+
+TEST_CASE(hash_index_missing_id)
+{
+	const std::vector<std::uint32_t> ids = {3, 7, 11, 15};
+	std::vector<index_entry> index(ids.size());
+	const auto get_id = [&](const std::size_t i)
+	{
+		return ids[i];
+	};
+
+	CHECK(zonetool::hash_index::build(index.data(), ids.size(), get_id));
+	CHECK(!zonetool::hash_index::find(index.data(), ids.size(), 19, get_id).has_value());
+}
+
+TEST_CASE(hash_index_too_many_entries)
+{
+	std::vector<index_entry> index(0xFFFF);
+	CHECK(!zonetool::hash_index::build(index.data(), index.size(), [](std::size_t i) { return static_cast<std::uint32_t>(i); }));
+}
@@ -0,0 +1,39 @@
+#include <utils/io.hpp>
+
+#include <fstream>
+#include <iterator>
+
+// stands in for common/utils/io.cpp, which needs windows. only what the sources under test use
+namespace utils::io
+{
+	bool write_file(const std::string& file, const std::string& data, const bool append)
+	{
+		const auto parent = std::filesystem::path(file).parent_path();
+		if (!parent.empty())
+		{
+			std::error_code ec;
+			std::filesystem::create_directories(parent, ec);
+		}
+
+		std::ofstream stream(file, std::ios::binary | (append ? std::ios::app : std::ios::trunc));
+		if (!stream.is_open())
+		{
+			return false;
+		}
+
+		stream.write(data.data(), static_cast<std::streamsize>(data.size()));
+		return stream.good();
+	}
+
+	bool read_file(const std::string& file, std::string* data)
+	{
+		std::ifstream stream(file, std::ios::binary);
+		if (!data || !stream.is_open())
+		{
+			return false;
+		}
+
+		data->assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+		return true;
+	}
+}
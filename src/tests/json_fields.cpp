@@ -0,0 +1,231 @@
+#include <std_include.hpp>
+#include "test.hpp"
+
+#include <zonetool/utils/json_fields.hpp>
+
+#include <cstring>
+#include <filesystem>
+
+namespace
+{
+	enum class weapon_type : std::int32_t
+	{
+		bullet,
+		grenade,
+		projectile,
+	};
+
+	struct weapon
+	{
+		std::int32_t ammo;
+		float range;
+		bool automatic;
+		std::uint8_t slot;
+		std::int16_t offsets[3];
+		bool flags[2];
+		weapon_type type;
+	};
+
+	const zonetool::json_fields::field_table weapon_fields
+	{
+		JSON_FIELD(weapon, ammo),
+		JSON_FIELD(weapon, range),
+		JSON_FIELD(weapon, automatic),
+		JSON_FIELD(weapon, slot),
+		JSON_FIELD_ARR(weapon, offsets, 3),
+		JSON_FIELD_ARR(weapon, flags, 2),
+		JSON_FIELD(weapon, type),
+	};
+
+	std::vector<std::uint8_t> to_bytes(const std::string& text)
+	{
+		return {text.begin(), text.end()};
+	}
+
+	json parse(const std::string& text, weapon& object)
+	{
+		object = {};
+		return zonetool::json_fields::parse(to_bytes(text), weapon_fields, &object);
+	}
+
+	bool parse_throws(const std::string& text)
+	{
+		try
+		{
+			weapon object{};
+			parse(text, object);
+			return false;
+		}
+		catch (const std::exception&)
+		{
+			return true;
+		}
+	}
+
+	bool same_weapon(const weapon& a, const weapon& b)
+	{
+		return a.ammo == b.ammo && a.range == b.range && a.automatic == b.automatic && a.slot == b.slot &&
+			!std::memcmp(a.offsets, b.offsets, sizeof(a.offsets)) && !std::memcmp(a.flags, b.flags, sizeof(a.flags)) &&
+			a.type == b.type;
+	}
+
+	constexpr auto weapon_json = R"({
+		"ammo": 30,
+		"range": 1.5,
+		"automatic": true,
+		"slot": 2,
+		"offsets": [-1, 2, -3, 4],
+		"flags": [false, true],
+		"type": 2,
+		"szInternalName": "ak47_mp",
+		"gunModel": ["viewmodel_ak47", null],
+		"accuracy": {"ammo": 5, "spread": [1, 2]}
+	})";
+}
+
+TEST_CASE(json_fields_stream_into_object)
+{
+	weapon object{};
+	const auto data = parse(weapon_json, object);
+
+	CHECK(object.ammo == 30);
+	CHECK(object.range == 1.5f);
+	CHECK(object.automatic);
+	CHECK(object.slot == 2);
+	CHECK(object.offsets[0] == -1 && object.offsets[1] == 2 && object.offsets[2] == -3);
+	CHECK(!object.flags[0] && object.flags[1]);
+	CHECK(object.type == weapon_type::projectile);
+
+	// table fields are only written into the object, everything else stays in the dom
+	CHECK(!data.contains("ammo") && !data.contains("offsets") && !data.contains("type"));
+	CHECK(data["szInternalName"] == "ak47_mp");
+	CHECK(data["gunModel"] == json::parse(R"(["viewmodel_ak47", null])"));
+
+	// keys of nested objects aren't fields even when their name matches one
+	CHECK(data["accuracy"] == json::parse(R"({"ammo": 5, "spread": [1, 2]})"));
+}
+
+TEST_CASE(json_fields_match_json_get)
+{
+	weapon object{};
+
+	// numbers and booleans convert into each other for numeric fields, like json::get
+	parse(R"({"ammo": 2.75, "range": true, "slot": 300})", object);
+	CHECK(object.ammo == 2);
+	CHECK(object.range == 1.0f);
+	CHECK(object.slot == static_cast<std::uint8_t>(300));
+
+	// null leaves the field untouched, the weapon readers skipped those too
+	object = {};
+	object.ammo = 7;
+	zonetool::json_fields::parse(to_bytes(R"({"ammo": null, "offsets": null})"), weapon_fields, &object);
+	CHECK(object.ammo == 7);
+
+	// later keys win, the dom kept the last value as well
+	parse(R"({"ammo": 1, "ammo": 2})", object);
+	CHECK(object.ammo == 2);
+}
+
+TEST_CASE(json_fields_reject_mismatched_types)
+{
+	CHECK(parse_throws(R"({"ammo": "30"})"));
+	CHECK(parse_throws(R"({"ammo": {}})"));
+	CHECK(parse_throws(R"({"ammo": [30]})"));
+	CHECK(parse_throws(R"({"automatic": 1})"));
+	CHECK(parse_throws(R"({"flags": [true, 0]})"));
+
+	// arrays need every element as a number
+	CHECK(parse_throws(R"({"offsets": 1})"));
+	CHECK(parse_throws(R"({"offsets": [1, 2]})"));
+	CHECK(parse_throws(R"({"offsets": [1, null, 3]})"));
+	CHECK(parse_throws(R"({"offsets": [1, "2", 3]})"));
+	CHECK(parse_throws(R"({"offsets": [1, [2], 3]})"));
+	CHECK(parse_throws(R"({"offsets": [1, {}, 3]})"));
+
+	CHECK(parse_throws(R"({"ammo": 30)"));
+	CHECK(!parse_throws(R"({"szInternalName": 30, "accuracy": {"automatic": 1}})"));
+}
+
+TEST_CASE(json_fields_layout_hash)
+{
+	struct moved
+	{
+		float range;
+		std::int32_t ammo;
+	};
+
+	struct retyped
+	{
+		std::uint32_t ammo;
+		float range;
+	};
+
+	const zonetool::json_fields::field_table same{JSON_FIELD(weapon, ammo), JSON_FIELD(weapon, range)};
+	const zonetool::json_fields::field_table same_again{JSON_FIELD(weapon, ammo), JSON_FIELD(weapon, range)};
+	const zonetool::json_fields::field_table moved_fields{JSON_FIELD(moved, ammo), JSON_FIELD(moved, range)};
+	const zonetool::json_fields::field_table retyped_fields{JSON_FIELD(retyped, ammo), JSON_FIELD(retyped, range)};
+	const zonetool::json_fields::field_table added{JSON_FIELD(weapon, ammo), JSON_FIELD(weapon, range), JSON_FIELD(weapon, slot)};
+
+	CHECK(same.layout_hash() == same_again.layout_hash());
+	CHECK(same.layout_hash() != moved_fields.layout_hash());
+	CHECK(same.layout_hash() != retyped_fields.layout_hash());
+	CHECK(same.layout_hash() != added.layout_hash());
+}
+
+TEST_CASE(json_fields_weapon_cache)
+{
+	const auto directory = std::filesystem::temp_directory_path() / "zonetool_tests";
+	const auto cache_path = (directory / "weapons" / "ak47_mp.bin").string();
+	std::filesystem::remove_all(directory);
+
+	const auto parse_cached = [&](const std::string& text, weapon& object)
+	{
+		object = {};
+		return zonetool::json_fields::parse_cached(to_bytes(text), weapon_fields, &object, sizeof(weapon), cache_path);
+	};
+
+	weapon expected{};
+	const auto expected_data = parse(weapon_json, expected);
+
+	// the first parse writes the sidecar, the second one restores the object and the residual dom from it
+	weapon first{};
+	CHECK(parse_cached(weapon_json, first) == expected_data);
+	CHECK(same_weapon(first, expected));
+	CHECK(std::filesystem::exists(cache_path));
+
+	weapon cached{};
+	CHECK(parse_cached(weapon_json, cached) == expected_data);
+	CHECK(same_weapon(cached, expected));
+
+	// an edited document doesn't match the sidecar anymore and is parsed again
+	std::string edited = weapon_json;
+	edited.replace(edited.find("30"), 2, "60");
+
+	weapon changed{};
+	parse_cached(edited, changed);
+	CHECK(changed.ammo == 60);
+
+	// a sidecar written for another layout is ignored
+	const zonetool::json_fields::field_table ammo_only{JSON_FIELD(weapon, ammo)};
+
+	weapon other{};
+	const auto other_data = zonetool::json_fields::parse_cached(to_bytes(edited), ammo_only, &other, sizeof(weapon), cache_path);
+	CHECK(other.ammo == 60 && other.range == 0.0f);
+	CHECK(other_data["range"] == 1.5);
+
+	// mismatched fields throw instead of being cached
+	weapon broken{};
+	auto threw = false;
+	try
+	{
+		parse_cached(R"({"ammo": "60"})", broken);
+	}
+	catch (const std::exception&)
+	{
+		threw = true;
+	}
+
+	CHECK(threw);
+
+	std::filesystem::remove_all(directory);
+}
@@ -0,0 +1,103 @@
+#include "test.hpp"
+
+#include <chrono>
+#include <cstring>
+#include <vector>
+
+namespace tests
+{
+	namespace
+	{
+		struct entry
+		{
+			const char* name;
+			function callback;
+			bool benchmark;
+		};
+
+		std::vector<entry>& get_entries()
+		{
+			static std::vector<entry> entries;
+			return entries;
+		}
+
+		std::size_t failures = 0;
+	}
+
+	bool add(const char* name, const function callback, const bool benchmark)
+	{
+		get_entries().push_back({name, callback, benchmark});
+		return true;
+	}
+
+	void fail(const char* expression, const char* file, const int line)
+	{
+		std::printf("  %s:%d: CHECK(%s) failed\n", file, line, expression);
+		failures++;
+	}
+
+	random::random(const std::uint64_t seed)
+		: state_(seed)
+	{
+	}
+
+	// splitmix64
+	std::uint64_t random::next()
+	{
+		auto z = (this->state_ += 0x9E3779B97F4A7C15ull);
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+		return z ^ (z >> 31);
+	}
+
+	std::uint64_t random::next(const std::uint64_t bound)
+	{
+		return bound ? this->next() % bound : 0;
+	}
+}
+
+// tests [-bench] [filter]
+int main(const int argc, char** argv)
+{
+	auto benchmark = false;
+	const char* filter = nullptr;
+
+	for (auto i = 1; i < argc; i++)
+	{
+		if (!std::strcmp(argv[i], "-bench"))
+		{
+			benchmark = true;
+		}
+		else
+		{
+			filter = argv[i];
+		}
+	}
+
+	auto count = 0u;
+	auto failed = 0u;
+
+	for (const auto& entry : tests::get_entries())
+	{
+		if (entry.benchmark != benchmark || (filter && !std::strstr(entry.name, filter)))
+		{
+			continue;
+		}
+
+		const auto failures = tests::failures;
+		const auto start = std::chrono::steady_clock::now();
+
+		entry.callback();
+
+		const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		const auto passed = failures == tests::failures;
+
+		std::printf("[ %s ] %s (%.1f ms)\n", passed ? "PASS" : "FAIL", entry.name, elapsed);
+
+		count++;
+		failed += !passed;
+	}
+
+	std::printf("%u of %u %s passed\n", count - failed, count, benchmark ? "benchmarks" : "tests");
+	return failed ? 1 : 0;
+}
@@ -1,19 +1,35 @@
 #pragma once
 
-#include <string>
 #include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <string>
 
+// utils::bit_buffer and bit_buffer_le as they were before bit_reader replaced them, kept unchanged so the new reader
+// can be fuzzed against them. only the out of line members were moved into the classes
 // https://github.com/Aadeshp/BitBufferCpp/tree/master/src
 
-namespace utils
+namespace tests::reference
 {
     class bit_buffer 
     {
     public:
-        bit_buffer(const std::string&);
+        bit_buffer(const std::string& buffer) 
+            : buffer_(buffer)
+        {
+        }
 
-        std::uint64_t read_bits(const size_t bit_index, const size_t num_bits);
-        std::uint64_t read_bits(const size_t num_bits);
+        std::uint64_t read_bits(const size_t bit_index, const size_t num_bits)
+        {
+            return this->read_bits_internal(bit_index, num_bits, 0);
+        }
+
+        std::uint64_t read_bits(const size_t num_bits)
+        {
+            const auto index = this->bit_index_;
+            this->bit_index_ += num_bits;
+            return this->read_bits_internal(index, num_bits, 0);
+        }
 
         template<typename T> T read_bits(const size_t bit_index, const size_t num_bits)
         {
@@ -99,13 +115,32 @@ namespace utils
     class bit_buffer_le
     {
     public:
-        bit_buffer_le(const std::string&);
+        bit_buffer_le(const std::string& buffer)
+            : buffer_(buffer)
+        {
+        }
 
-        std::uint64_t read_bits(const unsigned int bit_index, const size_t num_bits);
-        std::uint64_t read_bits(const unsigned int num_bits);
-        std::uint64_t read_bytes(const unsigned int num_bytes);
-        uint64_t total();
-        void set_bit(std::uint64_t bit);
+        std::uint64_t read_bits(const unsigned int num_bits)
+        {
+            uint64_t data{};
+            this->read_bits_internal(num_bits, &data);
+            return data;
+        }
+
+        std::uint64_t read_bytes(const unsigned int num_bytes)
+        {
+            return this->read_bits(8 * num_bytes);
+        }
+
+        uint64_t total()
+        {
+            return this->current_bit_;
+        }
+
+        void set_bit(std::uint64_t bit)
+        {
+            this->current_bit_ = bit;
+        }
 
     private:
         void read_bits_internal(unsigned int bits, void* output)
@@ -0,0 +1,23 @@
+#pragma once
+
+// stands in for the precompiled header of the zonetool project, sources under test only need the standard library and json
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <json.hpp>
+using json = nlohmann::json;
+
+using namespace std::literals;
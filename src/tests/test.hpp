@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+namespace tests
+{
+	using function = void(*)();
+
+	// benchmarks only run with -bench, they report timings instead of checking anything
+	bool add(const char* name, function callback, bool benchmark = false);
+	void fail(const char* expression, const char* file, int line);
+
+	// fixed seed so a failure reproduces
+	class random
+	{
+	public:
+		explicit random(std::uint64_t seed = 0x9E3779B97F4A7C15ull);
+
+		std::uint64_t next();
+		std::uint64_t next(std::uint64_t bound);
+
+	private:
+		std::uint64_t state_;
+	};
+}
+
+#define TEST_CASE(__name__) \
+	static void __name__(); \
+	static const auto __name__##_registered = tests::add(#__name__, __name__); \
+	static void __name__()
+
+#define BENCHMARK_CASE(__name__) \
+	static void __name__(); \
+	static const auto __name__##_registered = tests::add(#__name__, __name__, true); \
+	static void __name__()
+
+#define CHECK(__expr__) \
+	do \
+	{ \
+		if (!(__expr__)) \
+		{ \
+			tests::fail(#__expr__, __FILE__, __LINE__); \
+		} \
+	} while (false)
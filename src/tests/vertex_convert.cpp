@@ -0,0 +1,249 @@
+#include "test.hpp"
+
+#include <zonetool/utils/vertex_convert.hpp>
+#include <game/half_float.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace
+{
+	using namespace zonetool::vertex_convert;
+
+	std::uint32_t random_dword(tests::random& random)
+	{
+		return static_cast<std::uint32_t>(random.next());
+	}
+
+	float random_float(tests::random& random)
+	{
+		const auto bits = random_dword(random);
+
+		float value;
+		std::memcpy(&value, &bits, sizeof(value));
+		return value;
+	}
+
+	// bit patterns from every range the half conversion cares about: normals, half denormals, underflow, saturation, nan
+	float random_half_input(tests::random& random)
+	{
+		switch (random.next(4))
+		{
+		case 0:
+			return random_float(random);
+		case 1:
+			return std::ldexp(static_cast<float>(random.next(1 << 24)) / (1 << 24), static_cast<int>(random.next(30)) - 26)
+				* (random.next(2) ? -1.0f : 1.0f);
+		case 2:
+			return static_cast<float>(random.next(200000)) - 100000.0f;
+		default:
+			return static_cast<float>(random.next(2000)) / 1000.0f - 1.0f;
+		}
+	}
+
+	bool same_bytes(const void* a, const void* b, const std::size_t size)
+	{
+		return std::memcmp(a, b, size) == 0;
+	}
+
+	// scalar versions of the kernels, what the converters did before
+	void interleave_scalar(packed_vertex* dst, const float (*positions)[3], const stream_vertex* verts, const std::uint32_t w, const std::size_t count)
+	{
+		for (auto i = 0u; i < count; i++)
+		{
+			std::memcpy(dst[i].xyz, positions[i], sizeof(dst[i].xyz));
+			dst[i].w = w;
+			dst[i].color = verts[i].color;
+			dst[i].tex_coord = verts[i].tex_coord;
+			dst[i].normal = verts[i].normal;
+			dst[i].tangent = verts[i].tangent;
+		}
+	}
+
+	void extract_position_normals_scalar(position_normal* dst, const packed_vertex* verts, const std::size_t count)
+	{
+		for (auto i = 0u; i < count; i++)
+		{
+			std::memcpy(dst[i].xyz, verts[i].xyz, sizeof(dst[i].xyz));
+			dst[i].normal = verts[i].normal;
+		}
+	}
+
+	template <typename Callback>
+	double measure(Callback&& callback)
+	{
+		const auto start = std::chrono::steady_clock::now();
+		callback();
+		return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	volatile std::uint32_t sink;
+}
+
+TEST_CASE(vertex_convert_interleave)
+{
+	tests::random random;
+
+	for (auto count = 0u; count < 40; count++)
+	{
+		std::vector<float> positions(count * 3);
+		for (auto& value : positions)
+		{
+			value = random_float(random);
+		}
+
+		std::vector<stream_vertex> verts(count);
+		for (auto& vert : verts)
+		{
+			vert = {random_dword(random), random_dword(random), random_dword(random), random_dword(random)};
+		}
+
+		const auto w = random_dword(random);
+		const auto* xyz = reinterpret_cast<const float(*)[3]>(positions.data());
+
+		// one spare vertex so a write past the end shows up
+		std::vector<packed_vertex> expected(count + 1, packed_vertex{});
+		std::vector<packed_vertex> result(count + 1, packed_vertex{});
+		interleave_scalar(expected.data(), xyz, verts.data(), w, count);
+		interleave(result.data(), xyz, verts.data(), w, count);
+
+		CHECK(same_bytes(expected.data(), result.data(), expected.size() * sizeof(packed_vertex)));
+	}
+}
+
+TEST_CASE(vertex_convert_extract_position_normals)
+{
+	tests::random random;
+
+	for (auto count = 0u; count < 40; count++)
+	{
+		std::vector<packed_vertex> verts(count);
+		for (auto& vert : verts)
+		{
+			vert = {{random_float(random), random_float(random), random_float(random)}, random_dword(random),
+				random_dword(random), random_dword(random), random_dword(random), random_dword(random)};
+		}
+
+		std::vector<position_normal> expected(count + 1, position_normal{});
+		std::vector<position_normal> result(count + 1, position_normal{});
+		extract_position_normals_scalar(expected.data(), verts.data(), count);
+		extract_position_normals(result.data(), verts.data(), count);
+
+		CHECK(same_bytes(expected.data(), result.data(), expected.size() * sizeof(position_normal)));
+	}
+}
+
+TEST_CASE(vertex_convert_floats_to_halves)
+{
+	tests::random random;
+
+	constexpr float special[] =
+	{
+		0.0f, -0.0f, 1.0f, -1.0f, 65504.0f, 65520.0f, -65520.0f, 1e10f, -1e10f,
+		6.1035156e-5f, 6.0975552e-5f, 5.9604645e-8f, 2.9802322e-8f, 1e-10f,
+		std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(),
+		std::numeric_limits<float>::quiet_NaN(), std::numeric_limits<float>::denorm_min(),
+	};
+
+	std::vector<float> values(std::begin(special), std::end(special));
+	for (auto i = 0; i < 100000; i++)
+	{
+		values.push_back(random_half_input(random));
+	}
+
+	// every tail length of the 4 wide loop
+	for (auto offset = 0u; offset < 4; offset++)
+	{
+		const auto count = values.size() - offset;
+
+		std::vector<std::uint16_t> result(count);
+		floats_to_halves(result.data(), values.data() + offset, count);
+
+		for (auto i = 0u; i < count; i++)
+		{
+			CHECK(result[i] == zonetool::half_float::float_to_half(values[offset + i]));
+		}
+	}
+}
+
+TEST_CASE(vertex_convert_bucket_blend_weights)
+{
+	tests::random random;
+
+	for (auto count = 0u; count < 200; count += 7)
+	{
+		std::vector<stream_weight> weights(count);
+		for (auto& weight : weights)
+		{
+			weight = {};
+			weight.values[0] = static_cast<std::uint8_t>(random.next(256));
+			for (auto i = 1; i < 4; i++)
+			{
+				weight.values[i] = random.next(2) ? static_cast<std::uint8_t>(random.next(255) + 1) : 0;
+			}
+		}
+
+		const auto influences = [&](const std::uint32_t i)
+		{
+			return (weights[i].values[1] != 0) + (weights[i].values[2] != 0) + (weights[i].values[3] != 0);
+		};
+
+		std::vector<std::uint32_t> expected(count);
+		for (auto i = 0u; i < count; i++)
+		{
+			expected[i] = i;
+		}
+
+		std::stable_sort(expected.begin(), expected.end(), [&](const std::uint32_t a, const std::uint32_t b)
+		{
+			return influences(a) < influences(b);
+		});
+
+		const auto buckets = bucket_blend_weights(weights.data(), count);
+		CHECK(buckets.order == expected);
+
+		std::array<std::uint16_t, 4> counts{};
+		for (auto i = 0u; i < count; i++)
+		{
+			counts[influences(i)]++;
+		}
+
+		CHECK(buckets.counts == counts);
+	}
+}
+
+BENCHMARK_CASE(vertex_convert_halves)
+{
+	tests::random random;
+
+	// lightmap uvs, what floats_to_halves converts
+	std::vector<float> values(4 * 1024 * 1024);
+	for (auto& value : values)
+	{
+		value = static_cast<float>(random.next(1 << 16)) / (1 << 16);
+	}
+
+	std::vector<std::uint16_t> result(values.size());
+
+	const auto scalar = measure([&]
+	{
+		for (auto i = 0u; i < values.size(); i++)
+		{
+			result[i] = zonetool::half_float::float_to_half(values[i]);
+		}
+
+		sink = sink + result.back();
+	});
+
+	const auto vector = measure([&]
+	{
+		floats_to_halves(result.data(), values.data(), values.size());
+		sink = sink + result.back();
+	});
+
+	std::printf("  %zu floats\n", values.size());
+	std::printf("  half_float::float_to_half %.2f ms, floats_to_halves %.2f ms\n", scalar, vector);
+}
@@ -0,0 +1,29 @@
+zoneinspect = {}
+function zoneinspect:project()
+    project "zoneinspect"
+		kind "ConsoleApp"
+		language "C++"
+
+		targetname "zoneinspect"
+
+		files {
+			"./src/zoneinspect/**.hpp", 
+			"./src/zoneinspect/**.cpp", 
+			"./src/zonetool/game/xfile.hpp", 
+			"./src/zonetool/zonetool/iw7/xfile.hpp", 
+			"./src/zonetool/zonetool/utils/compression.hpp"
+		}
+
+		-- only the windows free format headers are shared with zonetool, so this also builds with gmake
+		includedirs {
+			"./src/zoneinspect", 
+			"./src/zonetool"
+		}
+
+		filter "system:linux"
+			links {"pthread"}
+		filter {}
+
+		zlib.import()
+		lz4.import()
+end
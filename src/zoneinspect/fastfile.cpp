@@ -0,0 +1,421 @@
+#include "fastfile.hpp"
+#include "reader.hpp"
+
+#include "game/xfile.hpp"
+#include "zonetool/iw7/xfile.hpp"
+#include "zonetool/utils/compression.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <string_view>
+#include <thread>
+
+#include <zlib.h>
+#include <lz4.h>
+
+using namespace std::literals;
+
+namespace zoneinspect
+{
+	namespace
+	{
+		enum class codec_type
+		{
+			lz4,
+			zlib,
+			none,
+		};
+
+		struct block
+		{
+			std::size_t source;
+			std::size_t compressed_size;
+			std::size_t dest;
+			std::size_t uncompressed_size;
+			codec_type codec;
+		};
+
+		constexpr std::size_t iwc_block_size = 0x10000;
+		constexpr std::size_t iwc_signed_chunk_size = 0x4000;
+
+		std::size_t align_4(const std::size_t value)
+		{
+			return (value + 3) & ~static_cast<std::size_t>(3);
+		}
+
+		bool decode_block(const block& block, const std::uint8_t* source, std::uint8_t* dest)
+		{
+			const auto* in = source + block.source;
+			auto* out = dest + block.dest;
+
+			switch (block.codec)
+			{
+			case codec_type::lz4:
+				return LZ4_decompress_safe(reinterpret_cast<const char*>(in), reinterpret_cast<char*>(out),
+					static_cast<int>(block.compressed_size), static_cast<int>(block.uncompressed_size)) == static_cast<int>(block.uncompressed_size);
+			case codec_type::zlib:
+			{
+				auto size = static_cast<uLongf>(block.uncompressed_size);
+				return uncompress(out, &size, in, static_cast<uLong>(block.compressed_size)) == Z_OK && size == block.uncompressed_size;
+			}
+			case codec_type::none:
+				std::memcpy(out, in, block.uncompressed_size);
+				return true;
+			}
+
+			return false;
+		}
+
+		// blocks are independent once their offsets are known, so they are handed out to workers one at a time
+		std::vector<std::uint8_t> decode_blocks(const std::vector<block>& blocks, const std::vector<std::uint8_t>& source,
+			const std::size_t total_size, const std::size_t thread_count)
+		{
+			for (const auto& block : blocks)
+			{
+				if (block.source + block.compressed_size > source.size() || block.dest + block.uncompressed_size > total_size)
+				{
+					throw std::runtime_error("block points outside of the file");
+				}
+			}
+
+			std::vector<std::uint8_t> dest(total_size);
+
+			std::atomic_size_t next_block = 0;
+			std::atomic_size_t failed_block = blocks.size();
+
+			const auto worker = [&]
+			{
+				for (auto index = next_block++; index < blocks.size() && failed_block == blocks.size(); index = next_block++)
+				{
+					if (!decode_block(blocks[index], source.data(), dest.data()))
+					{
+						failed_block = index;
+					}
+				}
+			};
+
+			const auto workers = std::clamp<std::size_t>(thread_count, 1, std::max<std::size_t>(blocks.size(), 1));
+
+			std::vector<std::thread> threads;
+			for (auto i = 1u; i < workers; i++)
+			{
+				threads.emplace_back(worker);
+			}
+
+			worker();
+
+			for (auto& thread : threads)
+			{
+				thread.join();
+			}
+
+			if (failed_block != blocks.size())
+			{
+				throw std::runtime_error("block " + std::to_string(failed_block.load()) + " failed to decompress");
+			}
+
+			return dest;
+		}
+
+		std::vector<std::uint8_t> inflate_stream(const std::uint8_t* data, const std::size_t size)
+		{
+			std::vector<std::uint8_t> dest(std::max<std::size_t>(size * 4, 0x10000));
+
+			z_stream stream{};
+			if (inflateInit(&stream) != Z_OK)
+			{
+				throw std::runtime_error("inflateInit failed");
+			}
+
+			stream.next_in = const_cast<Bytef*>(data);
+			stream.avail_in = static_cast<uInt>(size);
+
+			auto result = Z_OK;
+			while (result == Z_OK)
+			{
+				if (stream.total_out == dest.size())
+				{
+					dest.resize(dest.size() * 2);
+				}
+
+				stream.next_out = dest.data() + stream.total_out;
+				stream.avail_out = static_cast<uInt>(std::min<std::size_t>(dest.size() - stream.total_out, UINT32_MAX));
+				result = inflate(&stream, Z_NO_FLUSH);
+			}
+
+			const auto total = stream.total_out;
+			inflateEnd(&stream);
+
+			if (result != Z_STREAM_END)
+			{
+				throw std::runtime_error("zlib stream is corrupt or truncated");
+			}
+
+			dest.resize(total);
+			return dest;
+		}
+
+		// compression::lz4 block format, a full header for the first block and a short one for every following block
+		std::vector<block> read_lz4_blocks(reader& stream, std::size_t* total_size)
+		{
+			std::vector<block> blocks;
+
+			const auto first = stream.read<compression::lz4::compressed_block_header>();
+			if (first.compression_type != 4)
+			{
+				throw std::runtime_error("invalid lz4 block compression type");
+			}
+
+			*total_size = static_cast<std::size_t>(first.uncompressed_size);
+
+			auto compressed_size = static_cast<std::size_t>(first.compressed_size);
+			auto uncompressed_size = static_cast<std::size_t>(first.uncompressed_block_size);
+			std::size_t dest = 0;
+
+			while (true)
+			{
+				blocks.push_back({stream.offset(), compressed_size, dest, uncompressed_size, codec_type::lz4});
+				dest += uncompressed_size;
+				stream.skip(std::min(align_4(compressed_size), stream.remaining()));
+
+				if (!stream.remaining())
+				{
+					break;
+				}
+
+				const auto header = stream.read<compression::lz4::intermediate_header>();
+				compressed_size = header.compressed_size;
+				uncompressed_size = header.uncompressed_block_size;
+			}
+
+			if (dest != *total_size)
+			{
+				throw std::runtime_error("lz4 blocks don't add up to the declared size");
+			}
+
+			return blocks;
+		}
+
+		fastfile read_classic(const game_info& game, const std::vector<std::uint8_t>& data, const std::size_t thread_count)
+		{
+			fastfile ff{};
+			ff.game = &game;
+
+			reader stream(data);
+
+			// baseFileLen and totalFileLen are written after the stream file table
+			zonetool::XFileHeader header{};
+			constexpr auto lengths_offset = offsetof(zonetool::XFileHeader, baseFileLen);
+			stream.read(&header, lengths_offset);
+
+			for (auto i = 0u; i < header.imageCount; i++)
+			{
+				const auto file = stream.read<zonetool::XStreamFile>();
+				ff.stream_files.push_back({file.fileIndex, file.isLocalized != 0, file.offset, file.offsetEnd});
+			}
+
+			stream.read(reinterpret_cast<std::uint8_t*>(&header) + lengths_offset, sizeof(zonetool::XFileHeader) - lengths_offset);
+
+			if (header.baseFileLen != data.size())
+			{
+				throw std::runtime_error("baseFileLen doesn't match the file size");
+			}
+
+			ff.compressed_size = stream.remaining();
+
+			if (!header.compress || header.compressType == 3)
+			{
+				ff.compression = "passthrough";
+				ff.block_count = 1;
+				ff.zone.assign(stream.current(), stream.current() + stream.remaining());
+			}
+			else if (header.compressType == 1)
+			{
+				// a single deflate stream can only be inflated front to back
+				ff.compression = "zlib";
+				ff.block_count = 1;
+				ff.zone = inflate_stream(stream.current(), stream.remaining());
+			}
+			else if (header.compressType == 4)
+			{
+				std::size_t total_size{};
+				const auto blocks = read_lz4_blocks(stream, &total_size);
+
+				ff.compression = "lz4";
+				ff.block_count = blocks.size();
+				ff.zone = decode_blocks(blocks, data, total_size, thread_count);
+			}
+			else
+			{
+				throw std::runtime_error("unknown compressType " + std::to_string(header.compressType));
+			}
+
+			return ff;
+		}
+
+		codec_type get_iwc_codec(const unsigned int type)
+		{
+			switch (type)
+			{
+			case zonetool::iw7::XBLOCK_COMPRESSION_LZ4:
+			case zonetool::iw7::XBLOCK_COMPRESSION_LZ4HC:
+				return codec_type::lz4;
+			case zonetool::iw7::XBLOCK_COMPRESSION_ZLIB_SIZE:
+			case zonetool::iw7::XBLOCK_COMPRESSION_ZLIB_SPEED:
+				return codec_type::zlib;
+			case zonetool::iw7::XBLOCK_COMPRESSION_NONE:
+				return codec_type::none;
+			default:
+				throw std::runtime_error("unknown block compression type " + std::to_string(type));
+			}
+		}
+
+		const char* get_codec_name(const codec_type codec)
+		{
+			switch (codec)
+			{
+			case codec_type::lz4:
+				return "lz4";
+			case codec_type::zlib:
+				return "zlib";
+			default:
+				return "none";
+			}
+		}
+
+		fastfile read_iw7(const game_info& game, const std::vector<std::uint8_t>& data, const std::size_t thread_count)
+		{
+			using namespace zonetool::iw7;
+
+			fastfile ff{};
+			ff.game = &game;
+			ff.is_signed = std::string_view(game.magic) == "IWff0100";
+
+			reader stream(data);
+
+			// the stream file tables sit between image_ff_count and fileLen
+			XFileHeader header{};
+			constexpr auto lengths_offset = offsetof(XFileHeader, fileLen);
+			stream.read(&header, lengths_offset);
+
+			for (auto i = 0u; i < header.shared_ff_count + header.image_ff_count; i++)
+			{
+				const auto file = stream.read<XStreamFile>();
+				ff.stream_files.push_back({file.fileIndex, file.isLocalized, file.offset, file.offsetEnd});
+			}
+
+			stream.read(reinterpret_cast<std::uint8_t*>(&header) + lengths_offset, sizeof(XFileHeader) - lengths_offset);
+
+			ff.block_sizes.assign(std::begin(header.stream_data.block_size), std::end(header.stream_data.block_size));
+
+			if (ff.is_signed)
+			{
+				stream.skip(sizeof(DB_AuthHeader) + sizeof(DB_MasterBlock));
+			}
+
+			const auto base = stream.offset();
+			ff.compressed_size = stream.remaining();
+
+			const auto compressor = stream.read<XFileCompressorHeader>();
+			if (std::memcmp(compressor.magic, "IWC", 3))
+			{
+				throw std::runtime_error("missing IWC compressor header");
+			}
+
+			if (compressor.compressor == DB_COMPRESSOR_PASSTHROUGH)
+			{
+				ff.compression = "iwc passthrough";
+				ff.block_count = 1;
+				ff.zone.assign(stream.current(), stream.current() + stream.remaining());
+				return ff;
+			}
+
+			if (compressor.compressor != DB_COMPRESSOR_BLOCK)
+			{
+				throw std::runtime_error("unknown IWC compressor " + std::to_string(compressor.compressor));
+			}
+
+			const auto data_header = stream.read<XBlockCompressionDataHeader>();
+			const auto codec = get_iwc_codec(data_header.blockSizeAndType.compressionType);
+			const auto total_size = static_cast<std::size_t>(data_header.uncompressedSize);
+
+			std::vector<block> blocks;
+			std::size_t dest = 0;
+
+			while (dest < total_size)
+			{
+				// signed files give every block its own fixed size chunk so each can be hashed on its own
+				if (ff.is_signed && !blocks.empty())
+				{
+					stream.seek(base + blocks.size() * iwc_signed_chunk_size);
+				}
+
+				const auto block_header = stream.read<XBlockCompressionBlockHeader>();
+				const auto uncompressed_size = static_cast<std::size_t>(block_header.uncompressedSize);
+				const auto compressed_size = codec == codec_type::none ? uncompressed_size : block_header.compressedSize;
+
+				if (!uncompressed_size || uncompressed_size > iwc_block_size)
+				{
+					throw std::runtime_error("invalid IWC block size");
+				}
+
+				blocks.push_back({stream.offset(), compressed_size, dest, uncompressed_size, codec});
+				dest += uncompressed_size;
+
+				const auto stored_size = codec == codec_type::lz4 ? align_4(compressed_size) : compressed_size;
+				stream.skip(std::min(stored_size, stream.remaining()));
+			}
+
+			if (dest != total_size)
+			{
+				throw std::runtime_error("IWC blocks don't add up to the declared size");
+			}
+
+			ff.compression = "iwc "s + get_codec_name(codec);
+			ff.block_count = blocks.size();
+			ff.zone = decode_blocks(blocks, data, total_size, thread_count);
+
+			return ff;
+		}
+	}
+
+	const std::vector<game_info>& get_games()
+	{
+		static const std::vector<game_info> games =
+		{
+			{"h1", "S1ffu100", 66, file_layout::classic, 12},
+			{"h2", "S1ffu100", 130, file_layout::classic, 12},
+			{"s1", "S1ffu100", 1838, file_layout::classic, 12},
+			{"iw6", "IWffu100", 565, file_layout::classic, 4},
+			{"iw7", "IWffu100", 1619, file_layout::iw7, 16},
+			{"iw7", "IWff0100", 1619, file_layout::iw7, 16},
+		};
+
+		return games;
+	}
+
+	fastfile read_fastfile(const std::vector<std::uint8_t>& data, const std::size_t thread_count)
+	{
+		reader stream(data);
+
+		char magic[8]{};
+		stream.read(magic, sizeof(magic));
+		const auto version = stream.read<std::uint32_t>();
+
+		for (const auto& game : get_games())
+		{
+			if (game.version != version || std::memcmp(game.magic, magic, sizeof(magic)))
+			{
+				continue;
+			}
+
+			return game.layout == file_layout::iw7
+				? read_iw7(game, data, thread_count)
+				: read_classic(game, data, thread_count);
+		}
+
+		throw std::runtime_error("unknown fastfile \"" + std::string(magic, sizeof(magic)) + "\" version " + std::to_string(version));
+	}
+}
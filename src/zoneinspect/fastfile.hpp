@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace zoneinspect
+{
+	enum class file_layout
+	{
+		// XFileHeader, XStreamFile table, then one zlib/lz4/passthrough stream starting with XZoneMemory
+		classic,
+		// iw7::XFileHeader, optional auth blocks, then an IWC compressed stream without XZoneMemory
+		iw7,
+	};
+
+	struct game_info
+	{
+		const char* name;
+		const char* magic;
+		std::uint32_t version;
+		file_layout layout;
+		// sizeof(GfxBlendStateBits) differs per game and is needed to step over the gfx globals
+		std::size_t blend_state_size;
+	};
+
+	struct stream_file
+	{
+		std::uint16_t file_index;
+		bool localized;
+		std::uint64_t offset;
+		std::uint64_t offset_end;
+	};
+
+	struct fastfile
+	{
+		const game_info* game;
+		std::string compression;
+		bool is_signed;
+
+		std::vector<stream_file> stream_files;
+		// only filled for iw7, older games store their stream sizes inside the zone
+		std::vector<std::uint64_t> block_sizes;
+
+		std::size_t compressed_size;
+		std::size_t block_count;
+		std::vector<std::uint8_t> zone;
+	};
+
+	const std::vector<game_info>& get_games();
+
+	// throws std::runtime_error on anything that doesn't match what zone_interface::build writes
+	fastfile read_fastfile(const std::vector<std::uint8_t>& data, std::size_t thread_count);
+}
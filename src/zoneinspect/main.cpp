@@ -0,0 +1,224 @@
+#include "fastfile.hpp"
+#include "zone.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace zoneinspect
+{
+	namespace
+	{
+		struct options
+		{
+			std::size_t thread_count;
+			bool print_strings;
+			bool print_assets;
+			std::string dump_path;
+			std::vector<std::string> files;
+		};
+
+		void print_usage()
+		{
+			printf("usage: zoneinspect [-threads <n>] [-strings] [-assets] [-dump <dir>] <file.ff>...\n");
+			printf("  -threads <n>  decompression threads, defaults to the hardware concurrency\n");
+			printf("  -strings      list every script string\n");
+			printf("  -assets       list every asset entry in zone order\n");
+			printf("  -dump <dir>   write the decompressed zone to <dir>/<name>.zone\n");
+		}
+
+		bool parse_options(const int argc, char** argv, options* options)
+		{
+			options->thread_count = std::max(1u, std::thread::hardware_concurrency());
+
+			for (auto i = 1; i < argc; i++)
+			{
+				const std::string arg = argv[i];
+
+				if (arg == "-threads" && i + 1 < argc)
+				{
+					options->thread_count = std::max(1ul, std::strtoul(argv[++i], nullptr, 10));
+				}
+				else if (arg == "-strings")
+				{
+					options->print_strings = true;
+				}
+				else if (arg == "-assets")
+				{
+					options->print_assets = true;
+				}
+				else if (arg == "-dump" && i + 1 < argc)
+				{
+					options->dump_path = argv[++i];
+				}
+				else if (!arg.empty() && arg[0] == '-')
+				{
+					return false;
+				}
+				else
+				{
+					options->files.emplace_back(arg);
+				}
+			}
+
+			return !options->files.empty();
+		}
+
+		std::vector<std::uint8_t> read_file(const std::string& path)
+		{
+			std::ifstream stream(path, std::ios::binary | std::ios::ate);
+			if (!stream.is_open())
+			{
+				throw std::runtime_error("failed to open file");
+			}
+
+			std::vector<std::uint8_t> data(static_cast<std::size_t>(stream.tellg()));
+			stream.seekg(0);
+			stream.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size()));
+
+			return data;
+		}
+
+		void dump_zone(const options& options, const std::string& path, const fastfile& ff)
+		{
+			std::filesystem::create_directories(options.dump_path);
+
+			const auto dump_path = std::filesystem::path(options.dump_path) / std::filesystem::path(path).stem().concat(".zone");
+			std::ofstream stream(dump_path, std::ios::binary);
+			stream.write(reinterpret_cast<const char*>(ff.zone.data()), static_cast<std::streamsize>(ff.zone.size()));
+
+			if (!stream)
+			{
+				throw std::runtime_error("failed to write " + dump_path.string());
+			}
+
+			printf("  dumped to        %s\n", dump_path.string().data());
+		}
+
+		void print_fastfile(const fastfile& ff, const double decompress_msec)
+		{
+			printf("  game             %s (%s, version %u%s)\n", ff.game->name, std::string(ff.game->magic, 8).data(),
+				ff.game->version, ff.is_signed ? ", signed" : "");
+			printf("  compression      %s, %zu block(s)\n", ff.compression.data(), ff.block_count);
+			printf("  compressed       %zu bytes\n", ff.compressed_size);
+			printf("  decompressed     %zu bytes in %.2f msec\n", ff.zone.size(), decompress_msec);
+
+			if (!ff.stream_files.empty())
+			{
+				printf("  stream files     %zu\n", ff.stream_files.size());
+				for (const auto& file : ff.stream_files)
+				{
+					printf("    file %u%s  0x%llX - 0x%llX\n", file.file_index, file.localized ? " (localized)" : "",
+						static_cast<unsigned long long>(file.offset), static_cast<unsigned long long>(file.offset_end));
+				}
+			}
+		}
+
+		void print_zone(const options& options, const fastfile& ff, const zone_contents& zone)
+		{
+			const auto& names = get_stream_names(ff.game->layout);
+
+			printf("  streams\n");
+			for (auto i = 0u; i < zone.stream_sizes.size(); i++)
+			{
+				printf("    %-16s %llu\n", i < names.size() ? names[i] : "?", static_cast<unsigned long long>(zone.stream_sizes[i]));
+			}
+
+			printf("  script strings   %zu (%zu null)\n", zone.script_string_count, zone.null_script_string_count);
+			if (options.print_strings)
+			{
+				for (auto i = 0u; i < zone.script_strings.size(); i++)
+				{
+					printf("    %u: %s\n", i, zone.script_strings[i].data());
+				}
+			}
+
+			printf("  gfx globals      %s\n", zone.has_globals ? "yes" : "no");
+			printf("  assets           %zu, data at 0x%zX (%zu bytes)\n", zone.assets.size(), zone.asset_data_offset, zone.asset_data_size);
+
+			std::map<std::uint64_t, std::size_t> type_counts;
+			for (const auto& asset : zone.assets)
+			{
+				type_counts[asset.type]++;
+			}
+
+			for (const auto& [type, count] : type_counts)
+			{
+				printf("    type %-4llu     %zu\n", static_cast<unsigned long long>(type), count);
+			}
+
+			if (options.print_assets)
+			{
+				for (auto i = 0u; i < zone.assets.size(); i++)
+				{
+					printf("    %u: type %llu\n", i, static_cast<unsigned long long>(zone.assets[i].type));
+				}
+			}
+
+			for (const auto& error : zone.errors)
+			{
+				printf("  error: %s\n", error.data());
+			}
+		}
+
+		bool inspect(const options& options, const std::string& path)
+		{
+			printf("%s\n", path.data());
+
+			try
+			{
+				const auto data = read_file(path);
+
+				const auto start = std::chrono::high_resolution_clock::now();
+				const auto ff = read_fastfile(data, options.thread_count);
+				const auto end = std::chrono::high_resolution_clock::now();
+
+				print_fastfile(ff, std::chrono::duration<double, std::milli>(end - start).count());
+
+				if (!options.dump_path.empty())
+				{
+					dump_zone(options, path, ff);
+				}
+
+				const auto zone = read_zone(ff);
+				print_zone(options, ff, zone);
+
+				return zone.errors.empty();
+			}
+			catch (const std::exception& e)
+			{
+				printf("  error: %s\n", e.what());
+				return false;
+			}
+		}
+	}
+}
+
+int main(int argc, char** argv)
+{
+	zoneinspect::options options{};
+	if (!zoneinspect::parse_options(argc, argv, &options))
+	{
+		zoneinspect::print_usage();
+		return 1;
+	}
+
+	auto failed = 0;
+	for (const auto& file : options.files)
+	{
+		if (!zoneinspect::inspect(options, file))
+		{
+			failed++;
+		}
+	}
+
+	return failed ? 2 : 0;
+}
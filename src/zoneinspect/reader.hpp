@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+namespace zoneinspect
+{
+	// bounds checked cursor over a file or zone image, running off the end is a format error
+	class reader
+	{
+	public:
+		reader(const std::vector<std::uint8_t>& data, const std::size_t offset = 0)
+			: data_(data)
+			, offset_(offset)
+		{
+		}
+
+		void read(void* dest, const std::size_t size)
+		{
+			this->check(size);
+			std::memcpy(dest, this->data_.data() + this->offset_, size);
+			this->offset_ += size;
+		}
+
+		template <typename T>
+		T read()
+		{
+			T value{};
+			this->read(&value, sizeof(T));
+			return value;
+		}
+
+		const char* read_string()
+		{
+			const auto* start = reinterpret_cast<const char*>(this->data_.data() + this->offset_);
+			const auto length = strnlen(start, this->remaining());
+			this->check(length + 1);
+			this->offset_ += length + 1;
+			return start;
+		}
+
+		void skip(const std::size_t size)
+		{
+			this->check(size);
+			this->offset_ += size;
+		}
+
+		void seek(const std::size_t offset)
+		{
+			if (offset > this->data_.size())
+			{
+				throw std::runtime_error("seek past the end of the data");
+			}
+
+			this->offset_ = offset;
+		}
+
+		std::size_t offset() const
+		{
+			return this->offset_;
+		}
+
+		std::size_t remaining() const
+		{
+			return this->data_.size() - this->offset_;
+		}
+
+		const std::uint8_t* current() const
+		{
+			return this->data_.data() + this->offset_;
+		}
+
+	private:
+		const std::vector<std::uint8_t>& data_;
+		std::size_t offset_;
+
+		void check(const std::size_t size) const
+		{
+			if (size > this->remaining())
+			{
+				throw std::runtime_error("unexpected end of data");
+			}
+		}
+	};
+}
@@ -0,0 +1,172 @@
+#include "zone.hpp"
+#include "reader.hpp"
+
+#include "game/xfile.hpp"
+#include "zonetool/iw7/xfile.hpp"
+
+#include <stdexcept>
+
+namespace zoneinspect
+{
+	namespace
+	{
+		// pointers that zone_buffer resolves at load time are written as this value
+		constexpr std::uint64_t data_following = 0xFDFDFDFFFFFFFFFF;
+
+		// XGfxGlobals of every supported game, mirrored here because the game headers need d3d11
+		struct gfx_globals
+		{
+			std::uint32_t depth_stencil_state_count;
+			std::uint32_t blend_state_count;
+			std::uint64_t depth_stencil_state_bits;
+			std::uint64_t blend_state_bits;
+			std::uint64_t depth_stencil_states;
+			std::uint64_t blend_states;
+			std::uint32_t per_prim_constant_buffer_count;
+			std::uint32_t per_obj_constant_buffer_count;
+			std::uint32_t stable_constant_buffer_count;
+			std::uint64_t per_prim_constant_buffer_sizes;
+			std::uint64_t per_obj_constant_buffer_sizes;
+			std::uint64_t stable_constant_buffer_sizes;
+			std::uint64_t per_prim_constant_buffers;
+			std::uint64_t per_obj_constant_buffers;
+			std::uint64_t stable_constant_buffers;
+		};
+
+		static_assert(sizeof(gfx_globals) == 104);
+
+		void skip_array(reader& stream, const std::uint64_t pointer, const std::size_t count, const std::size_t element_size)
+		{
+			if (pointer && count)
+			{
+				stream.skip(count * element_size);
+			}
+		}
+
+		// runtime stream data isn't part of the file, only the serialized tables are skipped
+		void skip_globals(reader& stream, const std::size_t blend_state_size)
+		{
+			const auto pointer = stream.read<std::uint64_t>();
+			if (!pointer)
+			{
+				return;
+			}
+
+			const auto globals = stream.read<gfx_globals>();
+			skip_array(stream, globals.depth_stencil_state_bits, globals.depth_stencil_state_count, sizeof(std::uint64_t));
+			skip_array(stream, globals.blend_state_bits, globals.blend_state_count, blend_state_size);
+			skip_array(stream, globals.per_prim_constant_buffer_sizes, globals.per_prim_constant_buffer_count, sizeof(std::uint32_t));
+			skip_array(stream, globals.per_obj_constant_buffer_sizes, globals.per_obj_constant_buffer_count, sizeof(std::uint32_t));
+			skip_array(stream, globals.stable_constant_buffer_sizes, globals.stable_constant_buffer_count, sizeof(std::uint32_t));
+		}
+	}
+
+	const std::vector<const char*>& get_stream_names(const file_layout layout)
+	{
+		static const std::vector<const char*> classic_names =
+		{
+			"temp", "physical", "runtime", "virtual", "large", "callback", "script",
+		};
+
+		static const std::vector<const char*> iw7_names =
+		{
+			"temp", "temp_preload", "temp_postload", "image_stream", "shared_stream",
+			"callback", "runtime", "unk7", "virtual", "script",
+		};
+
+		return layout == file_layout::iw7 ? iw7_names : classic_names;
+	}
+
+	zone_contents read_zone(const fastfile& ff)
+	{
+		zone_contents zone{};
+		reader stream(ff.zone);
+
+		if (ff.game->layout == file_layout::classic)
+		{
+			const auto memory = stream.read<zonetool::XZoneMemory<zonetool::MAX_XFILE_COUNT>>();
+			zone.stream_sizes.assign(std::begin(memory.streams), std::end(memory.streams));
+			zone.declared_size = memory.size;
+
+			if (memory.size != ff.zone.size() - sizeof(memory))
+			{
+				zone.errors.emplace_back("XZoneMemory size " + std::to_string(memory.size) + " doesn't match the zone size " +
+					std::to_string(ff.zone.size() - sizeof(memory)));
+			}
+		}
+		else
+		{
+			zone.stream_sizes = ff.block_sizes;
+			zone.declared_size = ff.zone.size();
+		}
+
+		zone.script_string_count = static_cast<std::size_t>(stream.read<std::uint64_t>());
+		const auto strings_pointer = stream.read<std::uint64_t>();
+		const auto asset_count = static_cast<std::size_t>(stream.read<std::uint64_t>());
+		const auto assets_pointer = stream.read<std::uint64_t>();
+		zone.has_globals = stream.read<std::uint64_t>() != 0;
+
+		if (zone.script_string_count && strings_pointer != data_following)
+		{
+			zone.errors.emplace_back("script strings are counted but their pointer isn't set");
+		}
+
+		if (asset_count && assets_pointer != data_following)
+		{
+			zone.errors.emplace_back("assets are counted but their pointer isn't set");
+		}
+
+		if (zone.script_string_count > stream.remaining() / sizeof(std::uint64_t))
+		{
+			throw std::runtime_error("script string count is larger than the zone");
+		}
+
+		std::vector<std::uint64_t> string_pointers(zone.script_string_count);
+		if (zone.script_string_count)
+		{
+			stream.read(string_pointers.data(), string_pointers.size() * sizeof(std::uint64_t));
+		}
+
+		zone.script_strings.reserve(zone.script_string_count);
+		for (const auto pointer : string_pointers)
+		{
+			if (!pointer)
+			{
+				zone.null_script_string_count++;
+				zone.script_strings.emplace_back();
+				continue;
+			}
+
+			zone.script_strings.emplace_back(stream.read_string());
+		}
+
+		if (zone.has_globals)
+		{
+			skip_globals(stream, ff.game->blend_state_size);
+		}
+
+		if (asset_count > stream.remaining() / sizeof(asset_entry))
+		{
+			throw std::runtime_error("asset count is larger than the zone");
+		}
+
+		zone.assets.resize(asset_count);
+		if (asset_count)
+		{
+			stream.read(zone.assets.data(), asset_count * sizeof(asset_entry));
+		}
+
+		for (auto i = 0u; i < zone.assets.size(); i++)
+		{
+			if (zone.assets[i].pointer != data_following)
+			{
+				zone.errors.emplace_back("asset " + std::to_string(i) + " isn't followed by its data");
+			}
+		}
+
+		zone.asset_data_offset = stream.offset();
+		zone.asset_data_size = stream.remaining();
+
+		return zone;
+	}
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "fastfile.hpp"
+
+namespace zoneinspect
+{
+	struct asset_entry
+	{
+		std::uint64_t type;
+		std::uint64_t pointer;
+	};
+
+	struct zone_contents
+	{
+		// XZoneMemory streams for the older games, the header block sizes for iw7
+		std::vector<std::uint64_t> stream_sizes;
+		std::uint64_t declared_size;
+
+		std::size_t script_string_count;
+		std::size_t null_script_string_count;
+		std::vector<std::string> script_strings;
+
+		bool has_globals;
+
+		std::vector<asset_entry> assets;
+		std::size_t asset_data_offset;
+		std::size_t asset_data_size;
+
+		// inconsistencies that don't stop the walk
+		std::vector<std::string> errors;
+	};
+
+	const std::vector<const char*>& get_stream_names(file_layout layout);
+
+	// walks the zone header up to the asset list, the asset data itself is left untouched
+	zone_contents read_zone(const fastfile& ff);
+}
@@ -9,15 +9,26 @@ function zonetool:project()
 		pchheader "std_include.hpp"
 		pchsource "src/zonetool/std_include.cpp"
 
+		-- compile-time lookup tables (zonetool/utils/perfect_hash.hpp) need more than the default constexpr budget
+		buildoptions {"/constexpr:steps10000000"}
+
 		linkoptions {"/IGNORE:4254", "/DYNAMICBASE:NO", "/SAFESEH:NO", "/LARGEADDRESSAWARE", "/LAST:.main", "/PDBCompress"}
 
 		files {
 			"./src/zonetool/**.rc", 
 			"./src/zonetool/**.hpp", 
 			"./src/zonetool/**.cpp", 
-			"./src/zonetool/resources/**.*"
+			"./src/zonetool/resources/**.*", 
+			"./src/zoneinspect/fastfile.*", 
+			"./src/zoneinspect/zone.*", 
+			"./src/zoneinspect/reader.hpp"
 		}
 
+		-- the offline reader is shared with zoneinspect, which builds without the precompiled header
+		filter "files:src/zoneinspect/**.cpp"
+			flags {"NoPCH"}
+		filter {}
+
 		includedirs {
 			"./src", 
 			"./src/zonetool", 
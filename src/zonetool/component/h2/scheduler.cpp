@@ -5,9 +5,9 @@
 #include "game/h2/game.hpp"
 
 #include <utils/hook.hpp>
-#include <utils/concurrency.hpp>
 #include <utils/string.hpp>
-#include <utils/thread.hpp>
+
+#include "zonetool/utils/task_pipeline.hpp"
 
 namespace h2
 {
@@ -15,79 +15,7 @@ namespace h2
 	{
 		namespace
 		{
-			struct task
-			{
-				std::function<bool()> handler{};
-				std::chrono::milliseconds interval{};
-				std::chrono::high_resolution_clock::time_point last_call{};
-			};
-
-			using task_list = std::vector<task>;
-
-			class task_pipeline
-			{
-			public:
-				void add(task&& task)
-				{
-					new_callbacks_.access([&task](task_list& tasks)
-					{
-						tasks.emplace_back(std::move(task));
-					});
-				}
-
-				void execute()
-				{
-					callbacks_.access([&](task_list& tasks)
-					{
-						this->merge_callbacks();
-
-						for (auto i = tasks.begin(); i != tasks.end();)
-						{
-							const auto now = std::chrono::high_resolution_clock::now();
-							const auto diff = now - i->last_call;
-
-							if (diff < i->interval)
-							{
-								++i;
-								continue;
-							}
-
-							i->last_call = now;
-
-							const auto res = i->handler();
-							if (res == cond_end)
-							{
-								i = tasks.erase(i);
-							}
-							else
-							{
-								++i;
-							}
-						}
-					});
-				}
-
-			private:
-				utils::concurrency::container<task_list> new_callbacks_;
-				utils::concurrency::container<task_list, std::recursive_mutex> callbacks_;
-
-				void merge_callbacks()
-				{
-					callbacks_.access([&](task_list& tasks)
-					{
-						new_callbacks_.access([&](task_list& new_tasks)
-						{
-							tasks.insert(tasks.end(), std::move_iterator<task_list::iterator>(new_tasks.begin()),
-								std::move_iterator<task_list::iterator>(new_tasks.end()));
-							new_tasks = {};
-						});
-					});
-				}
-			};
-
-			volatile bool kill = false;
-			std::thread thread;
-			task_pipeline pipelines[pipeline::count];
+			zonetool::task_pipeline pipelines[pipeline::count];
 			utils::hook::detour main_frame_hook;
 
 			void execute(const pipeline type)
@@ -108,12 +36,8 @@ namespace h2
 		{
 			assert(type >= 0 && type < pipeline::count);
 
-			task task;
-			task.handler = callback;
-			task.interval = delay;
-			task.last_call = std::chrono::high_resolution_clock::now();
-
-			pipelines[type].add(std::move(task));
+			auto handler = callback;
+			pipelines[type].add(std::move(handler), delay);
 		}
 
 		void loop(const std::function<void()>& callback, const pipeline type,
@@ -141,14 +65,7 @@ namespace h2
 		public:
 			void post_start() override
 			{
-				thread = utils::thread::create_named_thread("Async Scheduler", []()
-				{
-					while (!kill)
-					{
-						execute(pipeline::async);
-						std::this_thread::sleep_for(10ms);
-					}
-				});
+				pipelines[pipeline::async].start("Async Scheduler", 2, 10ms);
 			}
 
 			void post_unpack() override
@@ -158,11 +75,7 @@ namespace h2
 
 			void pre_destroy() override
 			{
-				kill = true;
-				if (thread.joinable())
-				{
-					thread.join();
-				}
+				pipelines[pipeline::async].stop();
 			}
 		};
 	}
@@ -2,8 +2,10 @@
 #include "loader/component_loader.hpp"
 
 #include "command.hpp"
+#include "fastfiles.hpp"
 
 #include <utils/hook.hpp>
+#include <utils/concurrency.hpp>
 
 namespace iw6
 {
@@ -11,11 +13,20 @@ namespace iw6
 	{
 		namespace
 		{
+			utils::concurrency::container<std::string> current_fastfile;
+
 			utils::hook::detour db_init_load_x_file_hook;
 
 			void db_init_load_x_file(/*DBFile**/std::uintptr_t file, std::uint64_t offset)
 			{
-				printf("Loading xfile %s\n", reinterpret_cast<const char*>(file + 24));
+				const auto zone_name = reinterpret_cast<const char*>(file + 24);
+#ifdef DEBUG
+				printf("Loading xfile %s\n", zone_name);
+#endif
+				current_fastfile.access([&](std::string& fastfile)
+				{
+					fastfile = zone_name;
+				});
 				return db_init_load_x_file_hook.invoke<void>(file, offset);
 			}
 
@@ -44,14 +55,20 @@ namespace iw6
 			}
 		}
 
+		std::string get_current_fastfile()
+		{
+			return current_fastfile.access<std::string>([&](std::string& fastfile)
+			{
+				return fastfile;
+			});
+		}
+
 		class component final : public component_interface
 		{
 		public:
 			void post_unpack() override
 			{
-#ifdef DEBUG
 				db_init_load_x_file_hook.create(0x1402FC550, &db_init_load_x_file);
-#endif
 
 				// Allow loading of unsigned fastfiles
 				utils::hook::set<uint8_t>(0x1402FBF23, 0xEB); // main function
@@ -4,8 +4,10 @@
 #include "game/s1/dvars.hpp"
 
 #include "command.hpp"
+#include "fastfiles.hpp"
 
 #include <utils/hook.hpp>
+#include <utils/concurrency.hpp>
 
 namespace s1
 {
@@ -13,11 +15,20 @@ namespace s1
 	{
 		namespace
 		{
+			utils::concurrency::container<std::string> current_fastfile;
+
 			utils::hook::detour db_init_load_x_file_hook;
 
 			void db_init_load_x_file(/*DBFile**/std::uintptr_t file, std::uint64_t offset)
 			{
-				printf("Loading xfile %s\n", reinterpret_cast<const char*>(file + 24));
+				const auto zone_name = reinterpret_cast<const char*>(file + 24);
+#ifdef DEBUG
+				printf("Loading xfile %s\n", zone_name);
+#endif
+				current_fastfile.access([&](std::string& fastfile)
+				{
+					fastfile = zone_name;
+				});
 				return db_init_load_x_file_hook.invoke<void>(file, offset);
 			}
 
@@ -46,14 +57,20 @@ namespace s1
 			}
 		}
 
+		std::string get_current_fastfile()
+		{
+			return current_fastfile.access<std::string>([&](std::string& fastfile)
+			{
+				return fastfile;
+			});
+		}
+
 		class component final : public component_interface
 		{
 		public:
 			void post_unpack() override
 			{
-#ifdef DEBUG
 				db_init_load_x_file_hook.create(0x1402428B0, &db_init_load_x_file);
-#endif
 
 				// Allow loading of unsigned fastfiles
 				utils::hook::nop(0x1402427A5, 2); // DB_InflateInit
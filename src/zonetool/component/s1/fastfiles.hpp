@@ -0,0 +1,9 @@
+#pragma once
+
+namespace s1
+{
+	namespace fastfiles
+	{
+		std::string get_current_fastfile();
+	}
+}
@@ -0,0 +1,13 @@
+#pragma once
+
+namespace zonetool
+{
+	namespace half_float
+	{
+		typedef unsigned short ushort;
+		typedef unsigned int uint;
+
+		float half_to_float(const ushort x);
+		ushort float_to_half(const float x);
+	}
+}
@@ -9,6 +9,9 @@ namespace zonetool
 	namespace
 	{
 		std::unordered_map<std::uint32_t, void*> x_gfx_globals_map;
+		std::mutex x_gfx_globals_mutex;
+
+		thread_local bool database_access = true;
 
 		namespace iw6
 		{
@@ -92,17 +95,33 @@ namespace zonetool
 
 	void* get_x_gfx_globals_for_zone(int zone)
 	{
+		std::lock_guard<std::mutex> _(x_gfx_globals_mutex);
 		return x_gfx_globals_map[zone];
 	}
 
 	void insert_x_gfx_globals_for_zone(int zone, void* globals)
 	{
+		std::lock_guard<std::mutex> _(x_gfx_globals_mutex);
 		x_gfx_globals_map[zone] = globals;
 	}
 
+	void set_database_access(const bool allowed)
+	{
+		database_access = allowed;
+	}
+
+	void check_database_access()
+	{
+		if (!database_access)
+		{
+			throw database_unavailable();
+		}
+	}
+
 	const char* strip_template(const std::string& function_name)
 	{
-		static char new_string[0x2000] = {0};
+		// dump workers log concurrently
+		static thread_local char new_string[0x2000] = {0};
 		std::memset(new_string, 0, sizeof(new_string));
 
 		for (auto i = 0; i < function_name.size(); i++)
@@ -120,20 +139,10 @@ namespace zonetool
 
 	std::uint32_t snd_hash_name(const char* name)
 	{
-		if (!name || !*name)
+		if (!name)
 			return 0;
 
-		std::uint32_t hash = 5381;
-
-		while (*name)
-		{
-			unsigned char lowercase = static_cast<unsigned char>(std::tolower(static_cast<unsigned char>(*name)));
-
-			hash = 65599 * hash + lowercase;
-			++name;
-		}
-
-		return hash ? hash : 1;
+		return snd_hash_name(std::string_view(name));
 	}
 
 	int string_table_hash(const std::string& string)
@@ -163,29 +172,6 @@ namespace zonetool
 		}
 	}
 
-	namespace half_float
-	{
-		uint as_uint(const float x) {
-			return *(uint*)&x;
-		}
-		float as_float(const uint x) {
-			return *(float*)&x;
-		}
-
-		float half_to_float(const ushort x) { // IEEE-754 16-bit floating-point format (without infinity): 1-5-10, exp-15, +-131008.0, +-6.1035156E-5, +-5.9604645E-8, 3.311 digits
-			const uint e = (x & 0x7C00) >> 10; // exponent
-			const uint m = (x & 0x03FF) << 13; // mantissa
-			const uint v = as_uint((float)m) >> 23; // evil log2 bit hack to count leading zeros in denormalized format
-			return as_float((x & 0x8000) << 16 | (e != 0) * ((e + 112) << 23 | m) | ((e == 0) & (m != 0)) * ((v - 37) << 23 | ((m << (150 - v)) & 0x007FE000))); // sign : normalized : denormalized
-		}
-		ushort float_to_half(const float x) { // IEEE-754 16-bit floating-point format (without infinity): 1-5-10, exp-15, +-131008.0, +-6.1035156E-5, +-5.9604645E-8, 3.311 digits
-			const uint b = as_uint(x) + 0x00001000; // round-to-nearest-even: add last bit after truncated mantissa
-			const uint e = (b & 0x7F800000) >> 23; // exponent
-			const uint m = b & 0x007FFFFF; // mantissa; in line below: 0x007FF000 = 0x00800000-0x00001000 = decimal indicator flag - initial rounding
-			return (ushort)((b & 0x80000000) >> 16 | (e > 112) * ((((e - 112) << 10) & 0x7C00) | m >> 13) | ((e < 113) & (e > 101)) * ((((0x007FF000 + m) >> (125 - e)) + 1) >> 1) | (e > 143) * 0x7FFF); // sign : normalized : denormalized : saturate
-		}
-	}
-
 	namespace self_visibility
 	{
 		// Packing function
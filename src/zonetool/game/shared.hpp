@@ -3,74 +3,11 @@
 #define WEAK __declspec(selectany)
 
 #include "mode.hpp"
+#include "half_float.hpp"
+#include "xfile.hpp"
 
 namespace zonetool
 {
-#pragma pack(push, 1)
-	struct XFileHeader
-	{
-		char header[8];
-		std::uint32_t version;
-		std::uint8_t compress;
-		std::uint8_t compressType;
-		std::uint8_t sizeOfPointer;
-		std::uint8_t sizeOfLong;
-		std::uint32_t fileTimeHigh;
-		std::uint32_t fileTimeLow;
-		std::uint32_t imageCount;
-		std::uint64_t baseFileLen;
-		std::uint64_t totalFileLen;
-	};
-
-	template <std::size_t num_streams>
-	struct XZoneMemory
-	{
-		std::uint64_t size;
-		std::uint64_t externalsize;
-		std::uint64_t streams[num_streams];
-	};
-
-	struct XStreamFile
-	{
-		std::uint16_t isLocalized;
-		std::uint16_t fileIndex;
-		char pad[4];
-		std::uint64_t offset;
-		std::uint64_t offsetEnd;
-	};
-
-	struct DB_AuthSignature
-	{
-		unsigned char bytes[256];
-	};
-
-	struct DB_AuthHash
-	{
-		unsigned char bytes[32];
-	};
-
-	struct XPakHeader
-	{
-		char header[8];
-		std::int32_t version;
-		unsigned char unknown[16];
-		DB_AuthHash hash;
-		DB_AuthSignature signature;
-	};
-#pragma pack(pop)
-
-	enum XFileBlock
-	{
-		XFILE_BLOCK_TEMP = 0x0,
-		XFILE_BLOCK_PHYSICAL = 0x1,
-		XFILE_BLOCK_RUNTIME = 0x2,
-		XFILE_BLOCK_VIRTUAL = 0x3,
-		XFILE_BLOCK_LARGE = 0x4,
-		XFILE_BLOCK_CALLBACK = 0x5,
-		XFILE_BLOCK_SCRIPT = 0x6,
-		MAX_XFILE_COUNT = 0x7,
-	};
-
 	template <typename T>
 	class symbol
 	{
@@ -132,6 +69,22 @@ namespace zonetool
 		return reinterpret_cast<T*>(get_x_gfx_globals_for_zone(zone));
 	}
 
+	constexpr std::uint32_t snd_hash_name(std::string_view name)
+	{
+		if (name.empty())
+			return 0;
+
+		std::uint32_t hash = 5381;
+
+		for (const auto c : name)
+		{
+			const auto lowercase = static_cast<unsigned char>(c >= 'A' && c <= 'Z' ? c + ('a' - 'A') : c);
+			hash = 65599 * hash + lowercase;
+		}
+
+		return hash ? hash : 1;
+	}
+
 	std::uint32_t snd_hash_name(const char* name);
 	int string_table_hash(const std::string& string);
 
@@ -141,15 +94,6 @@ namespace zonetool
 		float ToFloat(const short quat);
 	}
 
-	namespace half_float
-	{
-		typedef unsigned short ushort;
-		typedef unsigned int uint;
-
-		float half_to_float(const ushort x);
-		ushort float_to_half(const float x);
-	}
-
 	namespace self_visibility
 	{
 		uint32_t XSurfacePackSelfVisibility(float* packed);
@@ -190,15 +134,31 @@ namespace zonetool
 	WEAK symbol<XStreamFile> stream_files;
 	WEAK symbol<unsigned int> stream_file_index;
 
+	// the game's asset database belongs to the main thread, asset_prefetch workers turn their access off
+	class database_unavailable : public std::runtime_error
+	{
+	public:
+		database_unavailable()
+			: std::runtime_error("the asset database can't be used from this thread")
+		{
+		}
+	};
+
+	void set_database_access(bool allowed);
+	// throws database_unavailable on threads without access
+	void check_database_access();
+
 	template <typename T>
 	T db_find_x_asset_header(int type, const char* name, int create_default)
 	{
+		check_database_access();
 		return static_cast<T>(DB_FindXAssetHeader(type, name, create_default));
 	}
 
 	template <typename T>
 	T* db_find_x_asset_entry(int type, const char* name)
 	{
+		check_database_access();
 		return reinterpret_cast<T*>(DB_FindXAssetEntry(type, name));
 	}
 
@@ -92,6 +92,11 @@ namespace zonetool::h1
 		static_assert(std::is_same_v<decltype(asset->__field__), const char*>, "Field is not of type const char*"); \
 		!data[#__field__].is_null() && !data[#__field__].get<std::string>().empty() ? asset->__field__ = mem->duplicate_string(data[#__field__].get<std::string>()) : asset->__field__ = nullptr;
 
+// for strings that are only written out, equal ones share a copy
+#define PARSE_POOLED_STRING(__field__) \
+		static_assert(std::is_same_v<decltype(asset->__field__), const char*>, "Field is not of type const char*"); \
+		!data[#__field__].is_null() && !data[#__field__].get<std::string>().empty() ? asset->__field__ = mem->intern_string(data[#__field__].get<std::string>()) : asset->__field__ = nullptr;
+
 #define PARSE_FIELD(__field__) \
 		if (!data[#__field__].is_null()) asset->__field__ = data[#__field__].get<decltype(asset->__field__)>();
 
@@ -147,10 +152,10 @@ namespace zonetool::h1
 				PARSE_ASSET(effectDef.handle);
 				break;
 			case FX_ELEM_TYPE_SOUND:
-				PARSE_STRING(soundName);
+				PARSE_POOLED_STRING(soundName);
 				break;
 			case FX_ELEM_TYPE_VECTORFIELD:
-				PARSE_STRING(vectorFieldName);
+				PARSE_POOLED_STRING(vectorFieldName);
 				break;
 			case FX_ELEM_TYPE_PARTICLE_SIM_ANIMATION:
 				PARSE_ASSET(particleSimAnimation);
@@ -1459,13 +1464,13 @@ namespace zonetool::h1
 			dest->model = reinterpret_cast<XModel*>(zone->get_asset_pointer(ASSET_TYPE_XMODEL, data->model->name));
 			break;
 		case FX_ELEM_TYPE_RUNNER:
-			dest->effectDef.name = buf->write_str(data->effectDef.handle->name);
+			dest->effectDef.name = buf->write_pooled_str(data->effectDef.handle->name);
 			break;
 		case FX_ELEM_TYPE_SOUND:
-			dest->soundName = buf->write_str(data->soundName);
+			dest->soundName = buf->write_pooled_str(data->soundName);
 			break;
 		case FX_ELEM_TYPE_VECTORFIELD:
-			dest->vectorFieldName = buf->write_str(data->vectorFieldName);
+			dest->vectorFieldName = buf->write_pooled_str(data->vectorFieldName);
 			break;
 		case FX_ELEM_TYPE_PARTICLE_SIM_ANIMATION:
 			dest->particleSimAnimation = reinterpret_cast<FxParticleSimAnimation*>(zone->get_asset_pointer(ASSET_TYPE_PARTICLE_SIM_ANIMATION, data->particleSimAnimation->name));
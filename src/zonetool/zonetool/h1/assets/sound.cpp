@@ -289,7 +289,7 @@ namespace zonetool::h1
 		asset->entry->name = mem->duplicate_string(snddata[#entry].get<std::string>().data()); }
 #define SOUND_READ_STRING(entry) \
 	if (!snddata[#entry].is_null()) { \
-		asset->entry = mem->duplicate_string(snddata[#entry].get<std::string>().data()); \
+		asset->entry = mem->intern_string(snddata[#entry].get<std::string>()); \
 	} else { asset->entry = nullptr; }
 #define SOUND_READ_FIELD(entry) \
 	asset->entry = snddata[#entry].get<decltype(asset->entry)>()
@@ -324,8 +324,8 @@ namespace zonetool::h1
 			}
 			else
 			{
-				asset->soundFile->u.streamSnd.filename.info.raw.dir = mem->duplicate_string(snddata["soundfile"]["raw"]["dir"].get<std::string>().data());
-				asset->soundFile->u.streamSnd.filename.info.raw.name = mem->duplicate_string(snddata["soundfile"]["raw"]["name"].get<std::string>().data());
+				asset->soundFile->u.streamSnd.filename.info.raw.dir = mem->intern_string(snddata["soundfile"]["raw"]["dir"].get<std::string>());
+				asset->soundFile->u.streamSnd.filename.info.raw.name = mem->intern_string(snddata["soundfile"]["raw"]["name"].get<std::string>());
 			}
 		}
 		else if (asset->soundFile->type == SAT_PRIMED)
@@ -619,12 +619,12 @@ namespace zonetool::h1
 			{
 				if (data->u.streamSnd.filename.info.raw.dir)
 				{
-					dest->u.streamSnd.filename.info.raw.dir = buf->write_str(data->u.streamSnd.filename.info.raw.dir);
+					dest->u.streamSnd.filename.info.raw.dir = buf->write_pooled_str(data->u.streamSnd.filename.info.raw.dir);
 				}
 
 				if (data->u.streamSnd.filename.info.raw.name)
 				{
-					dest->u.streamSnd.filename.info.raw.name = buf->write_str(data->u.streamSnd.filename.info.raw.name);
+					dest->u.streamSnd.filename.info.raw.name = buf->write_pooled_str(data->u.streamSnd.filename.info.raw.name);
 				}
 			}
 		}
@@ -640,12 +640,12 @@ namespace zonetool::h1
 			{
 				if (data->u.streamSnd.filename.info.raw.dir)
 				{
-					dest->u.streamSnd.filename.info.raw.dir = buf->write_str(data->u.streamSnd.filename.info.raw.dir);
+					dest->u.streamSnd.filename.info.raw.dir = buf->write_pooled_str(data->u.streamSnd.filename.info.raw.dir);
 				}
 
 				if (data->u.streamSnd.filename.info.raw.name)
 				{
-					dest->u.streamSnd.filename.info.raw.name = buf->write_str(data->u.streamSnd.filename.info.raw.name);
+					dest->u.streamSnd.filename.info.raw.name = buf->write_pooled_str(data->u.streamSnd.filename.info.raw.name);
 				}
 			}
 		}
@@ -662,22 +662,22 @@ namespace zonetool::h1
 
 		if (data->subtitle)
 		{
-			dest->subtitle = buf->write_str(data->subtitle);
+			dest->subtitle = buf->write_pooled_str(data->subtitle);
 		}
 
 		if (data->secondaryAliasName)
 		{
-			dest->secondaryAliasName = buf->write_str(data->secondaryAliasName);
+			dest->secondaryAliasName = buf->write_pooled_str(data->secondaryAliasName);
 		}
 
 		if (data->chainAliasName)
 		{
-			dest->chainAliasName = buf->write_str(data->chainAliasName);
+			dest->chainAliasName = buf->write_pooled_str(data->chainAliasName);
 		}
 
 		if (data->squelchName)
 		{
-			dest->squelchName = buf->write_str(data->squelchName);
+			dest->squelchName = buf->write_pooled_str(data->squelchName);
 		}
 
 		if (data->soundFile)
@@ -146,72 +146,182 @@ namespace zonetool::h1
 			}
 		}
 
-		std::string get_parse_path(const std::string& type, const std::string& ext, const std::string& techset, const std::string& material, bool* use_path)
-		{
-			const std::string parent_path = utils::string::va("techsets\\%s\\%s", type.data(), techset.data());
-			const std::string file = utils::string::va("%s%s", material.data(), ext.data());
-			std::string path = parent_path + "\\" + file;
+		// every material of a techset reads the same sidecar files, parse each of them once per build.
+		// entries are filled outside the lock so materials loading on other threads only wait for the same key
+		template <typename T>
+		class sidecar_cache
+		{
+		public:
+			template <typename F>
+			const T& get(const std::string& key, F&& parse)
+			{
+				std::shared_ptr<entry> found;
 
-			if (filesystem::file(path).exists())
+				{
+					std::lock_guard<std::mutex> _(this->mutex_);
+					auto& slot = this->entries_[key];
+					if (!slot)
+					{
+						slot = std::make_shared<entry>();
+					}
+
+					found = slot;
+				}
+
+				std::call_once(found->once, [&]
+				{
+					found->value = parse();
+				});
+
+				return found->value;
+			}
+
+			void clear()
 			{
-				return path;
+				std::lock_guard<std::mutex> _(this->mutex_);
+				this->entries_.clear();
 			}
 
+		private:
+			struct entry
+			{
+				std::once_flag once;
+				T value{};
+			};
+
+			std::mutex mutex_;
+			std::unordered_map<std::string, std::shared_ptr<entry>> entries_;
+		};
+
+		struct fallback_path
+		{
+			std::string path;
+			bool use_path;
+		};
+
+		// resolved once per techset directory, the walk doesn't depend on the material
+		sidecar_cache<std::optional<fallback_path>> fallback_paths;
+
+		std::optional<fallback_path> find_fallback_path(const std::string& type, const std::string& ext, const std::string& parent_path)
+		{
 #ifdef DEEP_LOOK_TECHNIQUES
 			// get best one from the directories
+			mdata_s best_file{};
+			for (const auto& parse_path : filesystem::get_search_paths())
 			{
-				mdata_s best_file{};
-				for (const auto& parse_path : filesystem::get_search_paths())
+				const std::string dir = parse_path + parent_path;
+				const auto best_file_in_dir = find_best_file_with_extension_in_directory(dir, ext, type);
+				if (best_file_in_dir.has_value())
 				{
-					const std::string dir = parse_path + parent_path;
-					const auto best_file_in_dir = find_best_file_with_extension_in_directory(dir, ext, type);
-					if (best_file_in_dir.has_value())
+					auto best_file_ = best_file_in_dir.value();
+					if (best_file.name.empty() || is_better_option(best_file_, best_file))
 					{
-						auto best_file_ = best_file_in_dir.value();
-						if (best_file.name.empty() || is_better_option(best_file_, best_file))
-						{
-							best_file = best_file_;
-						}
+						best_file = best_file_;
+					}
 
-						if (is_best_option(best_file))
-						{
-							*use_path = false;
-							return best_file.name;
-						}
+					if (is_best_option(best_file))
+					{
+						return fallback_path{best_file.name, false};
 					}
 				}
-				if (!best_file.name.empty())
+			}
+			if (!best_file.name.empty())
+			{
+				if (!is_best_option(best_file))
 				{
-					if (!is_best_option(best_file))
-					{
-						//__debugbreak();
-					}
-					*use_path = false;
-					return best_file.name;
+					//__debugbreak();
 				}
+				return fallback_path{best_file.name, false};
 			}
 #else
 			// get a random one from the directory
+			for (const auto& parse_path : filesystem::get_search_paths())
 			{
-				for (const auto& parse_path : filesystem::get_search_paths())
+				const std::string dir = parse_path + parent_path;
+				const auto first_file = find_first_file_with_extension_in_directory(dir, ext);
+				if (first_file.has_value() && !first_file.value().empty())
 				{
-					const std::string dir = parse_path + parent_path;
-					const auto first_file = find_first_file_with_extension_in_directory(dir, ext);
-					if (first_file.has_value() && !first_file.value().empty())
-					{
-						path = parent_path + "\\" + first_file.value();
-						return path;
-					}
+					return fallback_path{parent_path + "\\" + first_file.value(), true};
 				}
 			}
 #endif
 
+			return {};
+		}
+
+		std::string get_parse_path(const std::string& type, const std::string& ext, const std::string& techset, const std::string& material, bool* use_path)
+		{
+			const std::string parent_path = utils::string::va("techsets\\%s\\%s", type.data(), techset.data());
+			const std::string file = utils::string::va("%s%s", material.data(), ext.data());
+			std::string path = parent_path + "\\" + file;
+
+			if (filesystem::file(path).exists())
+			{
+				return path;
+			}
+
+			const auto& fallback = fallback_paths.get(parent_path + ext, [&]
+			{
+				return find_fallback_path(type, ext, parent_path);
+			});
+
+			if (fallback.has_value())
+			{
+				*use_path = fallback->use_path;
+				return fallback->path;
+			}
+
 			return path;
 		}
+
+		using technique_bytes = std::array<unsigned char, MaterialTechniqueType::TECHNIQUE_COUNT>;
+
+		struct statebits_map
+		{
+			std::vector<GfxStateBits> bits;
+			std::vector<std::array<std::uint64_t, 10>> depth_stencil_state_bits;
+			std::vector<std::array<std::uint32_t, 3>> blend_state_bits;
+		};
+
+		struct constant_buffer_defs
+		{
+			MaterialConstantBufferDef* defs;
+			unsigned char count;
+		};
+
+		// keyed by the resolved file, materials that fell back to the same file share the entry
+		sidecar_cache<std::optional<technique_bytes>> constant_buffer_indexes;
+		sidecar_cache<std::optional<constant_buffer_defs>> constant_buffer_def_arrays;
+		sidecar_cache<std::optional<unsigned char>> state_flags;
+		sidecar_cache<std::optional<technique_bytes>> statebits;
+		sidecar_cache<std::optional<statebits_map>> statebits_maps;
+
+		template <typename T>
+		T* copy_array(const T* data, const std::size_t count, zone_memory* mem)
+		{
+			if (!data)
+			{
+				return nullptr;
+			}
+
+			auto* copy = mem->allocate<T>(count);
+			std::memcpy(copy, data, sizeof(T) * count);
+			return copy;
+		}
 	}
 
 	std::unordered_map<std::string, std::uintptr_t> techset::vertexdecl_pointers;
 
+	void techset::clear_sidecar_cache()
+	{
+		material_data::fallback_paths.clear();
+		material_data::constant_buffer_indexes.clear();
+		material_data::constant_buffer_def_arrays.clear();
+		material_data::state_flags.clear();
+		material_data::statebits.clear();
+		material_data::statebits_maps.clear();
+	}
+
 	std::uintptr_t techset::get_vertexdecl_pointer(std::string vertexdecl)
 	{
 		if (vertexdecl_pointers.find(vertexdecl) != vertexdecl_pointers.end())
@@ -499,21 +609,27 @@ namespace zonetool::h1
 	{
 		bool use_path = true;
 		const auto path = material_data::get_parse_path("constantbuffer", ".cbi", techset, material, &use_path);
-		auto file = filesystem::file(path);
-		file.open("rb", use_path);
-		auto fp = file.get_fp();
-
-		if (fp)
+		const auto& cached = material_data::constant_buffer_indexes.get(path, [&]() -> std::optional<material_data::technique_bytes>
 		{
-			fread(indexes, MaterialTechniqueType::TECHNIQUE_COUNT, 1, fp);
+			auto file = filesystem::file(path);
+			file.open("rb", use_path);
+			auto fp = file.get_fp();
+
+			if (!fp)
+			{
+				return {};
+			}
+
+			material_data::technique_bytes data{};
+			fread(data.data(), data.size(), 1, fp);
 			file.close();
 
 #ifdef DEEP_LOOK_TECHNIQUES
 			const auto add = [&](MaterialTechniqueType type, MaterialTechniqueType a2 = MaterialTechniqueType::TECHNIQUE_LIT_DIR)
 			{
-				if (indexes[type] == 0xFF)
+				if (data[type] == 0xFF)
 				{
-					indexes[type] = indexes[a2];
+					data[type] = data[a2];
 				}
 			};
 
@@ -614,6 +730,12 @@ namespace zonetool::h1
 			add(MaterialTechniqueType::TECHNIQUE_NO_DISPLACEMENT_LIT_OMNI_SHADOW_DFOG, MaterialTechniqueType::TECHNIQUE_NO_DISPLACEMENT_LIT_DIR_SHADOW_DFOG);
 #endif
 
+			return data;
+		});
+
+		if (cached.has_value())
+		{
+			std::memcpy(indexes, cached->data(), cached->size());
 			return;
 		}
 
@@ -625,53 +747,74 @@ namespace zonetool::h1
 	{
 		bool use_path = true;
 		const auto path = material_data::get_parse_path("constantbuffer", ".cbt", techset, material, &use_path);
-		assetmanager::reader read(mem);
-		if (!read.open(path, use_path))
-		{
-			(*def_ptr) = nullptr;
-			return;
-		}
-
-		*count = static_cast<unsigned char>(read.read_int());
-		auto def = read.read_array<MaterialConstantBufferDef>();
-		for (int i = 0; i < *count; i++)
+		const auto& cached = material_data::constant_buffer_def_arrays.get(path, [&]() -> std::optional<material_data::constant_buffer_defs>
 		{
-			if (def[i].vsData)
-			{
-				def[i].vsData = read.read_array<unsigned char>();
-			}
-			if (def[i].hsData)
+			assetmanager::reader read(mem);
+			if (!read.open(path, use_path))
 			{
-				def[i].hsData = read.read_array<unsigned char>();
-			}
-			if (def[i].dsData)
-			{
-				def[i].dsData = read.read_array<unsigned char>();
-			}
-			if (def[i].psData)
-			{
-				def[i].psData = read.read_array<unsigned char>();
-			}
-			if (def[i].vsOffsetData)
-			{
-				def[i].vsOffsetData = read.read_array<unsigned short>();
-			}
-			if (def[i].hsOffsetData)
-			{
-				def[i].hsOffsetData = read.read_array<unsigned short>();
-			}
-			if (def[i].dsOffsetData)
-			{
-				def[i].dsOffsetData = read.read_array<unsigned short>();
+				return {};
 			}
-			if (def[i].psOffsetData)
+
+			const auto def_count = static_cast<unsigned char>(read.read_int());
+			auto def = read.read_array<MaterialConstantBufferDef>();
+			for (int i = 0; i < def_count; i++)
 			{
-				def[i].psOffsetData = read.read_array<unsigned short>();
+				if (def[i].vsData)
+				{
+					def[i].vsData = read.read_array<unsigned char>();
+				}
+				if (def[i].hsData)
+				{
+					def[i].hsData = read.read_array<unsigned char>();
+				}
+				if (def[i].dsData)
+				{
+					def[i].dsData = read.read_array<unsigned char>();
+				}
+				if (def[i].psData)
+				{
+					def[i].psData = read.read_array<unsigned char>();
+				}
+				if (def[i].vsOffsetData)
+				{
+					def[i].vsOffsetData = read.read_array<unsigned short>();
+				}
+				if (def[i].hsOffsetData)
+				{
+					def[i].hsOffsetData = read.read_array<unsigned short>();
+				}
+				if (def[i].dsOffsetData)
+				{
+					def[i].dsOffsetData = read.read_array<unsigned short>();
+				}
+				if (def[i].psOffsetData)
+				{
+					def[i].psOffsetData = read.read_array<unsigned short>();
+				}
 			}
+
+			read.close();
+
+			return material_data::constant_buffer_defs{def, def_count};
+		});
+
+		if (!cached.has_value())
+		{
+			(*def_ptr) = nullptr;
+			return;
 		}
 
-		read.close();
+		// the constant data gets patched per material from its constant table, the offsets are shared
+		auto def = material_data::copy_array(cached->defs, cached->count, mem);
+		for (auto i = 0; i < cached->count; i++)
+		{
+			def[i].vsData = material_data::copy_array(def[i].vsData, def[i].vsDataSize, mem);
+			def[i].hsData = material_data::copy_array(def[i].hsData, def[i].hsDataSize, mem);
+			def[i].dsData = material_data::copy_array(def[i].dsData, def[i].dsDataSize, mem);
+			def[i].psData = material_data::copy_array(def[i].psData, def[i].psDataSize, mem);
+		}
 
+		*count = cached->count;
 		(*def_ptr) = def;
 	}
 
@@ -679,9 +822,14 @@ namespace zonetool::h1
 	{
 		bool use_path = true;
 		const auto path = material_data::get_parse_path("state", ".stateinfo", techset, material, &use_path);
-		filesystem::file file(path);
-		if (file.exists(use_path))
+		const auto& cached = material_data::state_flags.get(path, [&]() -> std::optional<unsigned char>
 		{
+			filesystem::file file(path);
+			if (!file.exists(use_path))
+			{
+				return {};
+			}
+
 			file.open("rb", use_path);
 			const auto size = file.size();
 			auto bytes = file.read_bytes(size);
@@ -689,8 +837,12 @@ namespace zonetool::h1
 
 			auto stateInfo = json::parse(bytes);
 
-			mat->stateFlags = stateInfo["stateFlags"].get<unsigned char>();
+			return stateInfo["stateFlags"].get<unsigned char>();
+		});
 
+		if (cached.has_value())
+		{
+			mat->stateFlags = cached.value();
 			return;
 		}
 		ZONETOOL_FATAL("stateinfo for techset \"%s\", material \"%s\" are missing!", techset.data(), material.data());
@@ -700,21 +852,27 @@ namespace zonetool::h1
 	{
 		bool use_path = true;
 		const auto path = material_data::get_parse_path("state", ".statebits", techset, material, &use_path);
-		auto file = filesystem::file(path);
-		file.open("rb", use_path);
-		auto fp = file.get_fp();
-
-		if (fp)
+		const auto& cached = material_data::statebits.get(path, [&]() -> std::optional<material_data::technique_bytes>
 		{
-			fread(statebits, MaterialTechniqueType::TECHNIQUE_COUNT, 1, fp);
+			auto file = filesystem::file(path);
+			file.open("rb", use_path);
+			auto fp = file.get_fp();
+
+			if (!fp)
+			{
+				return {};
+			}
+
+			material_data::technique_bytes data{};
+			fread(data.data(), data.size(), 1, fp);
 			file.close();
 
 #ifdef DEEP_LOOK_TECHNIQUES
 			const auto add = [&](MaterialTechniqueType type, MaterialTechniqueType a2 = MaterialTechniqueType::TECHNIQUE_LIT_DIR)
 			{
-				if (statebits[type] == 0xFF)
+				if (data[type] == 0xFF)
 				{
-					statebits[type] = statebits[a2];
+					data[type] = data[a2];
 				}
 			};
 
@@ -815,6 +973,12 @@ namespace zonetool::h1
 			add(MaterialTechniqueType::TECHNIQUE_NO_DISPLACEMENT_LIT_OMNI_SHADOW_DFOG, MaterialTechniqueType::TECHNIQUE_NO_DISPLACEMENT_LIT_DIR_SHADOW_DFOG);
 #endif
 
+			return data;
+		});
+
+		if (cached.has_value())
+		{
+			std::memcpy(statebits, cached->data(), cached->size());
 			return;
 		}
 
@@ -828,50 +992,61 @@ namespace zonetool::h1
 	{
 		bool use_path = true;
 		const auto path = material_data::get_parse_path("state", ".statebitsmap", techset, material, &use_path);
-		filesystem::file file(path);
-		if (file.exists(use_path))
+		const auto& cached = material_data::statebits_maps.get(path, [&]() -> std::optional<material_data::statebits_map>
 		{
+			filesystem::file file(path);
+			if (!file.exists(use_path))
+			{
+				return {};
+			}
+
 			file.open("rb", use_path);
 			const auto size = file.size();
 			auto bytes = file.read_bytes(size);
 			file.close();
 
 			auto stateMap = json::parse(bytes);
-			if (stateMap.size() > 0)
+
+			material_data::statebits_map result{};
+			result.bits.resize(stateMap.size());
+			for (int i = 0; i < stateMap.size(); i++)
 			{
-				auto stateBits = mem->allocate<GfxStateBits>(stateMap.size());
-				for (int i = 0; i < stateMap.size(); i++)
+				auto& stateBits = result.bits[i];
+				stateBits.loadBits[0] = stateMap[i]["loadBits"][0].get<unsigned int>();
+				stateBits.loadBits[1] = stateMap[i]["loadBits"][1].get<unsigned int>();
+				stateBits.loadBits[2] = stateMap[i]["loadBits"][2].get<unsigned int>();
+				stateBits.loadBits[3] = stateMap[i]["loadBits"][3].get<unsigned int>();
+				stateBits.loadBits[4] = stateMap[i]["loadBits"][4].get<unsigned int>();
+				stateBits.loadBits[5] = stateMap[i]["loadBits"][5].get<unsigned int>();
+
+				std::array<std::uint64_t, 10> temp_bits = { 0 };
+				for (int j = 0; j < 10; j++)
 				{
-					stateBits[i].loadBits[0] = stateMap[i]["loadBits"][0].get<unsigned int>();
-					stateBits[i].loadBits[1] = stateMap[i]["loadBits"][1].get<unsigned int>();
-					stateBits[i].loadBits[2] = stateMap[i]["loadBits"][2].get<unsigned int>();
-					stateBits[i].loadBits[3] = stateMap[i]["loadBits"][3].get<unsigned int>();
-					stateBits[i].loadBits[4] = stateMap[i]["loadBits"][4].get<unsigned int>();
-					stateBits[i].loadBits[5] = stateMap[i]["loadBits"][5].get<unsigned int>();
-
-					std::array<std::uint64_t, 10> temp_bits = { 0 };
-					for (int j = 0; j < 10; j++)
-					{
-						temp_bits[j] = stateMap[i]["depthStencilStateBits"][j].get<std::uint64_t>();
-					}
-					dssb->push_back(std::move(temp_bits));
-
-					std::array<std::uint32_t, 3> temp_bits2;
-					for (int j = 0; j < 3; j++)
-					{
-						temp_bits2[j] = stateMap[i]["blendStateBits"][j].get<std::uint32_t>();
-					}
-					bsb->push_back(std::move(temp_bits2));
+					temp_bits[j] = stateMap[i]["depthStencilStateBits"][j].get<std::uint64_t>();
+				}
+				result.depth_stencil_state_bits.push_back(std::move(temp_bits));
 
-					stateBits[i].rasterizerState = stateMap[i]["rasterizerState"].get<unsigned char>();
+				std::array<std::uint32_t, 3> temp_bits2;
+				for (int j = 0; j < 3; j++)
+				{
+					temp_bits2[j] = stateMap[i]["blendStateBits"][j].get<std::uint32_t>();
 				}
-				(*map) = stateBits;
-			}
-			else
-			{
-				(*map) = nullptr;
+				result.blend_state_bits.push_back(std::move(temp_bits2));
+
+				stateBits.rasterizerState = stateMap[i]["rasterizerState"].get<unsigned char>();
 			}
-			*count = static_cast<unsigned char>(stateMap.size());
+
+			return result;
+		});
+
+		if (cached.has_value())
+		{
+			// the state tables are resolved per material in prepare, so every material gets its own copy
+			const auto& state_map = cached.value();
+			(*map) = state_map.bits.empty() ? nullptr : material_data::copy_array(state_map.bits.data(), state_map.bits.size(), mem);
+			dssb->insert(dssb->end(), state_map.depth_stencil_state_bits.begin(), state_map.depth_stencil_state_bits.end());
+			bsb->insert(bsb->end(), state_map.blend_state_bits.begin(), state_map.blend_state_bits.end());
+			*count = static_cast<unsigned char>(state_map.bits.size());
 			return;
 		}
 		ZONETOOL_FATAL("statebitsmap for techset \"%s\", material \"%s\" are missing!", techset.data(), material.data());
@@ -25,6 +25,7 @@ namespace zonetool::h1
 		static void parse_constant_buffer_indexes(const std::string& techset, const std::string& material, unsigned char* indexes, zone_memory* mem);
 		static void parse_constant_buffer_def_array(const std::string& techset, const std::string& material, 
 			MaterialConstantBufferDef** def_ptr, unsigned char* count, zone_memory* mem);
+		static void clear_sidecar_cache();
 
 		void init(const std::string& name, zone_memory* mem) override;
 		void prepare(zone_buffer* buf, zone_memory* mem) override;
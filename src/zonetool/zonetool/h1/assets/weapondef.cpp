@@ -1,6 +1,10 @@
 #include "std_include.hpp"
 #include "weapondef.hpp"
 
+#include "zonetool/utils/json_fields.hpp"
+
+#include <utils/flags.hpp>
+
 namespace zonetool::h1
 {
 	const char* get_anim_name_from_index(weapAnimFiles_t index)
@@ -151,6 +155,414 @@ namespace zonetool::h1
 		weapon->__field__ = nullptr; \
 	}
 
+	namespace
+	{
+		const json_fields::field_table weapon_fields
+		{
+			JSON_FIELD(WeaponDef, altWeapon),
+			JSON_FIELD(WeaponDef, playerAnimType),
+			JSON_FIELD(WeaponDef, weapType),
+			JSON_FIELD(WeaponDef, weapClass),
+			JSON_FIELD(WeaponDef, penetrateType),
+			JSON_FIELD(WeaponDef, penetrateDepth),
+			JSON_FIELD(WeaponDef, impactType),
+			JSON_FIELD(WeaponDef, inventoryType),
+			JSON_FIELD(WeaponDef, fireType),
+			JSON_FIELD(WeaponDef, fireBarrels),
+			JSON_FIELD(WeaponDef, adsFireMode),
+			JSON_FIELD(WeaponDef, burstFireCooldown),
+			JSON_FIELD(WeaponDef, greebleType),
+			JSON_FIELD(WeaponDef, autoReloadType),
+			JSON_FIELD(WeaponDef, autoHolsterType),
+			JSON_FIELD(WeaponDef, offhandClass),
+			JSON_FIELD(WeaponDef, stance),
+			JSON_FIELD(WeaponDef, reticleCenterSize),
+			JSON_FIELD(WeaponDef, reticleSideSize),
+			JSON_FIELD(WeaponDef, reticleMinOfs),
+			JSON_FIELD(WeaponDef, activeReticleType),
+			JSON_FIELD_ARR(WeaponDef, standMove, 3),
+			JSON_FIELD_ARR(WeaponDef, standRot, 3),
+			JSON_FIELD_ARR(WeaponDef, strafeMove, 3),
+			JSON_FIELD_ARR(WeaponDef, strafeRot, 3),
+			JSON_FIELD_ARR(WeaponDef, duckedOfs, 3),
+			JSON_FIELD_ARR(WeaponDef, duckedMove, 3),
+			JSON_FIELD_ARR(WeaponDef, duckedRot, 3),
+			JSON_FIELD_ARR(WeaponDef, proneOfs, 3),
+			JSON_FIELD_ARR(WeaponDef, proneMove, 3),
+			JSON_FIELD_ARR(WeaponDef, proneRot, 3),
+			JSON_FIELD(WeaponDef, posMoveRate),
+			JSON_FIELD(WeaponDef, posProneMoveRate),
+			JSON_FIELD(WeaponDef, standMoveMinSpeed),
+			JSON_FIELD(WeaponDef, duckedMoveMinSpeed),
+			JSON_FIELD(WeaponDef, proneMoveMinSpeed),
+			JSON_FIELD(WeaponDef, posRotRate),
+			JSON_FIELD(WeaponDef, posProneRotRate),
+			JSON_FIELD(WeaponDef, hudIconRatio),
+			JSON_FIELD(WeaponDef, pickupIconRatio),
+			JSON_FIELD(WeaponDef, ammoCounterIconRatio),
+			JSON_FIELD(WeaponDef, ammoCounterClip),
+			JSON_FIELD(WeaponDef, startAmmo),
+			JSON_FIELD(WeaponDef, maxAmmo),
+			JSON_FIELD(WeaponDef, minAmmoReq),
+			JSON_FIELD(WeaponDef, clipSize),
+			JSON_FIELD(WeaponDef, shotCount),
+			JSON_FIELD(WeaponDef, sharedAmmoCap),
+			JSON_FIELD(WeaponDef, damage),
+			JSON_FIELD(WeaponDef, playerDamage),
+			JSON_FIELD(WeaponDef, meleeDamage),
+			JSON_FIELD(WeaponDef, damageType),
+			JSON_FIELD(WeaponDef, autoAimRange),
+			JSON_FIELD(WeaponDef, aimAssistRange),
+			JSON_FIELD(WeaponDef, aimAssistRangeAds),
+			JSON_FIELD(WeaponDef, aimPadding),
+			JSON_FIELD(WeaponDef, enemyCrosshairRange),
+			JSON_FIELD(WeaponDef, moveSpeedScale),
+			JSON_FIELD(WeaponDef, adsMoveSpeedScale),
+			JSON_FIELD(WeaponDef, sprintDurationScale),
+			JSON_FIELD(WeaponDef, adsZoomFov),
+			JSON_FIELD(WeaponDef, adsZoomInFrac),
+			JSON_FIELD(WeaponDef, adsZoomOutFrac),
+			JSON_FIELD(WeaponDef, adsSceneBlurStrength),
+			JSON_FIELD(WeaponDef, adsSceneBlurPhysicalScale),
+			JSON_FIELD(WeaponDef, adsBobFactor),
+			JSON_FIELD(WeaponDef, adsViewBobMult),
+			JSON_FIELD(WeaponDef, hipSpreadStandMin),
+			JSON_FIELD(WeaponDef, hipSpreadDuckedMin),
+			JSON_FIELD(WeaponDef, hipSpreadProneMin),
+			JSON_FIELD(WeaponDef, hipSpreadStandMax),
+			JSON_FIELD(WeaponDef, hipSpreadSprintMax),
+			JSON_FIELD(WeaponDef, hipSpreadSlideMax),
+			JSON_FIELD(WeaponDef, hipSpreadDuckedMax),
+			JSON_FIELD(WeaponDef, hipSpreadProneMax),
+			JSON_FIELD(WeaponDef, hipSpreadDecayRate),
+			JSON_FIELD(WeaponDef, hipSpreadFireAdd),
+			JSON_FIELD(WeaponDef, hipSpreadTurnAdd),
+			JSON_FIELD(WeaponDef, hipSpreadMoveAdd),
+			JSON_FIELD(WeaponDef, hipSpreadDuckedDecay),
+			JSON_FIELD(WeaponDef, hipSpreadProneDecay),
+			JSON_FIELD(WeaponDef, hipReticleSidePos),
+			JSON_FIELD(WeaponDef, adsIdleAmount),
+			JSON_FIELD(WeaponDef, hipIdleAmount),
+			JSON_FIELD(WeaponDef, adsIdleSpeed),
+			JSON_FIELD(WeaponDef, hipIdleSpeed),
+			JSON_FIELD(WeaponDef, idleCrouchFactor),
+			JSON_FIELD(WeaponDef, idleProneFactor),
+			JSON_FIELD(WeaponDef, gunMaxPitch),
+			JSON_FIELD(WeaponDef, gunMaxYaw),
+			JSON_FIELD(WeaponDef, adsIdleLerpStartTime),
+			JSON_FIELD(WeaponDef, adsIdleLerpTime),
+			JSON_FIELD(WeaponDef, adsTransInTime),
+			JSON_FIELD(WeaponDef, adsTransInFromSprintTime),
+			JSON_FIELD(WeaponDef, adsTransOutTime),
+			JSON_FIELD(WeaponDef, swayMaxAngleSteadyAim),
+			JSON_FIELD(WeaponDef, swayMaxAngle),
+			JSON_FIELD(WeaponDef, swayLerpSpeed),
+			JSON_FIELD(WeaponDef, swayPitchScale),
+			JSON_FIELD(WeaponDef, swayYawScale),
+			JSON_FIELD(WeaponDef, swayVertScale),
+			JSON_FIELD(WeaponDef, swayHorizScale),
+			JSON_FIELD(WeaponDef, swayShellShockScale),
+			JSON_FIELD(WeaponDef, adsSwayMaxAngle),
+			JSON_FIELD(WeaponDef, adsSwayLerpSpeed),
+			JSON_FIELD(WeaponDef, adsSwayPitchScale),
+			JSON_FIELD(WeaponDef, adsSwayYawScale),
+			JSON_FIELD(WeaponDef, adsSwayHorizScale),
+			JSON_FIELD(WeaponDef, adsSwayVertScale),
+			JSON_FIELD(WeaponDef, adsViewErrorMin),
+			JSON_FIELD(WeaponDef, adsViewErrorMax),
+			JSON_FIELD(WeaponDef, adsFireAnimFrac),
+			JSON_FIELD(WeaponDef, dualWieldViewModelOffset),
+			JSON_FIELD(WeaponDef, scopeDriftDelay),
+			JSON_FIELD(WeaponDef, scopeDriftLerpInTime),
+			JSON_FIELD(WeaponDef, scopeDriftSteadyTime),
+			JSON_FIELD(WeaponDef, scopeDriftLerpOutTime),
+			JSON_FIELD(WeaponDef, scopeDriftSteadyFactor),
+			JSON_FIELD(WeaponDef, scopeDriftUnsteadyFactor),
+			JSON_FIELD(WeaponDef, bobVerticalFactor),
+			JSON_FIELD(WeaponDef, bobHorizontalFactor),
+			JSON_FIELD(WeaponDef, bobViewVerticalFactor),
+			JSON_FIELD(WeaponDef, bobViewHorizontalFactor),
+			JSON_FIELD(WeaponDef, stationaryZoomFov),
+			JSON_FIELD(WeaponDef, stationaryZoomDelay),
+			JSON_FIELD(WeaponDef, stationaryZoomLerpInTime),
+			JSON_FIELD(WeaponDef, stationaryZoomLerpOutTime),
+			JSON_FIELD(WeaponDef, adsDofStart),
+			JSON_FIELD(WeaponDef, adsDofEnd),
+			JSON_FIELD(WeaponDef, killIconRatio),
+			JSON_FIELD(WeaponDef, dpadIconRatio),
+			JSON_FIELD(WeaponDef, fireAnimLength),
+			JSON_FIELD(WeaponDef, fireAnimLengthAkimbo),
+			JSON_FIELD(WeaponDef, inspectAnimTime),
+			JSON_FIELD(WeaponDef, reloadAmmoAdd),
+			JSON_FIELD(WeaponDef, reloadStartAdd),
+			JSON_FIELD(WeaponDef, ammoDropStockMin),
+			JSON_FIELD(WeaponDef, ammoDropStockMax),
+			JSON_FIELD(WeaponDef, ammoDropClipPercentMin),
+			JSON_FIELD(WeaponDef, ammoDropClipPercentMax),
+			JSON_FIELD(WeaponDef, explosionRadius),
+			JSON_FIELD(WeaponDef, explosionRadiusMin),
+			JSON_FIELD(WeaponDef, explosionInnerDamage),
+			JSON_FIELD(WeaponDef, explosionOuterDamage),
+			JSON_FIELD(WeaponDef, damageConeAngle),
+			JSON_FIELD(WeaponDef, bulletExplDmgMult),
+			JSON_FIELD(WeaponDef, bulletExplRadiusMult),
+			JSON_FIELD(WeaponDef, projectileSpeed),
+			JSON_FIELD(WeaponDef, projectileSpeedUp),
+			JSON_FIELD(WeaponDef, projectileSpeedForward),
+			JSON_FIELD(WeaponDef, projectileActivateDist),
+			JSON_FIELD(WeaponDef, projLifetime),
+			JSON_FIELD(WeaponDef, timeToAccelerate),
+			JSON_FIELD(WeaponDef, projectileCurvature),
+			JSON_FIELD(WeaponDef, projExplosion),
+			JSON_FIELD(WeaponDef, stickiness),
+			JSON_FIELD(WeaponDef, lowAmmoWarningThreshold),
+			JSON_FIELD(WeaponDef, ricochetChance),
+			JSON_FIELD(WeaponDef, riotShieldHealth),
+			JSON_FIELD(WeaponDef, riotShieldDamageMult),
+			JSON_FIELD_ARR(WeaponDef, projectileColor, 3),
+			JSON_FIELD(WeaponDef, guidedMissileType),
+			JSON_FIELD(WeaponDef, maxSteeringAccel),
+			JSON_FIELD(WeaponDef, projIgnitionDelay),
+			JSON_FIELD(WeaponDef, adsAimPitch),
+			JSON_FIELD(WeaponDef, adsCrosshairInFrac),
+			JSON_FIELD(WeaponDef, adsCrosshairOutFrac),
+			JSON_FIELD(WeaponDef, adsGunKickReducedKickBullets),
+			JSON_FIELD(WeaponDef, adsGunKickReducedKickPercent),
+			JSON_FIELD(WeaponDef, adsGunKickPitchMin),
+			JSON_FIELD(WeaponDef, adsGunKickPitchMax),
+			JSON_FIELD(WeaponDef, adsGunKickYawMin),
+			JSON_FIELD(WeaponDef, adsGunKickYawMax),
+			JSON_FIELD(WeaponDef, adsGunKickMagMin),
+			JSON_FIELD(WeaponDef, adsGunKickAccel),
+			JSON_FIELD(WeaponDef, adsGunKickSpeedMax),
+			JSON_FIELD(WeaponDef, adsGunKickSpeedDecay),
+			JSON_FIELD(WeaponDef, adsGunKickStaticDecay),
+			JSON_FIELD(WeaponDef, adsViewKickPitchMin),
+			JSON_FIELD(WeaponDef, adsViewKickPitchMax),
+			JSON_FIELD(WeaponDef, adsViewKickYawMin),
+			JSON_FIELD(WeaponDef, adsViewKickYawMax),
+			JSON_FIELD(WeaponDef, adsViewKickMagMin),
+			JSON_FIELD(WeaponDef, adsViewKickCenterSpeed),
+			JSON_FIELD(WeaponDef, adsViewScatterMin),
+			JSON_FIELD(WeaponDef, adsViewScatterMax),
+			JSON_FIELD(WeaponDef, adsSpread),
+			JSON_FIELD(WeaponDef, hipGunKickReducedKickBullets),
+			JSON_FIELD(WeaponDef, hipGunKickReducedKickPercent),
+			JSON_FIELD(WeaponDef, hipGunKickPitchMin),
+			JSON_FIELD(WeaponDef, hipGunKickPitchMax),
+			JSON_FIELD(WeaponDef, hipGunKickYawMin),
+			JSON_FIELD(WeaponDef, hipGunKickYawMax),
+			JSON_FIELD(WeaponDef, hipGunKickMagMin),
+			JSON_FIELD(WeaponDef, hipGunKickAccel),
+			JSON_FIELD(WeaponDef, hipGunKickSpeedMax),
+			JSON_FIELD(WeaponDef, hipGunKickSpeedDecay),
+			JSON_FIELD(WeaponDef, hipGunKickStaticDecay),
+			JSON_FIELD(WeaponDef, hipViewKickPitchMin),
+			JSON_FIELD(WeaponDef, hipViewKickPitchMax),
+			JSON_FIELD(WeaponDef, hipViewKickYawMin),
+			JSON_FIELD(WeaponDef, hipViewKickYawMax),
+			JSON_FIELD(WeaponDef, hipViewKickMagMin),
+			JSON_FIELD(WeaponDef, hipViewKickCenterSpeed),
+			JSON_FIELD(WeaponDef, hipViewScatterMin),
+			JSON_FIELD(WeaponDef, hipViewScatterMax),
+			JSON_FIELD(WeaponDef, viewKickScale),
+			JSON_FIELD(WeaponDef, positionReloadTransTime),
+			JSON_FIELD(WeaponDef, fightDist),
+			JSON_FIELD(WeaponDef, maxDist),
+			JSON_FIELD(WeaponDef, leftArc),
+			JSON_FIELD(WeaponDef, rightArc),
+			JSON_FIELD(WeaponDef, topArc),
+			JSON_FIELD(WeaponDef, bottomArc),
+			JSON_FIELD(WeaponDef, accuracy),
+			JSON_FIELD(WeaponDef, aiSpread),
+			JSON_FIELD(WeaponDef, playerSpread),
+			JSON_FIELD_ARR(WeaponDef, minTurnSpeed, 2),
+			JSON_FIELD_ARR(WeaponDef, maxTurnSpeed, 2),
+			JSON_FIELD(WeaponDef, pitchConvergenceTime),
+			JSON_FIELD(WeaponDef, yawConvergenceTime),
+			JSON_FIELD(WeaponDef, suppressTime),
+			JSON_FIELD(WeaponDef, maxRange),
+			JSON_FIELD(WeaponDef, animHorRotateInc),
+			JSON_FIELD(WeaponDef, playerPositionDist),
+			JSON_FIELD(WeaponDef, horizViewJitter),
+			JSON_FIELD(WeaponDef, vertViewJitter),
+			JSON_FIELD(WeaponDef, scanSpeed),
+			JSON_FIELD(WeaponDef, scanAccel),
+			JSON_FIELD(WeaponDef, scanPauseTime),
+			JSON_FIELD(WeaponDef, minDamage),
+			JSON_FIELD(WeaponDef, midDamage),
+			JSON_FIELD(WeaponDef, minPlayerDamage),
+			JSON_FIELD(WeaponDef, midPlayerDamage),
+			JSON_FIELD(WeaponDef, maxDamageRange),
+			JSON_FIELD(WeaponDef, minDamageRange),
+			JSON_FIELD(WeaponDef, signatureAmmoInClip),
+			JSON_FIELD(WeaponDef, signatureDamage),
+			JSON_FIELD(WeaponDef, signatureMidDamage),
+			JSON_FIELD(WeaponDef, signatureMinDamage),
+			JSON_FIELD(WeaponDef, signatureMaxDamageRange),
+			JSON_FIELD(WeaponDef, signatureMinDamageRange),
+			JSON_FIELD(WeaponDef, destabilizationRateTime),
+			JSON_FIELD(WeaponDef, destabilizationCurvatureMax),
+			JSON_FIELD(WeaponDef, destabilizeDistance),
+			JSON_FIELD(WeaponDef, turretADSTime),
+			JSON_FIELD(WeaponDef, turretFov),
+			JSON_FIELD(WeaponDef, turretFovADS),
+			JSON_FIELD(WeaponDef, turretScopeZoomRate),
+			JSON_FIELD(WeaponDef, turretScopeZoomMin),
+			JSON_FIELD(WeaponDef, turretScopeZoomMax),
+			JSON_FIELD(WeaponDef, overheatUpRate),
+			JSON_FIELD(WeaponDef, overheatDownRate),
+			JSON_FIELD(WeaponDef, overheatCooldownRate),
+			JSON_FIELD(WeaponDef, overheatPenalty),
+			JSON_FIELD(WeaponDef, turretBarrelSpinSpeed),
+			JSON_FIELD(WeaponDef, turretBarrelSpinUpTime),
+			JSON_FIELD(WeaponDef, turretBarrelSpinDownTime),
+			JSON_FIELD(WeaponDef, missileConeSoundRadiusAtTop),
+			JSON_FIELD(WeaponDef, missileConeSoundRadiusAtBase),
+			JSON_FIELD(WeaponDef, missileConeSoundHeight),
+			JSON_FIELD(WeaponDef, missileConeSoundOriginOffset),
+			JSON_FIELD(WeaponDef, missileConeSoundVolumescaleAtCore),
+			JSON_FIELD(WeaponDef, missileConeSoundVolumescaleAtEdge),
+			JSON_FIELD(WeaponDef, missileConeSoundVolumescaleCoreSize),
+			JSON_FIELD(WeaponDef, missileConeSoundPitchAtTop),
+			JSON_FIELD(WeaponDef, missileConeSoundPitchAtBottom),
+			JSON_FIELD(WeaponDef, missileConeSoundPitchTopSize),
+			JSON_FIELD(WeaponDef, missileConeSoundPitchBottomSize),
+			JSON_FIELD(WeaponDef, missileConeSoundCrossfadeTopSize),
+			JSON_FIELD(WeaponDef, missileConeSoundCrossfadeBottomSize),
+			JSON_FIELD(WeaponDef, aim_automelee_lerp),
+			JSON_FIELD(WeaponDef, aim_automelee_range),
+			JSON_FIELD(WeaponDef, aim_automelee_region_height),
+			JSON_FIELD(WeaponDef, aim_automelee_region_width),
+			JSON_FIELD(WeaponDef, player_meleeHeight),
+			JSON_FIELD(WeaponDef, player_meleeRange),
+			JSON_FIELD(WeaponDef, player_meleeWidth),
+			JSON_FIELD(WeaponDef, changedFireTime),
+			JSON_FIELD(WeaponDef, changedFireTimeNumBullets),
+			JSON_FIELD(WeaponDef, fireTimeInterpolationType),
+			JSON_FIELD(WeaponDef, generateAmmo),
+			JSON_FIELD(WeaponDef, ammoPerShot),
+			JSON_FIELD(WeaponDef, explodeCount),
+			JSON_FIELD(WeaponDef, batteryDischargeRate),
+			JSON_FIELD(WeaponDef, extendedBattery),
+			JSON_FIELD(WeaponDef, iU_079),
+			JSON_FIELD(WeaponDef, iU_080),
+			JSON_FIELD(WeaponDef, rattleSoundType),
+			JSON_FIELD(WeaponDef, adsShouldShowCrosshair),
+			JSON_FIELD(WeaponDef, adsCrosshairShouldScale),
+			JSON_FIELD(WeaponDef, turretADSEnabled),
+			JSON_FIELD(WeaponDef, knifeAttachTagLeft),
+			JSON_FIELD(WeaponDef, knifeAlwaysAttached),
+			JSON_FIELD(WeaponDef, meleeOverrideValues),
+			JSON_FIELD(WeaponDef, riotShieldEnableDamage),
+			JSON_FIELD(WeaponDef, allowPrimaryWeaponPickup),
+			JSON_FIELD(WeaponDef, sharedAmmo),
+			JSON_FIELD(WeaponDef, lockonSupported),
+			JSON_FIELD(WeaponDef, requireLockonToFire),
+			JSON_FIELD(WeaponDef, isAirburstWeapon),
+			JSON_FIELD(WeaponDef, bigExplosion),
+			JSON_FIELD(WeaponDef, noAdsWhenMagEmpty),
+			JSON_FIELD(WeaponDef, avoidDropCleanup),
+			JSON_FIELD(WeaponDef, inheritsPerks),
+			JSON_FIELD(WeaponDef, crosshairColorChange),
+			JSON_FIELD(WeaponDef, rifleBullet),
+			JSON_FIELD(WeaponDef, armorPiercing),
+			JSON_FIELD(WeaponDef, boltAction),
+			JSON_FIELD(WeaponDef, aimDownSight),
+			JSON_FIELD(WeaponDef, canHoldBreath),
+			JSON_FIELD(WeaponDef, meleeOnly),
+			JSON_FIELD(WeaponDef, bU_085),
+			JSON_FIELD(WeaponDef, bU_086),
+			JSON_FIELD(WeaponDef, canVariableZoom),
+			JSON_FIELD(WeaponDef, rechamberWhileAds),
+			JSON_FIELD(WeaponDef, bulletExplosiveDamage),
+			JSON_FIELD(WeaponDef, cookOffHold),
+			JSON_FIELD(WeaponDef, useBattery),
+			JSON_FIELD(WeaponDef, reticleSpin45),
+			JSON_FIELD(WeaponDef, clipOnly),
+			JSON_FIELD(WeaponDef, noAmmoPickup),
+			JSON_FIELD(WeaponDef, disableSwitchToWhenEmpty),
+			JSON_FIELD(WeaponDef, suppressAmmoReserveDisplay),
+			JSON_FIELD(WeaponDef, motionTracker),
+			JSON_FIELD(WeaponDef, markableViewmodel),
+			JSON_FIELD(WeaponDef, noDualWield),
+			JSON_FIELD(WeaponDef, flipKillIcon),
+			JSON_FIELD(WeaponDef, actionSlotShowAmmo),
+			JSON_FIELD(WeaponDef, noPartialReload),
+			JSON_FIELD(WeaponDef, segmentedReload),
+			JSON_FIELD(WeaponDef, multipleReload),
+			JSON_FIELD(WeaponDef, blocksProne),
+			JSON_FIELD(WeaponDef, silenced),
+			JSON_FIELD(WeaponDef, isRollingGrenade),
+			JSON_FIELD(WeaponDef, projExplosionEffectForceNormalUp),
+			JSON_FIELD(WeaponDef, projExplosionEffectInheritParentDirection),
+			JSON_FIELD(WeaponDef, projImpactExplode),
+			JSON_FIELD(WeaponDef, projTrajectoryEvents),
+			JSON_FIELD(WeaponDef, projWhizByEnabled),
+			JSON_FIELD(WeaponDef, stickToPlayers),
+			JSON_FIELD(WeaponDef, stickToVehicles),
+			JSON_FIELD(WeaponDef, stickToTurrets),
+			JSON_FIELD(WeaponDef, thrownSideways),
+			JSON_FIELD(WeaponDef, hasDetonatorEmptyThrow),
+			JSON_FIELD(WeaponDef, hasDetonatorDoubleTap),
+			JSON_FIELD(WeaponDef, disableFiring),
+			JSON_FIELD(WeaponDef, timedDetonation),
+			JSON_FIELD(WeaponDef, noCrumpleMissile),
+			JSON_FIELD(WeaponDef, fuseLitAfterImpact),
+			JSON_FIELD(WeaponDef, rotate),
+			JSON_FIELD(WeaponDef, holdButtonToThrow),
+			JSON_FIELD(WeaponDef, freezeMovementWhenFiring),
+			JSON_FIELD(WeaponDef, thermalScope),
+			JSON_FIELD(WeaponDef, thermalToggle),
+			JSON_FIELD(WeaponDef, outlineEnemies),
+			JSON_FIELD(WeaponDef, altModeSameWeapon),
+			JSON_FIELD(WeaponDef, turretBarrelSpinEnabled),
+			JSON_FIELD(WeaponDef, missileConeSoundEnabled),
+			JSON_FIELD(WeaponDef, missileConeSoundPitchshiftEnabled),
+			JSON_FIELD(WeaponDef, missileConeSoundCrossfadeEnabled),
+			JSON_FIELD(WeaponDef, offhandHoldIsCancelable),
+			JSON_FIELD(WeaponDef, doNotAllowAttachmentsToOverrideSpread),
+			JSON_FIELD(WeaponDef, useFastReloadAnims),
+			JSON_FIELD(WeaponDef, dualMagReloadSupported),
+			JSON_FIELD(WeaponDef, reloadStopsAlt),
+			JSON_FIELD(WeaponDef, useScopeDrift),
+			JSON_FIELD(WeaponDef, alwaysShatterGlassOnImpact),
+			JSON_FIELD(WeaponDef, oldWeapon),
+			JSON_FIELD(WeaponDef, raiseToHold),
+			JSON_FIELD(WeaponDef, notifyOnPlayerImpact),
+			JSON_FIELD(WeaponDef, decreasingKick),
+			JSON_FIELD(WeaponDef, counterSilencer),
+			JSON_FIELD(WeaponDef, projSuppressedByEMP),
+			JSON_FIELD(WeaponDef, projDisabledByEMP),
+			JSON_FIELD(WeaponDef, autosimDisableVariableRate),
+			JSON_FIELD(WeaponDef, projPlayTrailEffectForOwnerOnly),
+			JSON_FIELD(WeaponDef, projPlayBeaconEffectForOwnerOnly),
+			JSON_FIELD(WeaponDef, projKillTrailEffectOnDeath),
+			JSON_FIELD(WeaponDef, projKillBeaconEffectOnDeath),
+			JSON_FIELD(WeaponDef, reticleDetonateHide),
+			JSON_FIELD(WeaponDef, cloaked),
+			JSON_FIELD(WeaponDef, adsHideWeapon),
+			JSON_FIELD(WeaponDef, adsHideHands),
+			JSON_FIELD(WeaponDef, bU_108),
+			JSON_FIELD(WeaponDef, adsSceneBlur),
+			JSON_FIELD(WeaponDef, usesSniperScope),
+			JSON_FIELD(WeaponDef, hasTransientModels),
+			JSON_FIELD(WeaponDef, bU_112),
+			JSON_FIELD(WeaponDef, bU_113),
+			JSON_FIELD(WeaponDef, bU_114),
+			JSON_FIELD(WeaponDef, bU_115),
+			JSON_FIELD(WeaponDef, adsDofPhysicalFstop),
+			JSON_FIELD(WeaponDef, adsDofPhysicalFocusDistance),
+			JSON_FIELD(WeaponDef, autosimSpeedScale),
+			JSON_FIELD(WeaponDef, reactiveMotionRadiusScale),
+			JSON_FIELD(WeaponDef, reactiveMotionFrequencyScale),
+			JSON_FIELD(WeaponDef, reactiveMotionAmplitudeScale),
+			JSON_FIELD(WeaponDef, reactiveMotionFalloff),
+			JSON_FIELD(WeaponDef, reactiveMotionLifetime),
+			JSON_FIELD_ARR(WeaponDef, fU_3604, 3),
+		};
+	}
+
 	void parse_overlay(ADSOverlay* weapon, json& data)
 	{
 		WEAPON_READ_ASSET(ASSET_TYPE_MATERIAL, material, shader);
@@ -245,7 +657,7 @@ namespace zonetool::h1
 			}
 		}
 	}
-	
+
 	void parse_statetimers(StateTimers* weapon, json& data)
 	{
 		WEAPON_READ_FIELD(int, fireDelay);
@@ -324,7 +736,7 @@ namespace zonetool::h1
 		WEAPON_READ_FIELD(int, overheatOutTime);
 		WEAPON_READ_FIELD(int, overheatOutReadyTime);
 	}
-
+	
 	WeaponDef* weapon_def::parse(const std::string& name, zone_memory* mem)
 	{
 		const auto path = "weapons\\"s + name + ".json"s;
@@ -342,9 +754,12 @@ namespace zonetool::h1
 		auto size = file.size();
 		auto bytes = file.read_bytes(size);
 		file.close();
-		json data = json::parse(bytes);
 
+		// plain fields stream straight into the weapon, the rest of the document is read below
 		auto* weapon = mem->allocate<WeaponDef>();
+		json data = utils::flags::has_flag("weapon_cache")
+			? json_fields::parse_cached(bytes, weapon_fields, weapon, sizeof(WeaponDef), "zonetool\\_cache\\h1\\weapons\\"s + name + ".bin"s)
+			: json_fields::parse(bytes, weapon_fields, weapon);
 
 		WEAPON_READ_STRING(szInternalName);
 		WEAPON_READ_STRING(szDisplayName);
@@ -750,418 +1165,16 @@ namespace zonetool::h1
 			this->add_script_string(&weapon->stowTag, mem->duplicate_string(stowTag));
 		}
 
-		WEAPON_READ_FIELD(int, altWeapon);
-		WEAPON_READ_FIELD(playerAnimType_t, playerAnimType);
-		WEAPON_READ_FIELD(weapType_t, weapType);
-		WEAPON_READ_FIELD(weapClass_t, weapClass);
-		WEAPON_READ_FIELD(PenetrateType, penetrateType);
-		WEAPON_READ_FIELD(float, penetrateDepth);
-		WEAPON_READ_FIELD(ImpactType, impactType);
-		WEAPON_READ_FIELD(weapInventoryType_t, inventoryType);
-		WEAPON_READ_FIELD(weapFireType_t, fireType);
-		WEAPON_READ_FIELD(weapFireBarrels_t, fireBarrels);
-		WEAPON_READ_FIELD(weapAdsFireMode_t, adsFireMode);
-		WEAPON_READ_FIELD(float, burstFireCooldown);
-		WEAPON_READ_FIELD(weapGreebleType_t, greebleType);
-		WEAPON_READ_FIELD(weapAutoReloadType_t, autoReloadType);
-		WEAPON_READ_FIELD(weapAutoHolsterType_t, autoHolsterType);
-		WEAPON_READ_FIELD(OffhandClass, offhandClass);
-		WEAPON_READ_FIELD(weapStance_t, stance);
-		WEAPON_READ_FIELD(int, reticleCenterSize);
-		WEAPON_READ_FIELD(int, reticleSideSize);
-		WEAPON_READ_FIELD(int, reticleMinOfs);
-		WEAPON_READ_FIELD(activeReticleType_t, activeReticleType);
-		WEAPON_READ_FIELD_ARR(float, standMove, 3);
-		WEAPON_READ_FIELD_ARR(float, standRot, 3);
-		WEAPON_READ_FIELD_ARR(float, strafeMove, 3);
-		WEAPON_READ_FIELD_ARR(float, strafeRot, 3);
-		WEAPON_READ_FIELD_ARR(float, duckedOfs, 3);
-		WEAPON_READ_FIELD_ARR(float, duckedMove, 3);
-		WEAPON_READ_FIELD_ARR(float, duckedRot, 3);
-		WEAPON_READ_FIELD_ARR(float, proneOfs, 3);
-		WEAPON_READ_FIELD_ARR(float, proneMove, 3);
-		WEAPON_READ_FIELD_ARR(float, proneRot, 3);
-		WEAPON_READ_FIELD(float, posMoveRate);
-		WEAPON_READ_FIELD(float, posProneMoveRate);
-		WEAPON_READ_FIELD(float, standMoveMinSpeed);
-		WEAPON_READ_FIELD(float, duckedMoveMinSpeed);
-		WEAPON_READ_FIELD(float, proneMoveMinSpeed);
-		WEAPON_READ_FIELD(float, posRotRate);
-		WEAPON_READ_FIELD(float, posProneRotRate);
-		WEAPON_READ_FIELD(weaponIconRatioType_t, hudIconRatio);
-		WEAPON_READ_FIELD(weaponIconRatioType_t, pickupIconRatio);
-		WEAPON_READ_FIELD(weaponIconRatioType_t, ammoCounterIconRatio);
-		WEAPON_READ_FIELD(int, ammoCounterClip);
-		WEAPON_READ_FIELD(int, startAmmo);
 		//WEAPON_READ_FIELD(int, ammoIndex); // runtime
 		//WEAPON_READ_FIELD(int, clipIndex); // runtime
-		WEAPON_READ_FIELD(int, maxAmmo);
-		WEAPON_READ_FIELD(int, minAmmoReq);
-		WEAPON_READ_FIELD(int, clipSize);
-		WEAPON_READ_FIELD(int, shotCount);
 		//WEAPON_READ_FIELD(int, sharedAmmoCapIndex); // runtime
-		WEAPON_READ_FIELD(int, sharedAmmoCap);
-		WEAPON_READ_FIELD(int, damage);
-		WEAPON_READ_FIELD(int, playerDamage);
-		WEAPON_READ_FIELD(int, meleeDamage);
-		WEAPON_READ_FIELD(int, damageType);
-		WEAPON_READ_FIELD(float, autoAimRange);
-		WEAPON_READ_FIELD(float, aimAssistRange);
-		WEAPON_READ_FIELD(float, aimAssistRangeAds);
-		WEAPON_READ_FIELD(float, aimPadding);
-		WEAPON_READ_FIELD(float, enemyCrosshairRange);
-		WEAPON_READ_FIELD(float, moveSpeedScale);
-		WEAPON_READ_FIELD(float, adsMoveSpeedScale);
-		WEAPON_READ_FIELD(float, sprintDurationScale);
-		WEAPON_READ_FIELD(float, adsZoomFov);
-		WEAPON_READ_FIELD(float, adsZoomInFrac);
-		WEAPON_READ_FIELD(float, adsZoomOutFrac);
-		WEAPON_READ_FIELD(float, adsSceneBlurStrength);
-		WEAPON_READ_FIELD(float, adsSceneBlurPhysicalScale);
 		//WEAPON_READ_FIELD(float, pad3);
-		WEAPON_READ_FIELD(float, adsBobFactor);
-		WEAPON_READ_FIELD(float, adsViewBobMult);
-		WEAPON_READ_FIELD(float, hipSpreadStandMin);
-		WEAPON_READ_FIELD(float, hipSpreadDuckedMin);
-		WEAPON_READ_FIELD(float, hipSpreadProneMin);
-		WEAPON_READ_FIELD(float, hipSpreadStandMax);
-		WEAPON_READ_FIELD(float, hipSpreadSprintMax);
-		WEAPON_READ_FIELD(float, hipSpreadSlideMax);
-		WEAPON_READ_FIELD(float, hipSpreadDuckedMax);
-		WEAPON_READ_FIELD(float, hipSpreadProneMax);
-		WEAPON_READ_FIELD(float, hipSpreadDecayRate);
-		WEAPON_READ_FIELD(float, hipSpreadFireAdd);
-		WEAPON_READ_FIELD(float, hipSpreadTurnAdd);
-		WEAPON_READ_FIELD(float, hipSpreadMoveAdd);
-		WEAPON_READ_FIELD(float, hipSpreadDuckedDecay);
-		WEAPON_READ_FIELD(float, hipSpreadProneDecay);
-		WEAPON_READ_FIELD(float, hipReticleSidePos);
-		WEAPON_READ_FIELD(float, adsIdleAmount);
-		WEAPON_READ_FIELD(float, hipIdleAmount);
-		WEAPON_READ_FIELD(float, adsIdleSpeed);
-		WEAPON_READ_FIELD(float, hipIdleSpeed);
-		WEAPON_READ_FIELD(float, idleCrouchFactor);
-		WEAPON_READ_FIELD(float, idleProneFactor);
-		WEAPON_READ_FIELD(float, gunMaxPitch);
-		WEAPON_READ_FIELD(float, gunMaxYaw);
-		WEAPON_READ_FIELD(float, adsIdleLerpStartTime);
-		WEAPON_READ_FIELD(float, adsIdleLerpTime);
-		WEAPON_READ_FIELD(int, adsTransInTime);
-		WEAPON_READ_FIELD(int, adsTransInFromSprintTime);
-		WEAPON_READ_FIELD(int, adsTransOutTime);
-		WEAPON_READ_FIELD(int, swayMaxAngleSteadyAim);
-		WEAPON_READ_FIELD(float, swayMaxAngle);
-		WEAPON_READ_FIELD(float, swayLerpSpeed);
-		WEAPON_READ_FIELD(float, swayPitchScale);
-		WEAPON_READ_FIELD(float, swayYawScale);
-		WEAPON_READ_FIELD(float, swayVertScale);
-		WEAPON_READ_FIELD(float, swayHorizScale);
-		WEAPON_READ_FIELD(float, swayShellShockScale);
-		WEAPON_READ_FIELD(float, adsSwayMaxAngle);
-		WEAPON_READ_FIELD(float, adsSwayLerpSpeed);
-		WEAPON_READ_FIELD(float, adsSwayPitchScale);
-		WEAPON_READ_FIELD(float, adsSwayYawScale);
-		WEAPON_READ_FIELD(float, adsSwayHorizScale);
-		WEAPON_READ_FIELD(float, adsSwayVertScale);
-		WEAPON_READ_FIELD(float, adsViewErrorMin);
-		WEAPON_READ_FIELD(float, adsViewErrorMax);
-		WEAPON_READ_FIELD(float, adsFireAnimFrac);
-		WEAPON_READ_FIELD(float, dualWieldViewModelOffset);
-		WEAPON_READ_FIELD(float, scopeDriftDelay);
-		WEAPON_READ_FIELD(float, scopeDriftLerpInTime);
-		WEAPON_READ_FIELD(float, scopeDriftSteadyTime);
-		WEAPON_READ_FIELD(float, scopeDriftLerpOutTime);
-		WEAPON_READ_FIELD(float, scopeDriftSteadyFactor);
-		WEAPON_READ_FIELD(float, scopeDriftUnsteadyFactor);
-		WEAPON_READ_FIELD(float, bobVerticalFactor);
-		WEAPON_READ_FIELD(float, bobHorizontalFactor);
-		WEAPON_READ_FIELD(float, bobViewVerticalFactor);
-		WEAPON_READ_FIELD(float, bobViewHorizontalFactor);
-		WEAPON_READ_FIELD(float, stationaryZoomFov);
-		WEAPON_READ_FIELD(float, stationaryZoomDelay);
-		WEAPON_READ_FIELD(float, stationaryZoomLerpInTime);
-		WEAPON_READ_FIELD(float, stationaryZoomLerpOutTime);
-		WEAPON_READ_FIELD(float, adsDofStart);
-		WEAPON_READ_FIELD(float, adsDofEnd);
 		//WEAPON_READ_FIELD(float, pad1);
-		WEAPON_READ_FIELD(weaponIconRatioType_t, killIconRatio);
-		WEAPON_READ_FIELD(weaponIconRatioType_t, dpadIconRatio);
-		WEAPON_READ_FIELD(int, fireAnimLength);
-		WEAPON_READ_FIELD(int, fireAnimLengthAkimbo);
-		WEAPON_READ_FIELD(int, inspectAnimTime);
-		WEAPON_READ_FIELD(int, reloadAmmoAdd);
-		WEAPON_READ_FIELD(int, reloadStartAdd);
-		WEAPON_READ_FIELD(int, ammoDropStockMin);
-		WEAPON_READ_FIELD(int, ammoDropStockMax);
-		WEAPON_READ_FIELD(int, ammoDropClipPercentMin);
-		WEAPON_READ_FIELD(int, ammoDropClipPercentMax);
-		WEAPON_READ_FIELD(int, explosionRadius);
-		WEAPON_READ_FIELD(int, explosionRadiusMin);
-		WEAPON_READ_FIELD(int, explosionInnerDamage);
-		WEAPON_READ_FIELD(int, explosionOuterDamage);
-		WEAPON_READ_FIELD(float, damageConeAngle);
-		WEAPON_READ_FIELD(float, bulletExplDmgMult);
-		WEAPON_READ_FIELD(float, bulletExplRadiusMult);
-		WEAPON_READ_FIELD(int, projectileSpeed);
-		WEAPON_READ_FIELD(int, projectileSpeedUp);
-		WEAPON_READ_FIELD(int, projectileSpeedForward);
-		WEAPON_READ_FIELD(int, projectileActivateDist);
-		WEAPON_READ_FIELD(float, projLifetime);
-		WEAPON_READ_FIELD(float, timeToAccelerate);
-		WEAPON_READ_FIELD(float, projectileCurvature);
 		//WEAPON_READ_FIELD(float, pad2);
-		WEAPON_READ_FIELD(weapProjExposion_t, projExplosion);
-		WEAPON_READ_FIELD(WeapStickinessType, stickiness);
-		WEAPON_READ_FIELD(float, lowAmmoWarningThreshold);
-		WEAPON_READ_FIELD(float, ricochetChance);
-		WEAPON_READ_FIELD(int, riotShieldHealth);
-		WEAPON_READ_FIELD(float, riotShieldDamageMult);
 		WEAPON_READ_FIELD_ARR(float, parallelBounce, 53);
 		WEAPON_READ_FIELD_ARR(float, perpendicularBounce, 53);
-		WEAPON_READ_FIELD_ARR(float, projectileColor, 3);
-		WEAPON_READ_FIELD(guidedMissileType_t, guidedMissileType);
-		WEAPON_READ_FIELD(float, maxSteeringAccel);
-		WEAPON_READ_FIELD(int, projIgnitionDelay);
-		WEAPON_READ_FIELD(float, adsAimPitch);
-		WEAPON_READ_FIELD(float, adsCrosshairInFrac);
-		WEAPON_READ_FIELD(float, adsCrosshairOutFrac);
-		WEAPON_READ_FIELD(int, adsGunKickReducedKickBullets);
-		WEAPON_READ_FIELD(float, adsGunKickReducedKickPercent);
-		WEAPON_READ_FIELD(float, adsGunKickPitchMin);
-		WEAPON_READ_FIELD(float, adsGunKickPitchMax);
-		WEAPON_READ_FIELD(float, adsGunKickYawMin);
-		WEAPON_READ_FIELD(float, adsGunKickYawMax);
-		WEAPON_READ_FIELD(float, adsGunKickMagMin);
-		WEAPON_READ_FIELD(float, adsGunKickAccel);
-		WEAPON_READ_FIELD(float, adsGunKickSpeedMax);
-		WEAPON_READ_FIELD(float, adsGunKickSpeedDecay);
-		WEAPON_READ_FIELD(float, adsGunKickStaticDecay);
-		WEAPON_READ_FIELD(float, adsViewKickPitchMin);
-		WEAPON_READ_FIELD(float, adsViewKickPitchMax);
-		WEAPON_READ_FIELD(float, adsViewKickYawMin);
-		WEAPON_READ_FIELD(float, adsViewKickYawMax);
-		WEAPON_READ_FIELD(float, adsViewKickMagMin);
-		WEAPON_READ_FIELD(float, adsViewKickCenterSpeed);
-		WEAPON_READ_FIELD(float, adsViewScatterMin);
-		WEAPON_READ_FIELD(float, adsViewScatterMax);
-		WEAPON_READ_FIELD(float, adsSpread);
-		WEAPON_READ_FIELD(int, hipGunKickReducedKickBullets);
-		WEAPON_READ_FIELD(float, hipGunKickReducedKickPercent);
-		WEAPON_READ_FIELD(float, hipGunKickPitchMin);
-		WEAPON_READ_FIELD(float, hipGunKickPitchMax);
-		WEAPON_READ_FIELD(float, hipGunKickYawMin);
-		WEAPON_READ_FIELD(float, hipGunKickYawMax);
-		WEAPON_READ_FIELD(float, hipGunKickMagMin);
-		WEAPON_READ_FIELD(float, hipGunKickAccel);
-		WEAPON_READ_FIELD(float, hipGunKickSpeedMax);
-		WEAPON_READ_FIELD(float, hipGunKickSpeedDecay);
-		WEAPON_READ_FIELD(float, hipGunKickStaticDecay);
-		WEAPON_READ_FIELD(float, hipViewKickPitchMin);
-		WEAPON_READ_FIELD(float, hipViewKickPitchMax);
-		WEAPON_READ_FIELD(float, hipViewKickYawMin);
-		WEAPON_READ_FIELD(float, hipViewKickYawMax);
-		WEAPON_READ_FIELD(float, hipViewKickMagMin);
-		WEAPON_READ_FIELD(float, hipViewKickCenterSpeed);
-		WEAPON_READ_FIELD(float, hipViewScatterMin);
-		WEAPON_READ_FIELD(float, hipViewScatterMax);
-		WEAPON_READ_FIELD(float, viewKickScale);
-		WEAPON_READ_FIELD(int, positionReloadTransTime);
-		WEAPON_READ_FIELD(float, fightDist);
-		WEAPON_READ_FIELD(float, maxDist);
-		WEAPON_READ_FIELD(float, leftArc);
-		WEAPON_READ_FIELD(float, rightArc);
-		WEAPON_READ_FIELD(float, topArc);
-		WEAPON_READ_FIELD(float, bottomArc);
-		WEAPON_READ_FIELD(float, accuracy);
-		WEAPON_READ_FIELD(float, aiSpread);
-		WEAPON_READ_FIELD(float, playerSpread);
-		WEAPON_READ_FIELD_ARR(float, minTurnSpeed, 2);
-		WEAPON_READ_FIELD_ARR(float, maxTurnSpeed, 2);
-		WEAPON_READ_FIELD(float, pitchConvergenceTime);
-		WEAPON_READ_FIELD(float, yawConvergenceTime);
-		WEAPON_READ_FIELD(float, suppressTime);
-		WEAPON_READ_FIELD(float, maxRange);
-		WEAPON_READ_FIELD(float, animHorRotateInc);
-		WEAPON_READ_FIELD(float, playerPositionDist);
 		//WEAPON_READ_FIELD(unsigned int, iUseHintStringIndex); // runtime
 		//WEAPON_READ_FIELD(unsigned int, dropHintStringIndex); // runtime
-		WEAPON_READ_FIELD(float, horizViewJitter);
-		WEAPON_READ_FIELD(float, vertViewJitter);
-		WEAPON_READ_FIELD(float, scanSpeed);
-		WEAPON_READ_FIELD(float, scanAccel);
-		WEAPON_READ_FIELD(int, scanPauseTime);
-		WEAPON_READ_FIELD(int, minDamage);
-		WEAPON_READ_FIELD(int, midDamage);
-		WEAPON_READ_FIELD(int, minPlayerDamage);
-		WEAPON_READ_FIELD(int, midPlayerDamage);
-		WEAPON_READ_FIELD(float, maxDamageRange);
-		WEAPON_READ_FIELD(float, minDamageRange);
-		WEAPON_READ_FIELD(int, signatureAmmoInClip);
-		WEAPON_READ_FIELD(int, signatureDamage);
-		WEAPON_READ_FIELD(int, signatureMidDamage);
-		WEAPON_READ_FIELD(int, signatureMinDamage);
-		WEAPON_READ_FIELD(float, signatureMaxDamageRange);
-		WEAPON_READ_FIELD(float, signatureMinDamageRange);
-		WEAPON_READ_FIELD(float, destabilizationRateTime);
-		WEAPON_READ_FIELD(float, destabilizationCurvatureMax);
-		WEAPON_READ_FIELD(int, destabilizeDistance);
-		WEAPON_READ_FIELD(float, turretADSTime);
-		WEAPON_READ_FIELD(float, turretFov);
-		WEAPON_READ_FIELD(float, turretFovADS);
-		WEAPON_READ_FIELD(float, turretScopeZoomRate);
-		WEAPON_READ_FIELD(float, turretScopeZoomMin);
-		WEAPON_READ_FIELD(float, turretScopeZoomMax);
-		WEAPON_READ_FIELD(float, overheatUpRate);
-		WEAPON_READ_FIELD(float, overheatDownRate);
-		WEAPON_READ_FIELD(float, overheatCooldownRate);
-		WEAPON_READ_FIELD(float, overheatPenalty);
-		WEAPON_READ_FIELD(float, turretBarrelSpinSpeed);
-		WEAPON_READ_FIELD(float, turretBarrelSpinUpTime);
-		WEAPON_READ_FIELD(float, turretBarrelSpinDownTime);
-		WEAPON_READ_FIELD(float, missileConeSoundRadiusAtTop);
-		WEAPON_READ_FIELD(float, missileConeSoundRadiusAtBase);
-		WEAPON_READ_FIELD(float, missileConeSoundHeight);
-		WEAPON_READ_FIELD(float, missileConeSoundOriginOffset);
-		WEAPON_READ_FIELD(float, missileConeSoundVolumescaleAtCore);
-		WEAPON_READ_FIELD(float, missileConeSoundVolumescaleAtEdge);
-		WEAPON_READ_FIELD(float, missileConeSoundVolumescaleCoreSize);
-		WEAPON_READ_FIELD(float, missileConeSoundPitchAtTop);
-		WEAPON_READ_FIELD(float, missileConeSoundPitchAtBottom);
-		WEAPON_READ_FIELD(float, missileConeSoundPitchTopSize);
-		WEAPON_READ_FIELD(float, missileConeSoundPitchBottomSize);
-		WEAPON_READ_FIELD(float, missileConeSoundCrossfadeTopSize);
-		WEAPON_READ_FIELD(float, missileConeSoundCrossfadeBottomSize);
-		WEAPON_READ_FIELD(float, aim_automelee_lerp);
-		WEAPON_READ_FIELD(float, aim_automelee_range);
-		WEAPON_READ_FIELD(float, aim_automelee_region_height);
-		WEAPON_READ_FIELD(float, aim_automelee_region_width);
-		WEAPON_READ_FIELD(float, player_meleeHeight);
-		WEAPON_READ_FIELD(float, player_meleeRange);
-		WEAPON_READ_FIELD(float, player_meleeWidth);
-		WEAPON_READ_FIELD(float, changedFireTime);
-		WEAPON_READ_FIELD(int, changedFireTimeNumBullets);
-		WEAPON_READ_FIELD(weapFireTimeInterpolation_t, fireTimeInterpolationType);
-		WEAPON_READ_FIELD(int, generateAmmo);
-		WEAPON_READ_FIELD(int, ammoPerShot);
-		WEAPON_READ_FIELD(int, explodeCount);
-		WEAPON_READ_FIELD(int, batteryDischargeRate);
-		WEAPON_READ_FIELD(int, extendedBattery);
-		WEAPON_READ_FIELD(int, iU_079);
-		WEAPON_READ_FIELD(int, iU_080);
-		WEAPON_READ_FIELD(unsigned char, rattleSoundType);
-		WEAPON_READ_FIELD(bool, adsShouldShowCrosshair);
-		WEAPON_READ_FIELD(bool, adsCrosshairShouldScale);
-		WEAPON_READ_FIELD(bool, turretADSEnabled);
-		WEAPON_READ_FIELD(bool, knifeAttachTagLeft);
-		WEAPON_READ_FIELD(bool, knifeAlwaysAttached);
-		WEAPON_READ_FIELD(bool, meleeOverrideValues);
-		WEAPON_READ_FIELD(bool, riotShieldEnableDamage);
-		WEAPON_READ_FIELD(bool, allowPrimaryWeaponPickup);
-		WEAPON_READ_FIELD(bool, sharedAmmo);
-		WEAPON_READ_FIELD(bool, lockonSupported);
-		WEAPON_READ_FIELD(bool, requireLockonToFire);
-		WEAPON_READ_FIELD(bool, isAirburstWeapon);
-		WEAPON_READ_FIELD(bool, bigExplosion);
-		WEAPON_READ_FIELD(bool, noAdsWhenMagEmpty);
-		WEAPON_READ_FIELD(bool, avoidDropCleanup);
-		WEAPON_READ_FIELD(bool, inheritsPerks);
-		WEAPON_READ_FIELD(bool, crosshairColorChange);
-		WEAPON_READ_FIELD(bool, rifleBullet);
-		WEAPON_READ_FIELD(bool, armorPiercing);
-		WEAPON_READ_FIELD(bool, boltAction);
-		WEAPON_READ_FIELD(bool, aimDownSight);
-		WEAPON_READ_FIELD(bool, canHoldBreath);
-		WEAPON_READ_FIELD(bool, meleeOnly);
-		WEAPON_READ_FIELD(bool, bU_085);
-		WEAPON_READ_FIELD(bool, bU_086);
-		WEAPON_READ_FIELD(bool, canVariableZoom);
-		WEAPON_READ_FIELD(bool, rechamberWhileAds);
-		WEAPON_READ_FIELD(bool, bulletExplosiveDamage);
-		WEAPON_READ_FIELD(bool, cookOffHold);
-		WEAPON_READ_FIELD(bool, useBattery);
-		WEAPON_READ_FIELD(bool, reticleSpin45);
-		WEAPON_READ_FIELD(bool, clipOnly);
-		WEAPON_READ_FIELD(bool, noAmmoPickup);
-		WEAPON_READ_FIELD(bool, disableSwitchToWhenEmpty);
-		WEAPON_READ_FIELD(bool, suppressAmmoReserveDisplay);
-		WEAPON_READ_FIELD(bool, motionTracker);
-		WEAPON_READ_FIELD(bool, markableViewmodel);
-		WEAPON_READ_FIELD(bool, noDualWield);
-		WEAPON_READ_FIELD(bool, flipKillIcon);
-		WEAPON_READ_FIELD(bool, actionSlotShowAmmo);
-		WEAPON_READ_FIELD(bool, noPartialReload);
-		WEAPON_READ_FIELD(bool, segmentedReload);
-		WEAPON_READ_FIELD(bool, multipleReload);
-		WEAPON_READ_FIELD(bool, blocksProne);
-		WEAPON_READ_FIELD(bool, silenced);
-		WEAPON_READ_FIELD(bool, isRollingGrenade);
-		WEAPON_READ_FIELD(bool, projExplosionEffectForceNormalUp);
-		WEAPON_READ_FIELD(bool, projExplosionEffectInheritParentDirection);
-		WEAPON_READ_FIELD(bool, projImpactExplode);
-		WEAPON_READ_FIELD(bool, projTrajectoryEvents);
-		WEAPON_READ_FIELD(bool, projWhizByEnabled);
-		WEAPON_READ_FIELD(bool, stickToPlayers);
-		WEAPON_READ_FIELD(bool, stickToVehicles);
-		WEAPON_READ_FIELD(bool, stickToTurrets);
-		WEAPON_READ_FIELD(bool, thrownSideways);
-		WEAPON_READ_FIELD(bool, hasDetonatorEmptyThrow);
-		WEAPON_READ_FIELD(bool, hasDetonatorDoubleTap);
-		WEAPON_READ_FIELD(bool, disableFiring);
-		WEAPON_READ_FIELD(bool, timedDetonation);
-		WEAPON_READ_FIELD(bool, noCrumpleMissile);
-		WEAPON_READ_FIELD(bool, fuseLitAfterImpact);
-		WEAPON_READ_FIELD(bool, rotate);
-		WEAPON_READ_FIELD(bool, holdButtonToThrow);
-		WEAPON_READ_FIELD(bool, freezeMovementWhenFiring);
-		WEAPON_READ_FIELD(bool, thermalScope);
-		WEAPON_READ_FIELD(bool, thermalToggle);
-		WEAPON_READ_FIELD(bool, outlineEnemies);
-		WEAPON_READ_FIELD(bool, altModeSameWeapon);
-		WEAPON_READ_FIELD(bool, turretBarrelSpinEnabled);
-		WEAPON_READ_FIELD(bool, missileConeSoundEnabled);
-		WEAPON_READ_FIELD(bool, missileConeSoundPitchshiftEnabled);
-		WEAPON_READ_FIELD(bool, missileConeSoundCrossfadeEnabled);
-		WEAPON_READ_FIELD(bool, offhandHoldIsCancelable);
-		WEAPON_READ_FIELD(bool, doNotAllowAttachmentsToOverrideSpread);
-		WEAPON_READ_FIELD(bool, useFastReloadAnims);
-		WEAPON_READ_FIELD(bool, dualMagReloadSupported);
-		WEAPON_READ_FIELD(bool, reloadStopsAlt);
-		WEAPON_READ_FIELD(bool, useScopeDrift);
-		WEAPON_READ_FIELD(bool, alwaysShatterGlassOnImpact);
-		WEAPON_READ_FIELD(bool, oldWeapon);
-		WEAPON_READ_FIELD(bool, raiseToHold);
-		WEAPON_READ_FIELD(bool, notifyOnPlayerImpact);
-		WEAPON_READ_FIELD(bool, decreasingKick);
-		WEAPON_READ_FIELD(bool, counterSilencer);
-		WEAPON_READ_FIELD(bool, projSuppressedByEMP);
-		WEAPON_READ_FIELD(bool, projDisabledByEMP);
-		WEAPON_READ_FIELD(bool, autosimDisableVariableRate);
-		WEAPON_READ_FIELD(bool, projPlayTrailEffectForOwnerOnly);
-		WEAPON_READ_FIELD(bool, projPlayBeaconEffectForOwnerOnly);
-		WEAPON_READ_FIELD(bool, projKillTrailEffectOnDeath);
-		WEAPON_READ_FIELD(bool, projKillBeaconEffectOnDeath);
-		WEAPON_READ_FIELD(bool, reticleDetonateHide);
-		WEAPON_READ_FIELD(bool, cloaked);
-		WEAPON_READ_FIELD(bool, adsHideWeapon);
-		WEAPON_READ_FIELD(bool, adsHideHands);
-		WEAPON_READ_FIELD(bool, bU_108);
-		WEAPON_READ_FIELD(bool, adsSceneBlur);
-		WEAPON_READ_FIELD(bool, usesSniperScope);
-		WEAPON_READ_FIELD(bool, hasTransientModels);
-		WEAPON_READ_FIELD(bool, bU_112);
-		WEAPON_READ_FIELD(bool, bU_113);
-		WEAPON_READ_FIELD(bool, bU_114);
-		WEAPON_READ_FIELD(bool, bU_115);
-		WEAPON_READ_FIELD(float, adsDofPhysicalFstop);
-		WEAPON_READ_FIELD(float, adsDofPhysicalFocusDistance);
-		WEAPON_READ_FIELD(float, autosimSpeedScale);
-		WEAPON_READ_FIELD(float, reactiveMotionRadiusScale);
-		WEAPON_READ_FIELD(float, reactiveMotionFrequencyScale);
-		WEAPON_READ_FIELD(float, reactiveMotionAmplitudeScale);
-		WEAPON_READ_FIELD(float, reactiveMotionFalloff);
-		WEAPON_READ_FIELD(float, reactiveMotionLifetime);
-
-		WEAPON_READ_FIELD_ARR(float, fU_3604, 3);
 
 		return weapon;
 	}
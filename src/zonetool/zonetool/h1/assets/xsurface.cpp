@@ -1,6 +1,10 @@
 #include "std_include.hpp"
 #include "xsurface.hpp"
 
+#include "zonetool/utils/mesh_optimize.hpp"
+
+#include <utils/flags.hpp>
+
 namespace zonetool::h1
 {
 	void parse_subdiv(XSurface* surf, assetmanager::reader& reader)
@@ -33,6 +37,234 @@ namespace zonetool::h1
 		}
 	}
 
+	namespace
+	{
+		template <typename T>
+		T* copy_array(const T* src, const std::size_t count, const xsurface::allocate_callback& allocate)
+		{
+			auto* dst = static_cast<T*>(allocate(sizeof(T) * count));
+			std::memcpy(dst, src, sizeof(T) * count);
+			return dst;
+		}
+
+		template <typename T>
+		T* remap_array(const T* src, const std::vector<std::uint16_t>& remap, const xsurface::allocate_callback& allocate)
+		{
+			if (!src)
+			{
+				return nullptr;
+			}
+
+			auto* dst = static_cast<T*>(allocate(sizeof(T) * remap.size()));
+			mesh_optimize::remap_vertices(dst, src, remap);
+			return dst;
+		}
+
+		// rigid lists own a triangle range, triangles only move inside of one
+		std::vector<mesh_optimize::index_range> get_triangle_ranges(const XSurface* surf)
+		{
+			std::vector<std::uint32_t> bounds = {0, surf->triCount};
+			for (auto i = 0u; surf->rigidVertLists && i < surf->rigidVertListCount; i++)
+			{
+				const auto& list = surf->rigidVertLists[i];
+				bounds.emplace_back(list.triOffset);
+				bounds.emplace_back(list.triOffset + list.triCount);
+			}
+
+			std::sort(bounds.begin(), bounds.end());
+			bounds.erase(std::unique(bounds.begin(), bounds.end()), bounds.end());
+
+			std::vector<mesh_optimize::index_range> ranges;
+			for (auto i = 1u; i < bounds.size() && bounds[i] <= surf->triCount; i++)
+			{
+				ranges.emplace_back(mesh_optimize::index_range{bounds[i - 1], bounds[i] - bounds[i - 1]});
+			}
+
+			return ranges;
+		}
+
+		// collision leafs point at triangles, but not whether relative to the rigid list or the surface
+		bool has_collision_leafs(const XSurface* surf)
+		{
+			for (auto i = 0u; surf->rigidVertLists && i < surf->rigidVertListCount; i++)
+			{
+				const auto* tree = surf->rigidVertLists[i].collisionTree;
+				if (tree && tree->leafs && tree->leafCount)
+				{
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+		// blend groups and rigid lists are consecutive vertex ranges
+		std::vector<mesh_optimize::index_range> get_vertex_ranges(const XSurface* surf)
+		{
+			std::vector<mesh_optimize::index_range> ranges;
+			std::uint32_t total = 0;
+
+			const auto add_range = [&](const std::uint32_t count)
+			{
+				ranges.emplace_back(mesh_optimize::index_range{total, count});
+				total += count;
+			};
+
+			if (surf->blendVerts)
+			{
+				for (const auto count : surf->blendVertCounts)
+				{
+					add_range(static_cast<std::uint16_t>(count));
+				}
+			}
+			else if (surf->rigidVertLists && surf->rigidVertListCount)
+			{
+				for (auto i = 0u; i < surf->rigidVertListCount; i++)
+				{
+					add_range(surf->rigidVertLists[i].vertCount);
+				}
+			}
+			else
+			{
+				add_range(surf->vertCount);
+			}
+
+			if (total != surf->vertCount)
+			{
+				return {};
+			}
+
+			return ranges;
+		}
+
+		void remap_surface_vertices(XSurface* surf, const std::vector<std::uint16_t>& remap, const xsurface::allocate_callback& allocate)
+		{
+			// motion verts have the same size
+			surf->verts0.packedVerts0 = remap_array(surf->verts0.packedVerts0, remap, allocate);
+			surf->unknown0 = remap_array(surf->unknown0, remap, allocate);
+			surf->blendVertsTable = remap_array(surf->blendVertsTable, remap, allocate);
+			surf->lmapUnwrap = remap_array(surf->lmapUnwrap, remap, allocate);
+
+			if (!surf->blendVerts)
+			{
+				return;
+			}
+
+			// a vertex in blend group n has 2n + 1 entries
+			std::size_t blend_size = 0;
+			for (auto i = 0u; i < 8; i++)
+			{
+				blend_size += surf->blendVertCounts[i] * (2 * i + 1);
+			}
+
+			auto* blend_verts = static_cast<XBlendInfo*>(allocate(sizeof(XBlendInfo) * blend_size));
+
+			std::size_t vertex_offset = 0;
+			std::size_t blend_offset = 0;
+			for (auto i = 0u; i < 8; i++)
+			{
+				const auto count = static_cast<std::size_t>(surf->blendVertCounts[i]);
+				const auto stride = 2 * i + 1;
+
+				std::vector<std::uint16_t> group_remap(count);
+				for (auto v = 0u; v < count; v++)
+				{
+					group_remap[v] = static_cast<std::uint16_t>(remap[vertex_offset + v] - vertex_offset);
+				}
+
+				mesh_optimize::remap_vertices(blend_verts + blend_offset, surf->blendVerts + blend_offset, group_remap, stride);
+
+				vertex_offset += count;
+				blend_offset += count * stride;
+			}
+
+			surf->blendVerts = blend_verts;
+		}
+
+		bool optimize_surface(XSurface* surf, const xsurface::allocate_callback& allocate, double& acmr_before, double& acmr_after)
+		{
+			if (!surf->triIndices || !surf->triCount || surf->subdiv || surf->subdivLevelCount)
+			{
+				return false;
+			}
+
+			// the second index buffer is only kept in sync when it is a copy of the first
+			if (surf->triIndices2 && surf->triIndices2 != surf->triIndices
+				&& std::memcmp(surf->triIndices2, surf->triIndices, sizeof(Face) * surf->triCount))
+			{
+				return false;
+			}
+
+			const auto can_move_triangles = !has_collision_leafs(surf);
+
+			// tension and blend shape data index vertices too, vertex lighting is baked in the original vertex order
+			const auto can_move_vertices = !surf->tensionData && !surf->tensionAccumTable && !surf->blendShapesCount
+				&& !surf->vertexLightingIndex;
+			const auto vertex_ranges = can_move_vertices ? get_vertex_ranges(surf) : std::vector<mesh_optimize::index_range>{};
+			if (!can_move_triangles && vertex_ranges.empty())
+			{
+				return false;
+			}
+
+			auto* faces = copy_array(surf->triIndices, surf->triCount, allocate);
+			auto* indices = reinterpret_cast<std::uint16_t*>(faces);
+
+			acmr_before = mesh_optimize::get_acmr(indices, surf->triCount);
+
+			if (can_move_triangles)
+			{
+				for (const auto& range : get_triangle_ranges(surf))
+				{
+					mesh_optimize::optimize_vertex_cache(indices + range.begin * 3, range.count);
+				}
+			}
+
+			if (!vertex_ranges.empty())
+			{
+				const auto remap = mesh_optimize::get_fetch_remap(indices, surf->triCount, vertex_ranges, surf->vertCount);
+				mesh_optimize::remap_indices(indices, surf->triCount * 3, remap);
+				remap_surface_vertices(surf, remap, allocate);
+			}
+
+			acmr_after = mesh_optimize::get_acmr(indices, surf->triCount);
+
+			surf->triIndices2 = surf->triIndices2 ? faces : nullptr;
+			surf->triIndices = faces;
+			return true;
+		}
+	}
+
+	void xsurface::optimize(XModelSurfs* asset, const allocate_callback& allocate)
+	{
+		std::size_t optimized = 0;
+		std::size_t tri_count = 0;
+		double acmr_before = 0.0;
+		double acmr_after = 0.0;
+
+		for (auto i = 0u; i < asset->numsurfs; i++)
+		{
+			auto* surf = &asset->surfs[i];
+
+			auto before = 0.0;
+			auto after = 0.0;
+			if (!optimize_surface(surf, allocate, before, after))
+			{
+				continue;
+			}
+
+			optimized++;
+			tri_count += surf->triCount;
+			acmr_before += before * surf->triCount;
+			acmr_after += after * surf->triCount;
+		}
+
+		if (tri_count)
+		{
+			ZONETOOL_INFO("Optimized %zu/%u surfaces of \"%s\", acmr %.3f -> %.3f", optimized, asset->numsurfs, asset->name,
+				acmr_before / tri_count, acmr_after / tri_count);
+		}
+	}
+
 	XModelSurfs* xsurface::parse(const std::string& name, zone_memory* mem)
 	{
 		const auto path = "xsurface\\" + name + ".xsb";
@@ -102,6 +334,14 @@ namespace zonetool::h1
 
 		read.close();
 
+		if (utils::flags::has_flag("optimizemeshes"))
+		{
+			optimize(asset, [&](const std::size_t size)
+			{
+				return mem->allocate<char>(size);
+			});
+		}
+
 		return asset;
 	}
 
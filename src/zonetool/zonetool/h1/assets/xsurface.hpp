@@ -24,5 +24,11 @@ namespace zonetool::h1
 		void write(zone_base* zone, zone_buffer* buffer) override;
 
 		static void dump(XModelSurfs* asset);
+
+		using allocate_callback = std::function<void*(std::size_t size)>;
+
+		// vertex cache and vertex fetch reordering, changed arrays are copied into memory from allocate
+		// so source zones are never touched
+		static void optimize(XModelSurfs* asset, const allocate_callback& allocate);
 	};
 }
\ No newline at end of file
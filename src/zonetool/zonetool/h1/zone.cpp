@@ -3,6 +3,8 @@
 #include "zone.hpp"
 #include "zonetool/utils/utils.hpp"
 #include "zonetool/utils/imagefile.hpp"
+#include "zonetool/utils/profiler.hpp"
+#include "zonetool/utils/size_report.hpp"
 
 #include <utils/flags.hpp>
 #include <utils/io.hpp>
@@ -73,6 +75,8 @@ namespace zonetool::h1
 
 		const std::string& name = get_asset_name(XAssetType(type), pointer);
 
+		this->m_dependencies.add_reference(type, name);
+
 		// don't add asset if it already exists
 		for (std::size_t idx = 0; idx < m_assets.size(); idx++)
 		{
@@ -86,8 +90,16 @@ namespace zonetool::h1
 		if (type == __type__) \
 		{ \
 			auto asset = std::make_shared < ___ >(); \
-			asset->init(pointer, this->m_zonemem.get()); \
-			asset->load_depending(this); \
+			{ \
+				profiler::scope _("parse", name, type_to_string(XAssetType(type))); \
+				asset->init(pointer, this->m_zonemem.get()); \
+			} \
+			{ \
+				profiler::scope _("load_depending", name, type_to_string(XAssetType(type))); \
+				this->m_dependencies.begin_asset(type, name); \
+				asset->load_depending(this); \
+				this->m_dependencies.end_asset(); \
+			} \
 			m_assets.push_back(asset); \
 		}
 
@@ -104,6 +116,20 @@ namespace zonetool::h1
 		}
 	}
 
+	void zone_interface::add_assets_of_type_by_pointer(std::int32_t type, const std::vector<void*>& pointers)
+	{
+		if (type == ASSET_TYPE_LOCALIZE_ENTRY)
+		{
+			add_assets_by_pointer<localize, LocalizeEntry>(this->m_assets, type, pointers);
+			return;
+		}
+
+		for (auto* pointer : pointers)
+		{
+			this->add_asset_of_type_by_pointer(type, pointer);
+		}
+	}
+
 	void zone_interface::add_asset_of_type(std::int32_t type, const std::string& _name)
 	{
 		std::string name = _name;
@@ -122,6 +148,9 @@ namespace zonetool::h1
 			}
 		}
 
+		// whatever is loading its dependencies right now has to be written after this
+		this->m_dependencies.add_reference(type, name);
+
 		// don't add asset if it already exists
 		if (get_asset_pointer(type, name))
 		{
@@ -133,87 +162,46 @@ namespace zonetool::h1
 
 		}
 
-#define ADD_ASSET(__type__, ___) \
-		if (type == __type__) \
-		{ \
-			auto asset = std::make_shared < ___ >(); \
-			asset->init(name, this->m_zonemem.get()); \
-			asset->load_depending(this); \
-			m_assets.push_back(asset); \
+		if (this->m_prefetch_pending)
+		{
+			this->m_prefetch_pending = false;
+			this->start_prefetch();
 		}
 
+		// files could resolve differently now, parse the rest here
+		if (this->m_prefetch && filesystem::get_search_paths_version() != this->m_prefetch_search_paths)
+		{
+			ZONETOOL_INFO("Search paths changed, stopping the prefetch");
+			this->m_prefetch.reset();
+		}
+
+		std::shared_ptr<asset_interface> asset;
+
 		try
 		{
-			// declare asset interfaces
-			ADD_ASSET(ASSET_TYPE_CLUT, clut);
-			ADD_ASSET(ASSET_TYPE_DOPPLER_PRESET, doppler_preset);
-			ADD_ASSET(ASSET_TYPE_FX, fx_effect_def);
-			ADD_ASSET(ASSET_TYPE_PARTICLE_SIM_ANIMATION, fx_particle_sim_animation);
-			ADD_ASSET(ASSET_TYPE_IMAGE, gfx_image);
-			ADD_ASSET(ASSET_TYPE_LIGHT_DEF, gfx_light_def);
-			ADD_ASSET(ASSET_TYPE_IMPACT_FX, impact_fx);
-			ADD_ASSET(ASSET_TYPE_LASER, laser_def);
-			ADD_ASSET(ASSET_TYPE_LOADED_SOUND, loaded_sound);
-			ADD_ASSET(ASSET_TYPE_LOCALIZE_ENTRY, localize);
-			ADD_ASSET(ASSET_TYPE_LPF_CURVE, lpf_curve);
-			ADD_ASSET(ASSET_TYPE_LUA_FILE, lua_file);
-			ADD_ASSET(ASSET_TYPE_MAP_ENTS, map_ents);
-			ADD_ASSET(ASSET_TYPE_MATERIAL, material);
-			ADD_ASSET(ASSET_TYPE_NET_CONST_STRINGS, net_const_strings);
-			ADD_ASSET(ASSET_TYPE_RAWFILE, rawfile);
-			ADD_ASSET(ASSET_TYPE_REVERB_CURVE, reverb_curve);
-			ADD_ASSET(ASSET_TYPE_REVERB_PRESET, reverb_preset);
-			ADD_ASSET(ASSET_TYPE_SCRIPTABLE, scriptable_def);
-			ADD_ASSET(ASSET_TYPE_SCRIPTFILE, scriptfile);
-			ADD_ASSET(ASSET_TYPE_SKELETON_SCRIPT, skeleton_script);
-			ADD_ASSET(ASSET_TYPE_SOUND, sound);
-			ADD_ASSET(ASSET_TYPE_SOUND_CONTEXT, sound_context);
-			ADD_ASSET(ASSET_TYPE_SOUND_CURVE, sound_curve);
-			ADD_ASSET(ASSET_TYPE_SNDDRIVER_GLOBALS, sound_driver_globals);
-			ADD_ASSET(ASSET_TYPE_SOUND_SUBMIX, sound_submix);
-			ADD_ASSET(ASSET_TYPE_STRINGTABLE, string_table);
-			ADD_ASSET(ASSET_TYPE_STRUCTURED_DATA_DEF, structured_data_def_set);
-			ADD_ASSET(ASSET_TYPE_SURFACE_FX, surface_fx);
-			ADD_ASSET(ASSET_TYPE_TECHNIQUE_SET, techset);
-			ADD_ASSET(ASSET_TYPE_TRACER, tracer_def);
-			ADD_ASSET(ASSET_TYPE_TTF, ttf_def);
-			ADD_ASSET(ASSET_TYPE_VEHICLE, vehicle_def);
-			ADD_ASSET(ASSET_TYPE_ATTACHMENT, weapon_attachment);
-			ADD_ASSET(ASSET_TYPE_WEAPON, weapon_def);
-			ADD_ASSET(ASSET_TYPE_XANIMPARTS, xanim_parts);
-			ADD_ASSET(ASSET_TYPE_XMODEL, xmodel);
-			ADD_ASSET(ASSET_TYPE_XMODEL_SURFS, xsurface);
-
-			ADD_ASSET(ASSET_TYPE_LEADERBOARD, leaderboard);
-			ADD_ASSET(ASSET_TYPE_VIRTUAL_LEADERBOARD, virtual_leaderboard);
-
-			ADD_ASSET(ASSET_TYPE_DDL, ddl);
-			ADD_ASSET(ASSET_TYPE_EQUIPMENT_SND_TABLE, equip_snd_table);
-			ADD_ASSET(ASSET_TYPE_VECTORFIELD, vector_field);
-			ADD_ASSET(ASSET_TYPE_ANIMCLASS, anim_class);
-
-			ADD_ASSET(ASSET_TYPE_PHYSCOLLMAP, phys_collmap);
-			ADD_ASSET(ASSET_TYPE_PHYSCONSTRAINT, phys_constraint);
-			ADD_ASSET(ASSET_TYPE_PHYSPRESET, phys_preset);
-			ADD_ASSET(ASSET_TYPE_PHYSWATERPRESET, phys_water_preset);
-			ADD_ASSET(ASSET_TYPE_PHYSWORLDMAP, phys_world);
-
-			ADD_ASSET(ASSET_TYPE_COMPUTESHADER, compute_shader);
-			ADD_ASSET(ASSET_TYPE_DOMAINSHADER, domain_shader);
-			ADD_ASSET(ASSET_TYPE_HULLSHADER, hull_shader);
-			ADD_ASSET(ASSET_TYPE_PIXELSHADER, pixel_shader);
-			//ADD_ASSET(ASSET_TYPE_VERTEXDECL, vertex_decl);
-			ADD_ASSET(ASSET_TYPE_VERTEXSHADER, vertex_shader);
-
-			//ADD_ASSET(ASSET_TYPE_MENU, menu_def); // added via menulist
-			ADD_ASSET(ASSET_TYPE_MENULIST, menu_list);
-
-			ADD_ASSET(ASSET_TYPE_PATHDATA, path_data);
-			ADD_ASSET(ASSET_TYPE_CLIPMAP, clip_map);
-			ADD_ASSET(ASSET_TYPE_COMWORLD, com_world);
-			ADD_ASSET(ASSET_TYPE_FXWORLD, fx_world);
-			ADD_ASSET(ASSET_TYPE_GFXWORLD, gfx_world);
-			ADD_ASSET(ASSET_TYPE_GLASSWORLD, glass_world);
+			if (this->m_prefetch)
+			{
+				asset = this->m_prefetch->take(type, name);
+			}
+
+			if (!asset)
+			{
+				asset = this->parse_asset(type, name);
+			}
+
+			if (!asset)
+			{
+				return;
+			}
+
+			{
+				profiler::scope _("load_depending", name, type_to_string(XAssetType(type)));
+				this->m_dependencies.begin_asset(type, name);
+				asset->load_depending(this);
+				this->m_dependencies.end_asset();
+			}
+
+			m_assets.push_back(asset);
 		}
 		catch (std::exception& ex)
 		{
@@ -222,11 +210,107 @@ namespace zonetool::h1
 		}
 	}
 
+	// called from the prefetch workers as well for the types of is_prefetch_safe
+	std::shared_ptr<asset_interface> zone_interface::parse_asset(const std::int32_t type, const std::string& name)
+	{
+#define PARSE_ASSET(__type__, ___) \
+		if (type == __type__) \
+		{ \
+			profiler::scope _("parse", name, type_to_string(XAssetType(type))); \
+			auto asset = std::make_shared < ___ >(); \
+			asset->init(name, this->m_zonemem.get()); \
+			return asset; \
+		}
+
+		// declare asset interfaces
+		PARSE_ASSET(ASSET_TYPE_CLUT, clut);
+		PARSE_ASSET(ASSET_TYPE_DOPPLER_PRESET, doppler_preset);
+		PARSE_ASSET(ASSET_TYPE_FX, fx_effect_def);
+		PARSE_ASSET(ASSET_TYPE_PARTICLE_SIM_ANIMATION, fx_particle_sim_animation);
+		PARSE_ASSET(ASSET_TYPE_IMAGE, gfx_image);
+		PARSE_ASSET(ASSET_TYPE_LIGHT_DEF, gfx_light_def);
+		PARSE_ASSET(ASSET_TYPE_IMPACT_FX, impact_fx);
+		PARSE_ASSET(ASSET_TYPE_LASER, laser_def);
+		PARSE_ASSET(ASSET_TYPE_LOADED_SOUND, loaded_sound);
+		PARSE_ASSET(ASSET_TYPE_LOCALIZE_ENTRY, localize);
+		PARSE_ASSET(ASSET_TYPE_LPF_CURVE, lpf_curve);
+		PARSE_ASSET(ASSET_TYPE_LUA_FILE, lua_file);
+		PARSE_ASSET(ASSET_TYPE_MAP_ENTS, map_ents);
+		PARSE_ASSET(ASSET_TYPE_MATERIAL, material);
+		PARSE_ASSET(ASSET_TYPE_NET_CONST_STRINGS, net_const_strings);
+		PARSE_ASSET(ASSET_TYPE_RAWFILE, rawfile);
+		PARSE_ASSET(ASSET_TYPE_REVERB_CURVE, reverb_curve);
+		PARSE_ASSET(ASSET_TYPE_REVERB_PRESET, reverb_preset);
+		PARSE_ASSET(ASSET_TYPE_SCRIPTABLE, scriptable_def);
+		PARSE_ASSET(ASSET_TYPE_SCRIPTFILE, scriptfile);
+		PARSE_ASSET(ASSET_TYPE_SKELETON_SCRIPT, skeleton_script);
+		PARSE_ASSET(ASSET_TYPE_SOUND, sound);
+		PARSE_ASSET(ASSET_TYPE_SOUND_CONTEXT, sound_context);
+		PARSE_ASSET(ASSET_TYPE_SOUND_CURVE, sound_curve);
+		PARSE_ASSET(ASSET_TYPE_SNDDRIVER_GLOBALS, sound_driver_globals);
+		PARSE_ASSET(ASSET_TYPE_SOUND_SUBMIX, sound_submix);
+		PARSE_ASSET(ASSET_TYPE_STRINGTABLE, string_table);
+		PARSE_ASSET(ASSET_TYPE_STRUCTURED_DATA_DEF, structured_data_def_set);
+		PARSE_ASSET(ASSET_TYPE_SURFACE_FX, surface_fx);
+		PARSE_ASSET(ASSET_TYPE_TECHNIQUE_SET, techset);
+		PARSE_ASSET(ASSET_TYPE_TRACER, tracer_def);
+		PARSE_ASSET(ASSET_TYPE_TTF, ttf_def);
+		PARSE_ASSET(ASSET_TYPE_VEHICLE, vehicle_def);
+		PARSE_ASSET(ASSET_TYPE_ATTACHMENT, weapon_attachment);
+		PARSE_ASSET(ASSET_TYPE_WEAPON, weapon_def);
+		PARSE_ASSET(ASSET_TYPE_XANIMPARTS, xanim_parts);
+		PARSE_ASSET(ASSET_TYPE_XMODEL, xmodel);
+		PARSE_ASSET(ASSET_TYPE_XMODEL_SURFS, xsurface);
+
+		PARSE_ASSET(ASSET_TYPE_LEADERBOARD, leaderboard);
+		PARSE_ASSET(ASSET_TYPE_VIRTUAL_LEADERBOARD, virtual_leaderboard);
+
+		PARSE_ASSET(ASSET_TYPE_DDL, ddl);
+		PARSE_ASSET(ASSET_TYPE_EQUIPMENT_SND_TABLE, equip_snd_table);
+		PARSE_ASSET(ASSET_TYPE_VECTORFIELD, vector_field);
+		PARSE_ASSET(ASSET_TYPE_ANIMCLASS, anim_class);
+
+		PARSE_ASSET(ASSET_TYPE_PHYSCOLLMAP, phys_collmap);
+		PARSE_ASSET(ASSET_TYPE_PHYSCONSTRAINT, phys_constraint);
+		PARSE_ASSET(ASSET_TYPE_PHYSPRESET, phys_preset);
+		PARSE_ASSET(ASSET_TYPE_PHYSWATERPRESET, phys_water_preset);
+		PARSE_ASSET(ASSET_TYPE_PHYSWORLDMAP, phys_world);
+
+		PARSE_ASSET(ASSET_TYPE_COMPUTESHADER, compute_shader);
+		PARSE_ASSET(ASSET_TYPE_DOMAINSHADER, domain_shader);
+		PARSE_ASSET(ASSET_TYPE_HULLSHADER, hull_shader);
+		PARSE_ASSET(ASSET_TYPE_PIXELSHADER, pixel_shader);
+		//PARSE_ASSET(ASSET_TYPE_VERTEXDECL, vertex_decl);
+		PARSE_ASSET(ASSET_TYPE_VERTEXSHADER, vertex_shader);
+
+		//PARSE_ASSET(ASSET_TYPE_MENU, menu_def); // added via menulist
+		PARSE_ASSET(ASSET_TYPE_MENULIST, menu_list);
+
+		PARSE_ASSET(ASSET_TYPE_PATHDATA, path_data);
+		PARSE_ASSET(ASSET_TYPE_CLIPMAP, clip_map);
+		PARSE_ASSET(ASSET_TYPE_COMWORLD, com_world);
+		PARSE_ASSET(ASSET_TYPE_FXWORLD, fx_world);
+		PARSE_ASSET(ASSET_TYPE_GFXWORLD, gfx_world);
+		PARSE_ASSET(ASSET_TYPE_GLASSWORLD, glass_world);
+
+		return {};
+	}
+
 	std::int32_t zone_interface::get_type_by_name(const std::string& type)
 	{
 		return type_to_int(type);
 	}
 
+	zone_memory* zone_interface::get_memory()
+	{
+		return this->m_zonemem.get();
+	}
+
+	const std::vector<std::shared_ptr<asset_interface>>& zone_interface::get_assets() const
+	{
+		return this->m_assets;
+	}
+
 	void zone_interface::add_asset_of_type(const std::string& type, const std::string& name)
 	{
 		std::int32_t itype = type_to_int(type);
@@ -241,6 +325,15 @@ namespace zonetool::h1
 
 		ZONETOOL_INFO("Compiling fastfile \"%s\"...", this->name_.data());
 
+		// whatever is still prefetching wasn't asked for by the csv
+		this->m_prefetch.reset();
+
+		if (asset_order::is_enabled())
+		{
+			profiler::scope _("phase", "sort");
+			asset_order::sort(m_assets, this->m_dependencies);
+		}
+
 		constexpr std::size_t num_streams = 7;
 		XZoneMemory<num_streams> mem;
 
@@ -265,6 +358,7 @@ namespace zonetool::h1
 
 			if (images.size() > 0)
 			{
+				profiler::scope _("phase", "imagefile");
 				imagefile::generate(filesystem::get_fastfile(),
 					CUSTOM_IMAGEFILE_INDEX, FF_VERSION, FF_HEADER, images, this->m_zonemem.get());
 			}
@@ -277,9 +371,13 @@ namespace zonetool::h1
 		std::uintptr_t zero = 0;
 
 		// write asset types to header
-		for (std::size_t i = 0; i < m_assets.size(); i++)
 		{
-			m_assets[i]->prepare(buf, this->m_zonemem.get());
+			profiler::scope _("phase", "prepare");
+			for (std::size_t i = 0; i < m_assets.size(); i++)
+			{
+				profiler::scope asset_scope("prepare", m_assets[i].get(), type_to_string(XAssetType(m_assets[i]->type())));
+				m_assets[i]->prepare(buf, this->m_zonemem.get());
+			}
 		}
 
 		// write scriptstring count
@@ -523,22 +621,34 @@ namespace zonetool::h1
 			buf->write(&pad);
 		}
 
+		// per asset stream usage for -sizereport
+		size_report report(buf, num_streams);
+
 		// write assets
-		for (auto& asset : m_assets)
 		{
+			profiler::scope _("phase", "write");
+			for (auto& asset : m_assets)
+			{
 #ifdef DEBUG
-			ZONETOOL_INFO("writing asset \"%s\" of type %s...", asset->name().data(), type_to_string(XAssetType(asset->type())));
+				ZONETOOL_INFO("writing asset \"%s\" of type %s...", asset->name().data(), type_to_string(XAssetType(asset->type())));
 #endif
 
-			// push stream
-			buf->push_stream(XFILE_BLOCK_TEMP);
-			buf->align(3);
+				profiler::scope asset_scope("write", asset.get(), type_to_string(XAssetType(asset->type())));
+				asset_scope.track_streams(buf, num_streams);
+				report.begin_asset();
 
-			// write asset
-			asset->write(this, buf);
+				// push stream
+				buf->push_stream(XFILE_BLOCK_TEMP);
+				buf->align(3);
 
-			// pop stream
-			buf->pop_stream();
+				// write asset
+				asset->write(this, buf);
+
+				// pop stream
+				buf->pop_stream();
+
+				report.end_asset(asset.get(), type_to_string(XAssetType(asset->type())));
+			}
 		}
 
 		// pop stream
@@ -563,11 +673,15 @@ namespace zonetool::h1
 #endif
 
 		// Compress buffer
+		auto buf_compressed = [&]
+		{
+			profiler::scope _("phase", "compress");
 #if (COMPRESS_TYPE == COMPRESS_TYPE_LZ4)
-		auto buf_compressed = buf->compress_lz4(); // idk how to compress lz4 fastfiles properly
+			return buf->compress_lz4(); // idk how to compress lz4 fastfiles properly
 #elif (COMPRESS_TYPE == COMPRESS_TYPE_ZLIB)
-		auto buf_compressed = buf->compress_zlib();
+			return buf->compress_zlib();
 #endif
+		}();
 
 		const auto streamfiles_count = buf->streamfile_count();
 
@@ -631,7 +745,16 @@ namespace zonetool::h1
 		buf_compressed.shrink_to_fit();
 
 		std::string path = this->name_ + ".ff";
-		fastfile.save(path);
+		{
+			profiler::scope _("phase", "save");
+			fastfile.save(path);
+		}
+
+		report.save(path, COMPRESS_TYPE == COMPRESS_TYPE_LZ4 ? size_report::codec::lz4 : size_report::codec::zlib);
+		asset_order::write_graph(this->m_dependencies, path, [](const std::int32_t type)
+		{
+			return type_to_string(XAssetType(type));
+		});
 
 		ZONETOOL_INFO("Successfully compiled fastfile \"%s\"!", this->name_.data());
 		ZONETOOL_INFO("Compiling took %llu msec.", (GetTickCount64() - start_time));
@@ -649,6 +772,54 @@ namespace zonetool::h1
 			max_memory_size = max_memory_size * 2; // double the memory (2GB -> 4GB)
 		}
 		this->m_zonemem = std::make_shared<zone_memory>(max_memory_size);
+
+		this->m_prefetch_pending = utils::flags::has_flag("parallelparse");
+	}
+
+	namespace
+	{
+		// init only reads files and allocates zone memory, database fallbacks are redone on the main thread.
+		// material, techset and xanim fill globals while parsing and stay serial
+		bool is_prefetch_safe(const std::int32_t type)
+		{
+			switch (type)
+			{
+			case ASSET_TYPE_FX:
+			case ASSET_TYPE_IMAGE:
+			case ASSET_TYPE_LOADED_SOUND:
+			case ASSET_TYPE_LUA_FILE:
+			case ASSET_TYPE_RAWFILE:
+			case ASSET_TYPE_SCRIPTFILE:
+			case ASSET_TYPE_SOUND:
+			case ASSET_TYPE_STRINGTABLE:
+			case ASSET_TYPE_XMODEL:
+			case ASSET_TYPE_XMODEL_SURFS:
+				return true;
+			default:
+				return false;
+			}
+		}
+	}
+
+	void zone_interface::start_prefetch()
+	{
+		auto nodes = asset_order::read_graph_nodes(this->name_ + ".ff", type_to_int);
+		if (nodes.empty())
+		{
+			ZONETOOL_INFO("No dependency graph for \"%s\" yet, parsing serially until this build writes one", this->name_.data());
+			return;
+		}
+
+		std::erase_if(nodes, [](const std::pair<std::int32_t, std::string>& node)
+		{
+			return !is_prefetch_safe(node.first);
+		});
+
+		this->m_prefetch_search_paths = filesystem::get_search_paths_version();
+		this->m_prefetch = std::make_unique<asset_prefetch>(nodes, [this](const std::int32_t type, const std::string& name)
+		{
+			return this->parse_asset(type, name);
+		});
 	}
 
 	zone_interface::~zone_interface()
@@ -9,6 +9,17 @@ namespace zonetool::h1
 		std::string name_;
 		std::vector<std::shared_ptr<asset_interface>> m_assets;
 		std::shared_ptr<zone_memory> m_zonemem;
+		asset_order::dependencies m_dependencies;
+
+		// declared last so the workers are joined before the zone memory goes away
+		std::unique_ptr<asset_prefetch> m_prefetch;
+		bool m_prefetch_pending = false;
+		std::size_t m_prefetch_search_paths = 0;
+
+		// -parallelparse: parses the assets of the graph -depgraph wrote for the last build while the csv loads.
+		// starts with the first asset, so the csv options before it are in effect
+		void start_prefetch();
+		std::shared_ptr<asset_interface> parse_asset(std::int32_t type, const std::string& name);
 
 	public:
 		zone_interface(std::string name);
@@ -19,11 +30,17 @@ namespace zonetool::h1
 		void* get_asset_pointer(std::int32_t type, const std::string& name) override;
 
 		void add_asset_of_type_by_pointer(std::int32_t type, void* pointer) override;
+		void add_assets_of_type_by_pointer(std::int32_t type, const std::vector<void*>& pointers) override;
 
 		void add_asset_of_type(std::int32_t type, const std::string& name) override;
 		void add_asset_of_type(const std::string& type, const std::string& name) override;
 		std::int32_t get_type_by_name(const std::string& type) override;
 
+		zone_memory* get_memory() override;
+
+		// in load order, every asset comes after the assets it pulled in
+		const std::vector<std::shared_ptr<asset_interface>>& get_assets() const;
+
 		void build(zone_buffer* buf) override;
 	};
 }
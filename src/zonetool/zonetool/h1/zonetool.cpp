@@ -1,10 +1,14 @@
 #include <std_include.hpp>
 #include "zonetool.hpp"
 
+#include "component/h1/fastfiles.hpp"
+
 #include "converter/converter.hpp"
 
 #include "../utils/gsc.hpp"
 #include "../utils/csv_generator.hpp"
+#include "../utils/benchmark.hpp"
+#include "../utils/profiler.hpp"
 
 #include <utils/io.hpp>
 
@@ -18,10 +22,25 @@ namespace zonetool::h1
 		std::unordered_set<XAssetType> filter;
 	};
 
+	struct zone_dump_request
+	{
+		std::string zone;
+		bool dump;
+		std::unordered_set<XAssetType> filter;
+		std::string fastfile;
+	};
+
 	zonetool_globals_t globals{};
 	std::vector<std::pair<XAssetType, std::string>> referenced_assets;
 	std::unordered_set<XAssetType> asset_type_filter;
 
+	// zones queued by dump_zones, the front entry is the zone the database is currently loading.
+	// the finish hook pops it, only access it through globals.load_finished.access
+	std::deque<zone_dump_request> zone_dump_queue;
+
+	// reflection probe pixels copied out of the temp block, kept alive until the zone finished dumping
+	std::vector<std::pair<GfxImage*, std::unique_ptr<std::uint8_t[]>>> reflection_probe_pixels;
+
 	std::unordered_set<std::pair<std::uint32_t, std::string>, pair_hash<std::uint32_t, std::string>> ignore_assets;
 
 	const char* get_asset_name(XAssetType type, void* pointer)
@@ -81,10 +100,15 @@ namespace zonetool::h1
 		return false;
 	}
 
+	bool is_database_ready()
+	{
+		return WaitForSingleObject(*reinterpret_cast<HANDLE*>(0x149811020), 0) == WAIT_OBJECT_0;
+	}
+
 	void wait_for_database()
 	{
 		// wait for database to be ready
-		while (!WaitForSingleObject(*reinterpret_cast<HANDLE*>(0x149811020), 0) == 0)
+		while (!is_database_ready())
 		{
 			Sleep(5);
 		}
@@ -515,9 +539,20 @@ namespace zonetool::h1
 			return;
 		}
 
+		// dumpers read temp block data and the current stream file, both are only valid during the link
 		dump_func->second(asset);
 	}
 
+	void release_reflection_probe_pixels()
+	{
+		for (auto& [image, pixels] : reflection_probe_pixels)
+		{
+			image->pixelData = nullptr;
+		}
+
+		reflection_probe_pixels.clear();
+	}
+
 	void dump_refs()
 	{
 		// remove duplicates
@@ -580,6 +615,8 @@ namespace zonetool::h1
 
 		dump_refs();
 
+		release_reflection_probe_pixels();
+
 		ZONETOOL_INFO("Zone \"%s\" dumped.", filesystem::get_fastfile().data());
 
 		globals.dump = false;
@@ -602,21 +639,13 @@ namespace zonetool::h1
 			if (globals.dump && globals.target_game == game::game_mode::iw7 && 
 				std::string(asset->name).find("*reflection_probe") != std::string::npos)
 			{
-				constexpr auto buffer_size = 1024 * 1024 * 32; // 32mb
-				static std::uint8_t pixel_buffer[buffer_size];
-				static std::uint32_t pixel_buffer_index = 0;
-
-				if (pixel_buffer_index + asset->dataLen1 >= buffer_size)
-				{
-					ZONETOOL_FATAL("reflection probe pixeldata buffer is full...");
-				}
-
-				memcpy(&pixel_buffer[pixel_buffer_index], asset->pixelData, asset->dataLen1);
+				auto pixels = std::make_unique<std::uint8_t[]>(asset->dataLen1);
+				memcpy(pixels.get(), asset->pixelData, asset->dataLen1);
 
 				auto ret = db_link_x_asset_entry1_hook.invoke<XAssetEntry*>(type, header);
-				ret->asset.header.image->pixelData = &pixel_buffer[pixel_buffer_index];
+				ret->asset.header.image->pixelData = pixels.get();
 
-				pixel_buffer_index += asset->dataLen1;
+				reflection_probe_pixels.emplace_back(ret->asset.header.image, std::move(pixels));
 
 				//dump_asset(&xasset); // gfxworld generates reflection_probe array, no need to dump
 
@@ -629,10 +658,53 @@ namespace zonetool::h1
 		return db_link_x_asset_entry1_hook.invoke<XAssetEntry*>(type, header);
 	}
 
+	void begin_queued_zone(const zone_dump_request& request)
+	{
+		asset_type_filter = request.filter;
+		filesystem::set_fastfile(request.fastfile);
+
+		globals.dump = request.dump;
+		globals.dump_csv = request.dump;
+
+		if (request.dump)
+		{
+			ZONETOOL_INFO("Dumping zone \"%s\"...", request.zone.data());
+		}
+	}
+
 	utils::hook::detour db_finish_load_x_file_hook;
 	void db_finish_load_x_file()
 	{
+		const auto zone = ::h1::fastfiles::get_current_fastfile();
+		if (!globals.load_finished.is_awaited(zone))
+		{
+			return db_finish_load_x_file_hook.invoke<void>();
+		}
+
 		stop_dumping();
+
+		// the next queued zone is already requested, arm the dump state before the database links its first asset
+		const auto next = globals.load_finished.access([]() -> std::optional<zone_dump_request>
+		{
+			if (!zone_dump_queue.empty())
+			{
+				zone_dump_queue.pop_front();
+			}
+
+			if (zone_dump_queue.empty())
+			{
+				return {};
+			}
+
+			return zone_dump_queue.front();
+		});
+
+		if (next.has_value())
+		{
+			begin_queued_zone(next.value());
+		}
+
+		globals.load_finished.signal(zone);
 		return db_finish_load_x_file_hook.invoke<void>();
 	}
 
@@ -661,6 +733,19 @@ namespace zonetool::h1
 		reallocate_asset_pool(type, multiplier * g_poolSize[type]);
 	}
 
+	bool is_zone_loaded(const std::string& name)
+	{
+		for (auto i = 0u; i < *g_zoneCount; i++)
+		{
+			if (!_strnicmp(g_zones[i + 1].name, name.data(), 64))
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
 	bool load_zone(const std::string& name, DBSyncMode mode = DB_LOAD_SYNC, bool inform = true)
 	{
 		if (!zone_exists(name.data()))
@@ -671,19 +756,13 @@ namespace zonetool::h1
 
 		wait_for_database();
 
-		if (!globals.dump && !globals.verify)
+		if (!globals.dump && !globals.verify && is_zone_loaded(name))
 		{
-			for (auto i = 0u; i < *g_zoneCount; i++)
+			if (inform)
 			{
-				if (!_strnicmp(g_zones[i + 1].name, name.data(), 64))
-				{
-					if (inform)
-					{
-						ZONETOOL_INFO("Zone \"%s\" is already loaded...", name.data());
-					}
-					return false;
-				}
+				ZONETOOL_INFO("Zone \"%s\" is already loaded...", name.data());
 			}
+			return false;
 		}
 
 		if (inform)
@@ -706,6 +785,28 @@ namespace zonetool::h1
 		ZONETOOL_INFO("Unloaded zones...");
 	}
 
+	// a zone that fails to load never reaches the finish hook, reset the dump state instead of waiting forever
+	bool wait_for_zone_load(const std::string& name)
+	{
+		const auto finished = globals.load_finished.wait(is_database_ready);
+
+		const auto pending = globals.load_finished.access([&]
+		{
+			const auto zone = zone_dump_queue.empty() ? name : zone_dump_queue.front().zone;
+			zone_dump_queue.clear();
+			return zone;
+		});
+
+		if (finished)
+		{
+			return true;
+		}
+
+		ZONETOOL_ERROR("Zone \"%s\" did not finish loading", pending.data());
+		stop_dumping();
+		return false;
+	}
+
 	void dump_zone(const std::string& name, const game::game_mode target, const std::optional<std::string> fastfile = {})
 	{
 		if (!zone_exists(name.data()))
@@ -730,17 +831,16 @@ namespace zonetool::h1
 
 		globals.dump = true;
 		globals.dump_csv = true;
+		globals.load_finished.arm(name);
 		if (!load_zone(name, DB_LOAD_ASYNC, false))
 		{
 			globals.dump = false;
 			globals.dump_csv = false;
+			globals.load_finished.cancel();
 			return;
 		}
 
-		while (globals.dump)
-		{
-			Sleep(1);
-		}
+		wait_for_zone_load(name);
 	}
 
 	void dump_csv(const std::string& name)
@@ -758,15 +858,17 @@ namespace zonetool::h1
 		filesystem::set_fastfile(name);
 
 		globals.dump_csv = true;
+		globals.load_finished.arm(name);
 		if (!load_zone(name, DB_LOAD_ASYNC, true))
 		{
 			globals.dump_csv = false;
+			globals.load_finished.cancel();
 			return;
 		}
 
-		while (globals.dump_csv)
+		if (!wait_for_zone_load(name))
 		{
-			Sleep(1);
+			return;
 		}
 
 		ZONETOOL_INFO("Csv \"%s\" dumped...", name.data());
@@ -783,16 +885,78 @@ namespace zonetool::h1
 		wait_for_database();
 
 		globals.verify = true;
+		globals.load_finished.arm(name);
 		if (!load_zone(name, DB_LOAD_ASYNC, true))
 		{
 			globals.verify = false;
+			globals.load_finished.cancel();
+			return;
+		}
+
+		wait_for_zone_load(name);
+	}
+
+	// queues all zones in one DB_LoadXAssets request so the database doesn't idle between them.
+	// each zone is still dumped while it links, the next one only starts loading after its finish hook
+	void dump_zones(const std::vector<zone_dump_request>& requests, const game::game_mode target,
+		const std::optional<std::string> fastfile = {})
+	{
+		std::vector<zone_dump_request> existing;
+		for (const auto& request : requests)
+		{
+			if (!zone_exists(request.zone.data()))
+			{
+				ZONETOOL_INFO("Zone \"%s\" could not be found!", request.zone.data());
+				continue;
+			}
+
+			existing.emplace_back(request);
+		}
+
+		wait_for_database();
+
+		// zones only loaded for their assets are skipped when they're already in memory, like load_zone does
+		std::erase_if(existing, [](const zone_dump_request& request)
+		{
+			if (request.dump || !is_zone_loaded(request.zone))
+			{
+				return false;
+			}
+
+			ZONETOOL_INFO("Zone \"%s\" is already loaded...", request.zone.data());
+			return true;
+		});
+
+		if (existing.empty())
+		{
 			return;
 		}
 
-		while (globals.verify)
+		globals.target_game = target;
+
+		std::vector<std::string> names;
+		std::vector<XZoneInfo> zones;
+		names.reserve(existing.size());
+		zones.reserve(existing.size());
+		for (auto& request : existing)
 		{
-			Sleep(1);
+			request.fastfile = fastfile.value_or(request.zone);
+			names.emplace_back(request.zone);
+			zones.push_back({request.zone.data(), DB_ZONE_GAME | DB_ZONE_CUSTOM, 0});
 		}
+
+		globals.load_finished.access([&]
+		{
+			zone_dump_queue.assign(existing.begin(), existing.end());
+		});
+
+		begin_queued_zone(existing.front());
+
+		globals.load_finished.arm(names);
+		DB_LoadXAssets(zones.data(), static_cast<unsigned int>(zones.size()), DB_LOAD_ASYNC);
+		wait_for_zone_load(existing.front().zone);
+
+		asset_type_filter.clear();
 	}
 
 	void add_assets_using_iterator(const std::string& fastfile, const std::string& type, const std::string& folder,
@@ -1123,6 +1287,7 @@ namespace zonetool::h1
 	{
 		material::fixed_nml_images_map.clear();
 		techset::vertexdecl_pointers.clear();
+		techset::clear_sidecar_cache();
 		xanim_parts::secondary_anims.clear();
 
 		map_ents::clear_entity_strings();
@@ -1145,28 +1310,158 @@ namespace zonetool::h1
 			return;
 		}
 
-		try
-		{
-			parse_csv_file(zone.get(), fastfile, fastfile);
-		}
-		catch (std::exception& ex)
+		profiler::begin(fastfile);
+
 		{
-			ZONETOOL_FATAL("%s", ex.what());
+			profiler::scope _("phase", "parse");
+
+			try
+			{
+				parse_csv_file(zone.get(), fastfile, fastfile);
+			}
+			catch (std::exception& ex)
+			{
+				ZONETOOL_FATAL("%s", ex.what());
+			}
+
+			// add branding asset
+			zone->add_asset_of_type("rawfile", fastfile);
 		}
 
 		// allocate zone buffer
 		auto buffer = alloc_buffer();
 
-		// add branding asset
-		zone->add_asset_of_type("rawfile", fastfile);
-
 		// compile zone
 		zone->build(buffer.get());
 
+		profiler::end();
+		log::flush();
+
 		ignore_assets.clear();
 		clear_asset_fields();
 	}
 
+	// loads the csv roots through load_depending without writing a zone
+	std::vector<csv_generator::asset_entry> scan_map_dependencies(const std::string& map, const std::vector<csv_generator::asset_entry>& roots)
+	{
+		filesystem::set_fastfile(map);
+
+		ignore_assets.clear();
+		clear_asset_fields();
+
+		const auto zone = std::make_shared<zone_interface>(map);
+		for (const auto& [type, name] : roots)
+		{
+			zone->add_asset_of_type(type, name);
+		}
+
+		std::vector<csv_generator::asset_entry> assets;
+		for (const auto& asset : zone->get_assets())
+		{
+			auto name = asset->name();
+			if (name.starts_with(","))
+			{
+				continue;
+			}
+
+			assets.emplace_back(type_to_string(XAssetType(asset->type())), std::move(name));
+		}
+
+		clear_asset_fields();
+		return assets;
+	}
+
+	bool benchmark_zone(const std::string& fastfile, const std::size_t iterations)
+	{
+		const benchmark::settings settings{};
+		benchmark::write_sources(fastfile, settings);
+
+		const benchmark::asset_types types =
+		{
+			ASSET_TYPE_RAWFILE,
+			ASSET_TYPE_STRINGTABLE,
+			ASSET_TYPE_LOCALIZE_ENTRY,
+			ASSET_TYPE_SCRIPTFILE,
+			ASSET_TYPE_IMAGE,
+		};
+
+		auto valid = true;
+		for (auto i = 0u; i < iterations; i++)
+		{
+			const auto start = std::chrono::steady_clock::now();
+
+			profiler::begin(fastfile, true);
+			build_zone(fastfile);
+			profiler::end();
+
+			const auto total = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+			valid &= benchmark::verify_and_report(fastfile, settings, types, total);
+		}
+
+		return valid;
+	}
+
+	// builds the zone in csv order and then sorted, the sorted fastfile is the one left on disk
+	void compare_asset_order(const std::string& fastfile)
+	{
+		struct result
+		{
+			std::size_t size;
+			double compress_msec;
+		};
+
+		const auto build = [&](const bool sorted) -> std::optional<result>
+		{
+			asset_order::set_enabled(sorted);
+
+			profiler::begin(fastfile, true);
+			build_zone(fastfile);
+			profiler::end();
+
+			std::string file;
+			if (!utils::io::read_file(filesystem::get_zone_path(fastfile + ".ff") + fastfile + ".ff", &file))
+			{
+				return {};
+			}
+
+			result measured{file.size(), 0.0};
+			for (const auto& phase : profiler::get_phases())
+			{
+				if (phase.name == "compress")
+				{
+					measured.compress_msec = phase.msec;
+				}
+			}
+
+			return measured;
+		};
+
+		const auto csv_order = build(false);
+		const auto sorted = build(true);
+		asset_order::set_enabled({});
+
+		if (!csv_order || !sorted)
+		{
+			ZONETOOL_ERROR("Could not read back \"%s.ff\"", fastfile.data());
+			return;
+		}
+
+		const auto get_change = [](const double before, const double after)
+		{
+			return before > 0.0 ? (after - before) / before * 100.0 : 0.0;
+		};
+
+		ZONETOOL_INFO("Asset order for \"%s\":", fastfile.data());
+		log::flush();
+
+		printf("  %-8s %14s %14s\n", "order", "fastfile", "compress msec");
+		printf("  %-8s %14zu %14.2f\n", "csv", csv_order->size, csv_order->compress_msec);
+		printf("  %-8s %14zu %14.2f\n", "sorted", sorted->size, sorted->compress_msec);
+		printf("  size %+.2f%%, compress time %+.2f%%\n",
+			get_change(static_cast<double>(csv_order->size), static_cast<double>(sorted->size)),
+			get_change(csv_order->compress_msec, sorted->compress_msec));
+	}
+
 	void register_commands()
 	{
 		::h1::command::add("quit", []()
@@ -1185,6 +1480,23 @@ namespace zonetool::h1
 			build_zone(params.get(1));
 		});
 
+		::h1::command::add("compareorder", [](const ::h1::command::params& params)
+		{
+			if (params.size() != 2)
+			{
+				ZONETOOL_ERROR("usage: compareorder <zone>");
+				return;
+			}
+
+			compare_asset_order(params.get(1));
+		});
+
+		::h1::command::add("benchmarkzone", [](const ::h1::command::params& params)
+		{
+			const auto iterations = params.size() >= 2 ? std::max(1, std::atoi(params.get(1))) : 1;
+			benchmark_zone("zonetool_benchmark", static_cast<std::size_t>(iterations));
+		});
+
 		::h1::command::add("loadzone", [](const ::h1::command::params& params)
 		{
 			if (params.size() != 2)
@@ -1387,18 +1699,6 @@ namespace zonetool::h1
 				return;
 			}
 
-			const auto dump_zone_ = [&](const std::string& zone, 
-				const std::optional<std::unordered_set<XAssetType>>& filter = {})
-			{
-				asset_type_filter.clear();
-				if (filter.has_value())
-				{
-					asset_type_filter = filter.value();
-				}
-
-				dump_zone(zone, dump_params.target, {dump_params.zone});
-			};
-
 			auto skip_common = false;
 			if (params.size() >= 5)
 			{
@@ -1423,40 +1723,27 @@ namespace zonetool::h1
 			unload_zones();
 
 			auto zone_postfix = "";
-			auto is_mp = false;
 			if (dump_params.zone.starts_with("mp_"))
 			{
 				zone_postfix = "_mp";
-				is_mp = true;
 			}
 
-			std::vector<std::pair<std::string, std::unordered_set<XAssetType>>> common_zones =
+			std::vector<zone_dump_request> requests =
 			{
-				{"code_post_gfx"s + zone_postfix, techset_filter},
-				{"techsets_common"s + zone_postfix, techset_filter},
-				{"common"s + zone_postfix, common_filter},
-				{"patch_common"s + zone_postfix, common_filter},
-				{"techsets_common_core_mp", techset_filter},
+				{"code_post_gfx"s + zone_postfix, !skip_common, techset_filter},
+				{"techsets_common"s + zone_postfix, !skip_common, techset_filter},
+				{"common"s + zone_postfix, !skip_common, common_filter},
+				{"patch_common"s + zone_postfix, !skip_common, common_filter},
+				{"techsets_common_core_mp", !skip_common, techset_filter},
+				{"techsets_" + dump_params.zone, true, dump_params.filter},
+				{"eng_patch_" + dump_params.zone, true, dump_params.filter},
+				{"patch_" + dump_params.zone, true, dump_params.filter},
+				{dump_params.zone + "_path", true, dump_params.filter},
+				{dump_params.zone + "_load", true, dump_params.filter},
+				{dump_params.zone, true, {}},
 			};
 
-			for (const auto& zone : common_zones)
-			{
-				if (skip_common)
-				{
-					load_zone(zone.first);
-				}
-				else
-				{
-					dump_zone_(zone.first, zone.second);
-				}
-			}
-
-			dump_zone_("techsets_" + dump_params.zone, dump_params.filter);
-			dump_zone_("eng_patch_" + dump_params.zone, dump_params.filter);
-			dump_zone_("patch_" + dump_params.zone, dump_params.filter);
-			dump_zone_(dump_params.zone + "_path", dump_params.filter);
-			dump_zone_(dump_params.zone + "_load", dump_params.filter);
-			dump_zone_(dump_params.zone);
+			dump_zones(requests, dump_params.target, {dump_params.zone});
 
 			ZONETOOL_INFO("Map \"%s\" dumped", dump_params.zone.data());
 		});
@@ -1466,7 +1753,7 @@ namespace zonetool::h1
 			<::h1::command::params>([](const uint32_t id)
 		{
 			return gsc::h1::gsc_ctx->token_name(id);
-		}));
+		}, scan_map_dependencies));
 	}
 
 	std::vector<std::string> get_command_line_arguments()
@@ -1532,6 +1819,15 @@ namespace zonetool::h1
 
 						i++;
 					}
+					else if (args[i] == "-benchmarkzone")
+					{
+						// non zero exit code when the round trip fails so it can run unattended
+						if (!benchmark_zone("zonetool_benchmark", static_cast<std::size_t>(std::max(1, std::atoi(args[i + 1].data())))))
+						{
+							std::quick_exit(EXIT_FAILURE);
+						}
+						i++;
+					}
 					else if (args[i] == "-verifyzone")
 					{
 						verify_zone(args[i + 1]);
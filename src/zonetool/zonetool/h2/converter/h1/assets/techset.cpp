@@ -515,27 +515,24 @@ namespace zonetool::h2
 				return converted_args;
 			}
 
+			unsigned int remap_dest_reference(unsigned int dest)
+			{
+				return static_cast<unsigned int>(convert_dest(static_cast<unsigned short>(dest)));
+			}
+
 			unsigned char* convert_shader_program(unsigned char* program, unsigned int program_size,
-				utils::memory::allocator& allocator)
+				unsigned int* crc32, utils::memory::allocator& allocator)
 			{
 				if (program == nullptr)
 				{
 					return program;
 				}
 
-				const auto new_program = allocator.allocate_array<unsigned char>(program_size);
-				std::memcpy(new_program, program, program_size);
-
-				const auto offsets = ::shader::get_dest_reference_offsets(new_program, program_size);
-				for (const auto& offset : offsets)
-				{
-					const auto dest = reinterpret_cast<unsigned int*>(new_program + offset);
-					*dest = static_cast<unsigned int>(convert_dest(static_cast<unsigned short>(*dest)));
-				}
+				const auto& converted = ::shader::remap_dest_references(program, program_size, remap_dest_reference);
+				*crc32 = converted.crc32;
 
-				const auto checksum = ::shader::generate_checksum(new_program, program_size);
-				const auto header = reinterpret_cast<::shader::dx11_shader_header*>(new_program);
-				std::memcpy(header->checksum, &checksum, sizeof(::shader::shader_checksum));
+				const auto new_program = allocator.allocate_array<unsigned char>(program_size);
+				std::memcpy(new_program, converted.program.data(), program_size);
 
 				return new_program;
 			}
@@ -548,13 +545,13 @@ namespace zonetool::h2
 
 				if constexpr (ShaderType != none)
 				{
-					new_shader->prog.loadDef.program =
-						convert_shader_program(new_shader->prog.loadDef.program, new_shader->prog.loadDef.programSize, allocator);
+					unsigned int crc32{};
+					new_shader->prog.loadDef.program = convert_shader_program(new_shader->prog.loadDef.program,
+						new_shader->prog.loadDef.programSize, &crc32, allocator);
 
 					if constexpr (ShaderType == pixelshader || ShaderType == vertexshader)
 					{
-						new_shader->prog.loadDef.microCodeCrc = ::shader::calc_crc32(
-							new_shader->prog.loadDef.program, new_shader->prog.loadDef.programSize);
+						new_shader->prog.loadDef.microCodeCrc = crc32;
 					}
 				}
 
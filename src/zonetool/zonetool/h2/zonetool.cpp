@@ -1,6 +1,8 @@
 #include <std_include.hpp>
 #include "zonetool.hpp"
 
+#include "component/h2/fastfiles.hpp"
+
 #include "zonetool/h1/zonetool.hpp"
 
 #include "converter/converter.hpp"
@@ -8,6 +10,7 @@
 #include "../utils/mapents.hpp"
 #include "../utils/gsc.hpp"
 #include "../utils/csv_generator.hpp"
+#include "../utils/profiler.hpp"
 
 #include <utils/io.hpp>
 
@@ -84,10 +87,15 @@ namespace zonetool::h2
 		return false;
 	}
 
+	bool is_database_ready()
+	{
+		return WaitForSingleObject(*reinterpret_cast<HANDLE*>(0x14B11DEB8), 0) == WAIT_OBJECT_0;
+	}
+
 	void wait_for_database()
 	{
 		// wait for database to be ready
-		while (!WaitForSingleObject(*reinterpret_cast<HANDLE*>(0x14B11DEB8), 0) == 0)
+		while (!is_database_ready())
 		{
 			Sleep(5);
 		}
@@ -405,8 +413,15 @@ namespace zonetool::h2
 	utils::hook::detour db_finish_load_x_file_hook;
 	void db_finish_load_x_file_stub()
 	{
+		const auto zone = ::h2::fastfiles::get_current_fastfile();
+		if (!globals.load_finished.is_awaited(zone))
+		{
+			return db_finish_load_x_file_hook.invoke<void>();
+		}
+
 		globals.verify = false;
 		stop_dumping();
+		globals.load_finished.signal(zone);
 		return db_finish_load_x_file_hook.invoke<void>();
 	}
 
@@ -479,6 +494,19 @@ namespace zonetool::h2
 		ZONETOOL_INFO("Unloaded zones...");
 	}
 
+	// a zone that fails to load never reaches the finish hook, reset the dump state instead of waiting forever
+	bool wait_for_zone_load(const std::string& name)
+	{
+		if (globals.load_finished.wait(is_database_ready))
+		{
+			return true;
+		}
+
+		ZONETOOL_ERROR("Zone \"%s\" did not finish loading", name.data());
+		stop_dumping();
+		return false;
+	}
+
 	void dump_zone(const std::string& name, const game::game_mode target, const std::optional<std::string> fastfile = {})
 	{
 		if (!zone_exists(name.data()))
@@ -501,16 +529,19 @@ namespace zonetool::h2
 			filesystem::set_fastfile(name);
 		}
 
+		// converted shader programs are only shared within one dump
+		::shader::clear_remap_cache();
+
 		globals.dump = true;
+		globals.load_finished.arm(name);
 		if (!load_zone(name, DB_LOAD_ASYNC, false))
 		{
 			globals.dump = false;
+			globals.load_finished.cancel();
+			return;
 		}
 
-		while (globals.dump)
-		{
-			Sleep(1);
-		}
+		wait_for_zone_load(name);
 	}
 
 	void verify_zone(const std::string& name)
@@ -524,15 +555,15 @@ namespace zonetool::h2
 		wait_for_database();
 
 		globals.verify = true;
+		globals.load_finished.arm(name);
 		if (!load_zone(name, DB_LOAD_ASYNC, true))
 		{
 			globals.verify = false;
+			globals.load_finished.cancel();
+			return;
 		}
 
-		while (globals.verify)
-		{
-			Sleep(1);
-		}
+		wait_for_zone_load(name);
 	}
 
 	void add_assets_using_iterator(const std::string& fastfile, const std::string& type, const std::string& folder,
@@ -753,7 +784,12 @@ namespace zonetool::h2
 			return;
 		}
 
-		parse_csv_file(zone.get(), fastfile, fastfile);
+		profiler::begin(fastfile);
+
+		{
+			profiler::scope _("phase", "parse");
+			parse_csv_file(zone.get(), fastfile, fastfile);
+		}
 
 		// allocate zone buffer
 		auto buffer = alloc_buffer();
@@ -764,6 +800,9 @@ namespace zonetool::h2
 		// compile zone
 		zone->build(buffer.get());
 
+		profiler::end();
+		log::flush();
+
 		// clear asset shit
 		material::fixed_nml_images_map.clear();
 		techset::vertexdecl_pointers.clear();
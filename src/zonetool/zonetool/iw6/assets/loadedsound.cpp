@@ -1,7 +1,7 @@
 #include <std_include.hpp>
 #include "loadedsound.hpp"
 
-#include <utils/bit_buffer.hpp>
+#include <utils/bit_reader.hpp>
 
 #define SIZEOF_SNDFILE_WAVE_HEADER 46
 
@@ -151,7 +151,7 @@ namespace zonetool::iw6
 				{
 					verify_streaminfo_block(block);
 
-					utils::bit_buffer buffer({block.data, static_cast<size_t>(block.header.length)});
+					utils::bit_reader_be buffer(block.data, static_cast<size_t>(block.header.length));
 
 					info->sampleRate = buffer.read_bits<unsigned int>(80, 20);
 					info->channels = buffer.read_bits<char>(100, 3) + 1;
@@ -4,6 +4,10 @@
 
 #include "zonetool/h1/assets/xsurface.hpp"
 
+#include "zonetool/utils/vertex_convert.hpp"
+
+#include <utils/flags.hpp>
+
 namespace zonetool::iw6
 {
 	namespace converter::h1
@@ -42,30 +46,15 @@ namespace zonetool::iw6
 
 					REINTERPRET_CAST_SAFE(surfs[i].triIndices);
 					new_surf->triIndices2 = allocator.allocate_array<zonetool::h1::Face>(surf->triCount); // ?
-					for (unsigned short j = 0; j < surf->triCount; j++)
-					{
-						memcpy(&new_surf->triIndices2[j], &surf->triIndices[j], sizeof(zonetool::h1::Face));
-					}
+					memcpy(new_surf->triIndices2, surf->triIndices, sizeof(zonetool::h1::Face) * surf->triCount);
+
+					static_assert(sizeof(zonetool::h1::GfxPackedVertex) == sizeof(vertex_convert::packed_vertex));
+					static_assert(sizeof(zonetool::h1::GfxPackedMotionVertex) == sizeof(vertex_convert::packed_vertex));
 
-					// unknown
+					// unknown, motion verts keep position and normal at the same offsets
 					new_surf->unknown0 = allocator.allocate_array<zonetool::h1::UnknownXSurface0>(surf->vertCount); // related to indices2?
-					for (unsigned short j = 0; j < surf->vertCount; j++)
-					{
-						if ((surf->flags & 8) != 0)
-						{
-							new_surf->unknown0[j].xyz[0] = new_surf->verts0.packedMotionVerts0[j].xyz[0];
-							new_surf->unknown0[j].xyz[1] = new_surf->verts0.packedMotionVerts0[j].xyz[1];
-							new_surf->unknown0[j].xyz[2] = new_surf->verts0.packedMotionVerts0[j].xyz[2];
-							new_surf->unknown0[j].normal = new_surf->verts0.packedMotionVerts0[j].normal;
-						}
-						else
-						{
-							new_surf->unknown0[j].xyz[0] = new_surf->verts0.packedVerts0[j].xyz[0];
-							new_surf->unknown0[j].xyz[1] = new_surf->verts0.packedVerts0[j].xyz[1];
-							new_surf->unknown0[j].xyz[2] = new_surf->verts0.packedVerts0[j].xyz[2];
-							new_surf->unknown0[j].normal = new_surf->verts0.packedVerts0[j].normal;
-						}
-					}
+					vertex_convert::extract_position_normals(reinterpret_cast<vertex_convert::position_normal*>(new_surf->unknown0),
+						reinterpret_cast<const vertex_convert::packed_vertex*>(new_surf->verts0.packedVerts0), surf->vertCount);
 
 					REINTERPRET_CAST_SAFE(surfs[i].rigidVertLists);
 
@@ -76,12 +65,7 @@ namespace zonetool::iw6
 					if (surf->lmapUnwrap)
 					{
 						new_surf->lmapUnwrap = allocator.allocate_array<zonetool::h1::alignVertBufFloat16Vec2_t>(surf->vertCount);
-						for (int j = 0; j < surf->vertCount; j++)
-						{
-							// check (float -> short)
-							new_surf->lmapUnwrap[j][0] = static_cast<unsigned short>(surf->lmapUnwrap[j][0]);
-							new_surf->lmapUnwrap[j][1] = static_cast<unsigned short>(surf->lmapUnwrap[j][1]);
-						}
+						vertex_convert::floats_to_halves(new_surf->lmapUnwrap[0], surf->lmapUnwrap[0], 2 * surf->vertCount);
 					}
 					
 					REINTERPRET_CAST_SAFE(surfs[i].subdiv);
@@ -98,6 +82,14 @@ namespace zonetool::iw6
 
 				COPY_ARR(partBits);
 
+				if (utils::flags::has_flag("optimizemeshes"))
+				{
+					zonetool::h1::xsurface::optimize(new_asset, [&](const std::size_t size)
+					{
+						return allocator.allocate_array<char>(size);
+					});
+				}
+
 				return new_asset;
 			}
 
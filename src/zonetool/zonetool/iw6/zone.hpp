@@ -9,6 +9,7 @@ namespace zonetool::iw6
 		std::string name_;
 		std::vector<std::shared_ptr<asset_interface>> m_assets;
 		std::shared_ptr<zone_memory> m_zonemem;
+		asset_order::dependencies m_dependencies;
 
 	public:
 		zone_interface(std::string name);
@@ -19,11 +20,14 @@ namespace zonetool::iw6
 		void* get_asset_pointer(std::int32_t type, const std::string& name) override;
 
 		void add_asset_of_type_by_pointer(std::int32_t type, void* pointer) override;
+		void add_assets_of_type_by_pointer(std::int32_t type, const std::vector<void*>& pointers) override;
 
 		void add_asset_of_type(std::int32_t type, const std::string& name) override;
 		void add_asset_of_type(const std::string& type, const std::string& name) override;
 		std::int32_t get_type_by_name(const std::string& type) override;
 
+		zone_memory* get_memory() override;
+
 		void build(zone_buffer* buf) override;
 	};
 }
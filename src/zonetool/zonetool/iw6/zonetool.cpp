@@ -1,6 +1,8 @@
 #include <std_include.hpp>
 #include "zonetool.hpp"
 
+#include "component/iw6/fastfiles.hpp"
+
 #include <utils/io.hpp>
 
 #include "zonetool/h1/zonetool.hpp"
@@ -11,6 +13,7 @@
 
 #include "../utils/gsc.hpp"
 #include "../utils/csv_generator.hpp"
+#include "../utils/profiler.hpp"
 
 namespace zonetool::iw6
 {
@@ -71,10 +74,15 @@ namespace zonetool::iw6
 		return false;
 	}
 
+	bool is_database_ready()
+	{
+		return WaitForSingleObject(*reinterpret_cast<HANDLE*>(0x1446B4B48), 0) == WAIT_OBJECT_0;
+	}
+
 	void wait_for_database()
 	{
 		// wait for database to be ready
-		while (!WaitForSingleObject(*reinterpret_cast<HANDLE*>(0x1446B4B48), 0) == 0)
+		while (!is_database_ready())
 		{
 			Sleep(5);
 		}
@@ -495,8 +503,15 @@ namespace zonetool::iw6
 	utils::hook::detour db_finish_load_x_file_hook;
 	void db_finish_load_x_file_stub()
 	{
+		const auto zone = ::iw6::fastfiles::get_current_fastfile();
+		if (!globals.load_finished.is_awaited(zone))
+		{
+			return db_finish_load_x_file_hook.invoke<void>();
+		}
+
 		globals.verify = false;
 		stop_dumping();
+		globals.load_finished.signal(zone);
 		return db_finish_load_x_file_hook.invoke<void>();
 	}
 
@@ -569,6 +584,19 @@ namespace zonetool::iw6
 		ZONETOOL_INFO("Unloaded zones...");
 	}
 
+	// a zone that fails to load never reaches the finish hook, reset the dump state instead of waiting forever
+	bool wait_for_zone_load(const std::string& name)
+	{
+		if (globals.load_finished.wait(is_database_ready))
+		{
+			return true;
+		}
+
+		ZONETOOL_ERROR("Zone \"%s\" did not finish loading", name.data());
+		stop_dumping();
+		return false;
+	}
+
 	void dump_zone(const std::string& name, const game::game_mode target)
 	{
 		if (!zone_exists(name.data()))
@@ -584,15 +612,15 @@ namespace zonetool::iw6
 
 		filesystem::set_fastfile(name);
 		globals.dump = true;
+		globals.load_finished.arm(name);
 		if (!load_zone(name, DB_LOAD_ASYNC, false))
 		{
 			globals.dump = false;
+			globals.load_finished.cancel();
+			return;
 		}
 
-		while (globals.dump)
-		{
-			Sleep(1);
-		}
+		wait_for_zone_load(name);
 	}
 
 	void verify_zone(const std::string& name)
@@ -606,15 +634,15 @@ namespace zonetool::iw6
 		wait_for_database();
 
 		globals.verify = true;
+		globals.load_finished.arm(name);
 		if (!load_zone(name, DB_LOAD_ASYNC, true))
 		{
 			globals.verify = false;
+			globals.load_finished.cancel();
+			return;
 		}
 
-		while (globals.verify)
-		{
-			Sleep(1);
-		}
+		wait_for_zone_load(name);
 	}
 
 	void add_assets_using_iterator(const std::string& fastfile, const std::string& type, const std::string& folder,
@@ -828,8 +856,11 @@ namespace zonetool::iw6
 			return;
 		}
 
+		profiler::begin(fastfile);
+
 		try
 		{
+			profiler::scope _("phase", "parse");
 			parse_csv_file(zone.get(), fastfile, fastfile);
 		}
 		catch (std::exception& ex)
@@ -846,6 +877,9 @@ namespace zonetool::iw6
 		// compile zone
 		zone->build(buffer.get());
 
+		profiler::end();
+		log::flush();
+
 		// clear asset shit
 		material::fixed_nml_images_map.clear();
 		techset::vertexdecl_pointers.clear();
@@ -3,8 +3,10 @@
 
 #include "../common/sound.hpp"
 
+#include "zonetool/utils/hash_index.hpp"
+
 #include "utils/io.hpp"
-#include "utils/bit_buffer.hpp"
+#include "utils/bit_reader.hpp"
 
 namespace zonetool::iw7
 {
@@ -15,7 +17,7 @@ namespace zonetool::iw7
 
 	namespace aliases
 	{
-		std::string LOAD_TYPES[] =
+		constexpr std::string_view LOAD_TYPES[] =
 		{
 			"loaded",
 			"rev_vehicle",
@@ -24,7 +26,7 @@ namespace zonetool::iw7
 			"primed",
 		};
 
-		std::string LOOP_TYPES[] =
+		constexpr std::string_view LOOP_TYPES[] =
 		{
 			"nonlooping",
 			"looping",
@@ -32,21 +34,21 @@ namespace zonetool::iw7
 			"rlooping",
 		};
 
-		std::string MUSIC_CONTENT[] =
+		constexpr std::string_view MUSIC_CONTENT[] =
 		{
 			"none",
 			"music",
 			"licensed",
 		};
 
-		std::string GPAD_OUTPUT[] =
+		constexpr std::string_view GPAD_OUTPUT[] =
 		{
 			"none",
 			"ifavailable",
 			"controlleronly",
 		};
 
-		std::string SHAPES[] =
+		constexpr std::string_view SHAPES[] =
 		{
 			"disc",
 			"donut",
@@ -56,13 +58,13 @@ namespace zonetool::iw7
 			"donut_flat_middle",
 		};
 
-		std::string FULLDRYLEVEL[] =
+		constexpr std::string_view FULLDRYLEVEL[] =
 		{
 			"",
 			"fulldrylevel"
 		};
 
-		std::string SND_ALIAS_FIELDS[] =
+		constexpr std::string_view SND_ALIAS_FIELDS[] =
 		{
 			"Name",
 			"SecondaryAliasName",
@@ -119,6 +121,14 @@ namespace zonetool::iw7
 			"masterSlavePercentage",
 		};
 
+		constexpr auto load_types = make_snd_string_table(LOAD_TYPES);
+		constexpr auto loop_types = make_snd_string_table(LOOP_TYPES);
+		constexpr auto music_content = make_snd_string_table(MUSIC_CONTENT);
+		constexpr auto gpad_output = make_snd_string_table(GPAD_OUTPUT);
+		constexpr auto shapes = make_snd_string_table(SHAPES);
+		constexpr auto fulldrylevel = make_snd_string_table(FULLDRYLEVEL);
+		constexpr auto alias_fields = make_snd_string_table(SND_ALIAS_FIELDS);
+
 		std::string get_path(SndBank* asset)
 		{
 			return sound_path + asset->name + ".aliases.csv";
@@ -230,6 +240,20 @@ namespace zonetool::iw7
 
 			const auto rows = parser.get_rows();
 
+			// the header row can be shorter than the widest row
+			if (rows[0]->num_fields < max_fields)
+			{
+				ZONETOOL_WARNING("Header of csv file %s only has %d of %d columns", path.data(), rows[0]->num_fields, max_fields);
+			}
+
+			for (auto i = 0; i < rows[0]->num_fields && i < max_fields; i++)
+			{
+				if (alias_fields.index_of(rows[0]->fields[i]) != static_cast<std::uint32_t>(i))
+				{
+					ZONETOOL_WARNING("Unexpected column \"%s\" in csv file %s, expected \"%s\"", rows[0]->fields[i], path.data(), SND_ALIAS_FIELDS[i].data());
+				}
+			}
+
 			for (auto i = 1; i < row_count; i++)
 			{
 				if (rows[i]->num_fields != max_fields)
@@ -281,36 +305,36 @@ namespace zonetool::iw7
 
 				alias->volMin = get_value<float>(get());
 				alias->volMax = get_value<float>(get());
-				alias->volModIndex = get_value_index<int>(get(), VOLMODS, std::extent_v<decltype(VOLMODS)>);
+				alias->volModIndex = get_value_index<int>(get(), snd_tables::volmods);
 				alias->pitchMin = get_value<float>(get());
 				alias->pitchMax = get_value<float>(get());
 				alias->donutFadeEnd = get_value<float>(get());
 				alias->distMin = get_value<float>(get());
 				alias->distMax = get_value<float>(get());
 				alias->velocityMin = get_value<float>(get());
-				alias->flags.channel = get_value_index<unsigned int>(get(), ENTCHANNELS, std::extent_v<decltype(ENTCHANNELS)>);
-				alias->flags.type = get_value_index<unsigned int>(get(), LOAD_TYPES, std::extent_v<decltype(LOAD_TYPES)>);
-				alias->flags.looping = get_value_index<unsigned int>(get(), LOOP_TYPES, std::extent_v<decltype(LOOP_TYPES)>);
+				alias->flags.channel = get_value_index<unsigned int>(get(), snd_tables::entchannels);
+				alias->flags.type = get_value_index<unsigned int>(get(), load_types);
+				alias->flags.looping = get_value_index<unsigned int>(get(), loop_types);
 				alias->probability = get_value<float>(get());
 
-				const auto default_vf_curve = get_value_index<unsigned char>("default", vf_curves_s, std::extent_v<decltype(vf_curves_s)>, 0);
-				alias->volumeFalloffCurveIndex = get_value_index<unsigned char>(get(), vf_curves_s, std::extent_v<decltype(vf_curves_s)>, default_vf_curve);
+				constexpr auto default_vf_curve = get_value_index<unsigned char>("default", snd_tables::vf_curves, 0);
+				alias->volumeFalloffCurveIndex = get_value_index<unsigned char>(get(), snd_tables::vf_curves, default_vf_curve);
 
-				const auto default_lpf_curve = get_value_index<unsigned char>("default", lpf_curves_s, std::extent_v<decltype(lpf_curves_s)>, 0);
-				alias->lpfCurveIndex = get_value_index<unsigned char>(get(), lpf_curves_s, std::extent_v<decltype(lpf_curves_s)>, default_lpf_curve);
+				constexpr auto default_lpf_curve = get_value_index<unsigned char>("default", snd_tables::lpf_curves, 0);
+				alias->lpfCurveIndex = get_value_index<unsigned char>(get(), snd_tables::lpf_curves, default_lpf_curve);
 
-				const auto default_hpf_curve = get_value_index<unsigned char>("default", hpf_curves_s, std::extent_v<decltype(hpf_curves_s)>, 0);
-				alias->hpfCurveIndex = get_value_index<unsigned char>(get(), hpf_curves_s, std::extent_v<decltype(hpf_curves_s)>, default_hpf_curve);
+				constexpr auto default_hpf_curve = get_value_index<unsigned char>("default", snd_tables::hpf_curves, 0);
+				alias->hpfCurveIndex = get_value_index<unsigned char>(get(), snd_tables::hpf_curves, default_hpf_curve);
 
-				const auto default_reverb_send_curve = get_value_index<unsigned char>("default", rvb_curves_s, std::extent_v<decltype(rvb_curves_s)>, 0);
-				alias->reverbSendCurveIndex = get_value_index<unsigned char>(get(), rvb_curves_s, std::extent_v<decltype(rvb_curves_s)>, default_reverb_send_curve);
+				constexpr auto default_reverb_send_curve = get_value_index<unsigned char>("default", snd_tables::rvb_curves, 0);
+				alias->reverbSendCurveIndex = get_value_index<unsigned char>(get(), snd_tables::rvb_curves, default_reverb_send_curve);
 
 				alias->startDelay = get_value<int>(get());
 
-				const auto default_speaker_map = get_value_index<unsigned char>("default", speaker_maps_s, std::extent_v<decltype(speaker_maps_s)>, 0);
-				alias->speakerMapIndex = get_value_index<unsigned char>(get(), speaker_maps_s, std::extent_v<decltype(speaker_maps_s)>, default_speaker_map);
+				constexpr auto default_speaker_map = get_value_index<unsigned char>("default", snd_tables::speaker_maps, 0);
+				alias->speakerMapIndex = get_value_index<unsigned char>(get(), snd_tables::speaker_maps, default_speaker_map);
 
-				alias->flags.reverb = get_value_index<unsigned int>(get(), FULLDRYLEVEL, std::extent_v<decltype(FULLDRYLEVEL)>);
+				alias->flags.reverb = get_value_index<unsigned int>(get(), fulldrylevel);
 				alias->reverbMultiplier = get_value<float>(get());
 				alias->farReverbMultiplier = get_value<float>(get());
 				alias->lfePercentage = get_value<float>(get());
@@ -318,13 +342,13 @@ namespace zonetool::iw7
 				alias->envelopMin = get_value<float>(get());
 				alias->envelopMax = get_value<float>(get());
 				alias->envelopPercentage = get_value<float>(get());
-				alias->flags.shape = get_value_index<unsigned int>(get(), SHAPES, std::extent_v<decltype(SHAPES)>);
-				alias->flags.ignoreDistanceCheck = get_value_index<unsigned int>(get(), FALSE_TRUE, std::extent_v<decltype(FALSE_TRUE)>);
+				alias->flags.shape = get_value_index<unsigned int>(get(), shapes);
+				alias->flags.ignoreDistanceCheck = get_value_index<unsigned int>(get(), false_true_table);
 
-				const auto default_occlusion_shape = get_value_index<unsigned char>("default", occlusion_shapes_s, std::extent_v<decltype(occlusion_shapes_s)>, 0);
-				alias->occlusionShapeIndex = get_value_index<unsigned char>(get(), occlusion_shapes_s, std::extent_v<decltype(occlusion_shapes_s)>, default_occlusion_shape);
+				constexpr auto default_occlusion_shape = get_value_index<unsigned char>("default", snd_tables::occlusion_shapes, 0);
+				alias->occlusionShapeIndex = get_value_index<unsigned char>(get(), snd_tables::occlusion_shapes, default_occlusion_shape);
 
-				alias->dopplerPresetIndex = get_value_index<unsigned char>(get(), doppler_presets_s, std::extent_v<decltype(doppler_presets_s)>, 0xFF);
+				alias->dopplerPresetIndex = get_value_index<unsigned char>(get(), snd_tables::doppler_presets, 0xFF);
 
 				alias->smartPanDistance2d = get_value<float>(get());
 				alias->smartPanDistance3d = get_value<float>(get());
@@ -335,7 +359,7 @@ namespace zonetool::iw7
 				alias->stereoSpreadMaxAngle = get_value<int>(get());
 				alias->contextType = snd_hash_name(get());
 				alias->contextValue = snd_hash_name(get());
-				alias->flags.precached = get_value_index<unsigned int>(get(), FALSE_TRUE, std::extent_v<decltype(FALSE_TRUE)>);
+				alias->flags.precached = get_value_index<unsigned int>(get(), false_true_table);
 
 				auto duck = get_string();
 				if (duck)
@@ -344,9 +368,9 @@ namespace zonetool::iw7
 					alias->duck = snd_hash_name(duck);
 				}
 
-				alias->flags.MusicContent = get_value_index<unsigned int>(get(), MUSIC_CONTENT, std::extent_v<decltype(MUSIC_CONTENT)>);
-				alias->flags.GPadOutput = get_value_index<unsigned int>(get(), GPAD_OUTPUT, std::extent_v<decltype(GPAD_OUTPUT)>);
-				alias->flags.ForceSubtitle = get_value_index<unsigned int>(get(), FALSE_TRUE, std::extent_v<decltype(FALSE_TRUE)>);
+				alias->flags.MusicContent = get_value_index<unsigned int>(get(), music_content);
+				alias->flags.GPadOutput = get_value_index<unsigned int>(get(), gpad_output);
+				alias->flags.ForceSubtitle = get_value_index<unsigned int>(get(), false_true_table);
 				alias->masterPriority = get_value<int>(get());
 				alias->masterPercentage = get_value<float>(get());
 				alias->slavePercentage = get_value<float>(get());
@@ -355,6 +379,21 @@ namespace zonetool::iw7
 			}
 		}
 
+		void build_alias_index(SndBank* asset, zone_memory* mem)
+		{
+			asset->aliasIndex = mem->allocate<SndIndexEntry>(asset->aliasCount);
+
+			const auto built = hash_index::build(asset->aliasIndex, asset->aliasCount, [&](const std::size_t index)
+			{
+				return asset->alias[index].id;
+			});
+
+			if (!built)
+			{
+				ZONETOOL_FATAL("Unable to allocate sound bank alias index list");
+			}
+		}
+
 		void parse(SndBank* asset, zone_memory* mem, ordered_json& paths)
 		{
 			if (!paths.is_array() || !paths.size()) return;
@@ -385,104 +424,60 @@ namespace zonetool::iw7
 			}
 			ducks.clear();
 
-			// create temp alias list
-			std::vector<SndAliasList> alias_list;
-			alias_list.reserve(aliases.size());
-			for (size_t i = 0; i < aliases.size(); i++)
+			// group aliases by name, variations of one alias don't have to be adjacent in the csv
+			std::vector<std::vector<SndAlias*>> alias_groups;
+			std::unordered_map<std::string_view, std::size_t> alias_group_lookup;
+			alias_groups.reserve(aliases.size());
+			alias_group_lookup.reserve(aliases.size());
+
+			for (auto* alias : aliases)
 			{
-				SndAliasList list{};
-				unsigned int alias_count = 1;
-				list.aliasName = mem->duplicate_string(aliases[i]->aliasName);
-				list.id = snd_hash_name(list.aliasName);
-				list.head = aliases[i];
-				while (i + 1 < aliases.size())
+				const std::string_view name = alias->aliasName ? alias->aliasName : "";
+				const auto [itr, inserted] = alias_group_lookup.try_emplace(name, alias_groups.size());
+				if (inserted)
 				{
-					if (!strcmp(aliases[i]->aliasName, aliases[i + 1]->aliasName))
-					{
-						alias_count++;
-						i++;
-					}
-					else
-						break;
+					alias_groups.emplace_back();
 				}
-				list.count = alias_count;
-				list.sequence = 0;
 
-				alias_list.push_back(list);
+				alias_groups[itr->second].push_back(alias);
 			}
+			alias_group_lookup.clear();
 			aliases.clear();
 
-			if (alias_list.size() >= std::numeric_limits<unsigned short>::max())
+			if (alias_groups.size() >= std::numeric_limits<unsigned short>::max())
 			{
-				ZONETOOL_FATAL("Zone has too many sound aliases! %d/%d", static_cast<unsigned int>(alias_list.size()), std::numeric_limits<unsigned short>::max() - 1);
+				ZONETOOL_FATAL("Zone has too many sound aliases! %d/%d", static_cast<unsigned int>(alias_groups.size()), std::numeric_limits<unsigned short>::max() - 1);
 			}
 
 			// create final alias list
-			asset->aliasCount = static_cast<unsigned int>(alias_list.size());
+			asset->aliasCount = static_cast<unsigned int>(alias_groups.size());
 			asset->alias = mem->allocate<SndAliasList>(asset->aliasCount);
 			for (auto i = 0u; i < asset->aliasCount; i++)
 			{
-				memcpy(&asset->alias[i], &alias_list[i], sizeof(SndAliasList));
-			}
-			alias_list.clear();
-
-			// create alias index list
-			asset->aliasIndex = mem->allocate<SndIndexEntry>(asset->aliasCount);
-			memset(asset->aliasIndex, 0xFF, sizeof(SndIndexEntry) * asset->aliasCount);
+				const auto& group = alias_groups[i];
+				auto* list = &asset->alias[i];
 
-			const auto setAliasIndexList = std::make_unique<bool[]>(asset->aliasCount);
+				list->aliasName = mem->duplicate_string(group[0]->aliasName ? group[0]->aliasName : "");
+				list->id = snd_hash_name(list->aliasName);
+				list->count = static_cast<int>(group.size());
+				list->sequence = 0;
 
-			for (unsigned short i = 0; i < asset->aliasCount; i++)
-			{
-				const auto idx = asset->alias[i].id % asset->aliasCount;
-				if (asset->aliasIndex[idx].value == std::numeric_limits<unsigned short>::max())
+				// the game reads variations as an array starting at head
+				if (group.size() == 1)
 				{
-					asset->aliasIndex[idx].value = i;
-					asset->aliasIndex[idx].next = std::numeric_limits<unsigned short>::max();
-					setAliasIndexList[i] = true;
-				}
-			}
-
-			for (unsigned short i = 0u; i < asset->aliasCount; i++)
-			{
-				if (setAliasIndexList[i])
+					list->head = group[0];
 					continue;
-
-				unsigned short idx = static_cast<unsigned short>(asset->alias[i].id % asset->aliasCount);
-				while (asset->aliasIndex[idx].next != std::numeric_limits<unsigned short>::max())
-				{
-					idx = asset->aliasIndex[idx].next;
 				}
 
-				unsigned short offset = 1u;
-				auto freeIdx = std::numeric_limits<unsigned short>::max();
-				while (true)
+				list->head = mem->allocate<SndAlias>(group.size());
+				for (auto j = 0u; j < group.size(); j++)
 				{
-					freeIdx = (idx + offset) % asset->aliasCount;
-					if (asset->aliasIndex[freeIdx].value == std::numeric_limits<unsigned short>::max())
-						break;
-
-					freeIdx = (idx + static_cast<unsigned short>(asset->aliasCount) - offset) % static_cast<unsigned short>(asset->aliasCount);
-					if (asset->aliasIndex[freeIdx].value == std::numeric_limits<unsigned short>::max())
-						break;
-
-					offset++;
-					freeIdx = std::numeric_limits<unsigned short>::max();
-
-					if (offset >= asset->aliasCount)
-						break;
+					std::memcpy(&list->head[j], group[j], sizeof(SndAlias));
 				}
-
-				if (freeIdx == std::numeric_limits<unsigned short>::max())
-				{
-					ZONETOOL_FATAL("Unable to allocate sound bank alias index list");
-				}
-
-				asset->aliasIndex[idx].next = freeIdx;
-				asset->aliasIndex[freeIdx].value = i;
-				asset->aliasIndex[freeIdx].next = std::numeric_limits<unsigned short>::max();
-				setAliasIndexList[i] = true;
 			}
+			alias_groups.clear();
+
+			build_alias_index(asset, mem);
 		}
 	}
 
@@ -1809,7 +1804,7 @@ namespace zonetool::iw7
 						return false;
 					}
 
-					utils::bit_buffer header_buffer{ std::string(pos, pos + METADATA_BLOCK_HEADER_LEN_BYTES) }; // header
+					utils::bit_reader_be header_buffer(pos, METADATA_BLOCK_HEADER_LEN_BYTES); // header
 					MetaDataBlockHeader header{};
 					header.isLastMetaDataBlock = header_buffer.read_bits<bool>(1);
 					header.blockType = header_buffer.read_bits<MetaDataBlockType>(7);
@@ -1819,7 +1814,7 @@ namespace zonetool::iw7
 					if (header.blockType == STREAMINFO)
 					{
 						assert(header.blockLength == METADATA_STREAMINFO_LEN_BYTES);
-						utils::bit_buffer block_buffer{std::string(pos, pos + header.blockLength)};
+						utils::bit_reader_be block_buffer(pos, header.blockLength);
 						StreamInfo info{};
 						info.min_blocksize = block_buffer.read_bits<uint32_t>(16);
 						info.max_blocksize = block_buffer.read_bits<uint32_t>(16);
@@ -3,7 +3,7 @@
 
 namespace zonetool::iw7
 {
-	static std::string VOLMODS[] =
+	static constexpr std::string_view VOLMODS[] =
 	{
 		"hud",
 		"interface",
@@ -87,7 +87,7 @@ namespace zonetool::iw7
 		"default",
 	};
 
-	static std::string ENTCHANNELS[] =
+	static constexpr std::string_view ENTCHANNELS[] =
 	{
 		"scn_fx_unres_3d",
 		"scn_lfe_unres_3d",
@@ -225,7 +225,7 @@ namespace zonetool::iw7
 		"pa_voice",
 	};
 
-	static std::string doppler_presets_s[] =
+	static constexpr std::string_view doppler_presets_s[] =
 	{
 		"default",
 		"mp_ca_impact_a10",
@@ -241,14 +241,14 @@ namespace zonetool::iw7
 		"civis_running",
 	};
 
-	static std::string occlusion_shapes_s[] =
+	static constexpr std::string_view occlusion_shapes_s[] =
 	{
 		"default",
 		"test",
 		"rear_occluding_cone",
 	};
 
-	static std::string vf_curves_s[] =
+	static constexpr std::string_view vf_curves_s[] =
 	{
 		"weapon5",
 		"weapon4",
@@ -297,7 +297,7 @@ namespace zonetool::iw7
 		"2d_3d_nonradio",
 	};
 
-	static std::string lpf_curves_s[] =
+	static constexpr std::string_view lpf_curves_s[] =
 	{
 		"zmb_footstep",
 		"weap_npc_mid",
@@ -348,7 +348,7 @@ namespace zonetool::iw7
 		"aa_fire",
 	};
 
-	static std::string hpf_curves_s[] =
+	static constexpr std::string_view hpf_curves_s[] =
 	{
 		"zmb_footstep",
 		"weap_npc_mech",
@@ -365,7 +365,7 @@ namespace zonetool::iw7
 		"bullet_impacts",
 	};
 
-	static std::string rvb_curves_s[] =
+	static constexpr std::string_view rvb_curves_s[] =
 	{
 		"vo_shipcrib_rev_send",
 		"sparks",
@@ -378,7 +378,7 @@ namespace zonetool::iw7
 		"bc_vo_1",
 	};
 
-	static std::string speaker_maps_s[] =
+	static constexpr std::string_view speaker_maps_s[] =
 	{
 		"wpn_biasrear_nolfe",
 		"wpn_biasrear",
@@ -449,7 +449,7 @@ namespace zonetool::iw7
 		"ac130weapon",
 	};
 
-	static std::string contexts_s[] =
+	static constexpr std::string_view contexts_s[] =
 	{
 		"atmosphere",
 		"dropship",
@@ -474,7 +474,7 @@ namespace zonetool::iw7
 		"color",
 	};
 
-	static std::string context_values_s[] =
+	static constexpr std::string_view context_values_s[] =
 	{
 		"helmet",
 		"space",
@@ -588,7 +588,7 @@ namespace zonetool::iw7
 		"full",
 	};
 
-	static std::string masters_s[] =
+	static constexpr std::string_view masters_s[] =
 	{
 		"default",
 		"headphones",
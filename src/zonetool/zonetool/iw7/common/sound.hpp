@@ -1,5 +1,7 @@
 #pragma once
 
+#include "zonetool/utils/perfect_hash.hpp"
+
 namespace zonetool::iw7
 {
 	class csv_writer
@@ -31,6 +33,11 @@ namespace zonetool::iw7
 			write_column(std::string(value));
 		}
 
+		void write_column(const std::string_view& value)
+		{
+			write_column(std::string(value));
+		}
+
 		template <typename T>
 		void write_column(const T& value)
 		{
@@ -53,18 +60,25 @@ namespace zonetool::iw7
 		}
 	};
 
-	template<typename T> T get_value_index(const std::string& value, const std::string* lookup_table, size_t len, T default_value = 0)
+	template <std::size_t N>
+	using snd_string_table = perfect_hash::string_table<N>;
+
+	template <std::size_t N>
+	constexpr snd_string_table<N> make_snd_string_table(const std::string_view (&names)[N])
+	{
+		return snd_string_table<N>(names, snd_hash_name);
+	}
+
+	template<typename T, std::size_t N> constexpr T get_value_index(const std::string_view& value, const snd_string_table<N>& lookup_table, T default_value = 0)
 	{
 		if (value.empty())
 			return default_value;
 
-		for (T i = 0; i < len; i++)
-		{
-			if (lookup_table[i] == value)
-				return i;
-		}
+		const auto index = lookup_table.index_of(value);
+		if (index == perfect_hash::invalid_index)
+			return default_value;
 
-		return default_value;
+		return static_cast<T>(index);
 	}
 
 	template<typename T> T get_value(const std::string& value)
@@ -96,58 +110,37 @@ namespace zonetool::iw7
 		const std::string sound_path_globals = "sound/globals/";
 		const std::string sound_path_assets = "sound_assets/";
 
-		std::unordered_map<std::uint32_t, std::string> create_snd_hash_map()
+		namespace snd_tables
 		{
-			std::unordered_map<std::uint32_t, std::string> result;
-
-			// hash all global strings
-
-			for (auto i = 0u; i < std::extent_v<decltype(VOLMODS)>; i++)
-				result.emplace(snd_hash_name(VOLMODS[i].data()), VOLMODS[i]);
-
-			for (auto i = 0u; i < std::extent_v<decltype(ENTCHANNELS)>; i++)
-				result.emplace(snd_hash_name(ENTCHANNELS[i].data()), ENTCHANNELS[i]);
-
-			for (auto i = 0u; i < std::extent_v<decltype(doppler_presets_s)>; i++)
-				result.emplace(snd_hash_name(doppler_presets_s[i].data()), doppler_presets_s[i]);
-
-			for (auto i = 0u; i < std::extent_v<decltype(occlusion_shapes_s)>; i++)
-				result.emplace(snd_hash_name(occlusion_shapes_s[i].data()), occlusion_shapes_s[i]);
-
-			for (auto i = 0u; i < std::extent_v<decltype(vf_curves_s)>; i++)
-				result.emplace(snd_hash_name(vf_curves_s[i].data()), vf_curves_s[i]);
-
-			for (auto i = 0u; i < std::extent_v<decltype(lpf_curves_s)>; i++)
-				result.emplace(snd_hash_name(lpf_curves_s[i].data()), lpf_curves_s[i]);
-
-			for (auto i = 0u; i < std::extent_v<decltype(hpf_curves_s)>; i++)
-				result.emplace(snd_hash_name(hpf_curves_s[i].data()), hpf_curves_s[i]);
-
-			for (auto i = 0u; i < std::extent_v<decltype(rvb_curves_s)>; i++)
-				result.emplace(snd_hash_name(rvb_curves_s[i].data()), rvb_curves_s[i]);
-
-			for (auto i = 0u; i < std::extent_v<decltype(speaker_maps_s)>; i++)
-				result.emplace(snd_hash_name(speaker_maps_s[i].data()), speaker_maps_s[i]);
-
-			for (auto i = 0u; i < std::extent_v<decltype(contexts_s)>; i++)
-				result.emplace(snd_hash_name(contexts_s[i].data()), contexts_s[i]);
-
-			for (auto i = 0u; i < std::extent_v<decltype(context_values_s)>; i++)
-				result.emplace(snd_hash_name(context_values_s[i].data()), context_values_s[i]);
-
-			for (auto i = 0u; i < std::extent_v<decltype(masters_s)>; i++)
-				result.emplace(snd_hash_name(masters_s[i].data()), masters_s[i]);
+			constexpr auto volmods = make_snd_string_table(VOLMODS);
+			constexpr auto entchannels = make_snd_string_table(ENTCHANNELS);
+			constexpr auto doppler_presets = make_snd_string_table(doppler_presets_s);
+			constexpr auto occlusion_shapes = make_snd_string_table(occlusion_shapes_s);
+			constexpr auto vf_curves = make_snd_string_table(vf_curves_s);
+			constexpr auto lpf_curves = make_snd_string_table(lpf_curves_s);
+			constexpr auto hpf_curves = make_snd_string_table(hpf_curves_s);
+			constexpr auto rvb_curves = make_snd_string_table(rvb_curves_s);
+			constexpr auto speaker_maps = make_snd_string_table(speaker_maps_s);
+
+			template <std::size_t... N>
+			constexpr auto concat_names(const std::string_view (&... names)[N])
+			{
+				std::array<std::string_view, (N + ...)> result{};
+				std::size_t offset = 0;
+				((std::copy(std::begin(names), std::end(names), result.begin() + offset), offset += N), ...);
+				return result;
+			}
 
-			return result;
+			// every global string, earlier tables win when two names share a hash
+			constexpr auto hashed_names = concat_names(VOLMODS, ENTCHANNELS, doppler_presets_s, occlusion_shapes_s,
+				vf_curves_s, lpf_curves_s, hpf_curves_s, rvb_curves_s, speaker_maps_s, contexts_s, context_values_s, masters_s);
+			constexpr auto hashed = snd_string_table<hashed_names.size()>(hashed_names, snd_hash_name);
 		}
 
-		// hash lookup
-		const std::unordered_map<std::uint32_t, std::string> snd_hash_map = create_snd_hash_map();
-
 		std::string get_hashed_string(std::uint32_t hash)
 		{
 			if (!hash) return "";
-			return snd_hash_map.contains(hash) ? snd_hash_map.at(hash) : "";
+			return std::string(snd_tables::hashed.name_of_hash(hash));
 		}
 
 		std::string duck_hash_lookup(SndBank* asset, std::uint32_t hash)
@@ -162,10 +155,12 @@ namespace zonetool::iw7
 			return get_hashed_string(hash);
 		}
 
-		std::string FALSE_TRUE[] =
+		constexpr std::string_view FALSE_TRUE[] =
 		{
 			"False",
 			"True",
 		};
+
+		constexpr auto false_true_table = make_snd_string_table(FALSE_TRUE);
 	}
 }
\ No newline at end of file
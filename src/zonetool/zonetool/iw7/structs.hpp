@@ -1,6 +1,8 @@
 #pragma once
 #include <d3d11.h>
 
+#include "xfile.hpp"
+
 namespace zonetool::iw7
 {
 	namespace Umbra
@@ -12072,13 +12074,6 @@ namespace zonetool::iw7
 		unsigned long reserved;
 	};
 
-	enum DB_CompressorType : std::uint8_t
-	{
-		DB_COMPRESSOR_INVALID = 0x0,
-		DB_COMPRESSOR_PASSTHROUGH = 0x1,
-		DB_COMPRESSOR_BLOCK = 0x2,
-	};
-
 	struct DB_ReadStream
 	{
 		unsigned char* next_in;
@@ -12120,35 +12115,12 @@ namespace zonetool::iw7
 		char __pad0[1080];
 	}; assert_sizeof(DB_Zone, 1144);
 
-	enum XFileBlock
-	{
-		XFILE_BLOCK_TEMP = 0x0,
-		XFILE_BLOCK_TEMP_PRELOAD = 0x1,
-		XFILE_BLOCK_TEMP_POSTLOAD = 0x2,
-		XFILE_BLOCK_IMAGE_STREAM = 0x3,
-		XFILE_BLOCK_SHARED_STREAM = 0x4,
-		XFILE_BLOCK_CALLBACK = 0x5,
-		XFILE_BLOCK_RUNTIME = 0x6,
-		XFILE_BLOCK_UNK7 = 0x7,
-		XFILE_BLOCK_VIRTUAL = 0x8,
-		XFILE_BLOCK_SCRIPT = 0x9,
-		MAX_XFILE_COUNT = 0xA,
-	};
-
 	struct XBlock
 	{
 		char* alloc;
 		unsigned __int64 size;
 	};
 
-	struct XStreamFile
-	{
-		std::uint64_t offset;
-		std::uint64_t offsetEnd;
-		std::uint16_t fileIndex;
-		bool isLocalized;
-	};
-
 	struct XZoneMemory
 	{
 		XBlock blocks[MAX_XFILE_COUNT];
@@ -12164,38 +12136,6 @@ namespace zonetool::iw7
 		int streamed_image_index;
 	}; assert_sizeof(XZoneMemory, 0x138);
 
-	struct DB_AuthHash
-	{
-		unsigned char bytes[32];
-	};
-
-	struct DB_AuthSignature
-	{
-		unsigned char bytes[256];
-	};
-
-	struct DB_MasterBlock
-	{
-		DB_AuthHash chunkHashes[512];
-	}; assert_sizeof(DB_MasterBlock, 0x4000);
-
-	struct DB_AuthSubHeader
-	{
-		char fastfileName[32];
-		unsigned int reserved;
-		DB_AuthHash masterBlockHashes[192];
-	};
-
-	struct DB_AuthHeader // sub_1409E6100
-	{
-		char magic[8]; // IWffs100
-		unsigned int reserved;
-		DB_AuthHash subheaderHash;
-		DB_AuthSignature signedSubheaderHash;
-		DB_AuthSubHeader subheader;
-		char padding[9904]; // not used
-	}; assert_sizeof(DB_AuthHeader, 0x4000);
-
 	struct XPakHeader
 	{
 		char magic[8];
@@ -12207,75 +12147,6 @@ namespace zonetool::iw7
 		// iv for each image
 	};
 
-	struct XFileStreamData
-	{
-		std::uint64_t size;
-		std::uint64_t unk1;
-		std::uint64_t unk2;
-		std::uint64_t block_size[MAX_XFILE_COUNT];
-		std::uint64_t unk_arr[8];
-	}; assert_sizeof(XFileStreamData, 168);
-
-	struct XFileHeader
-	{
-		char magic[8];
-		std::uint32_t version;
-		std::uint8_t unused; // (unused)
-		std::uint8_t has_no_image_fastfile; // .ffi
-		std::uint8_t has_no_shared_fastfile; // .ffs
-		std::uint8_t unk1;
-		std::uint32_t fileTimeHigh; // (unused)
-		std::uint32_t fileTimeLow; // (unused)
-		XFileStreamData stream_data;
-		std::uint32_t shared_ff_hash; // some check
-		std::uint32_t shared_ff_count; // streamed shared_asset count
-		std::uint32_t image_ff_hash; // some check
-		std::uint32_t image_ff_count; // streamed image count
-		// image streams 24 * sharedcount
-		// image streams 24 * imagecount
-		std::uint64_t fileLen;
-		std::uint64_t fileLenUnk1;
-		std::uint64_t fileLenUnk2;
-		// if signed: DB_AuthHeader info;
-		// XFileCompressorHeader
-	};
-
-	struct XFileCompressorHeader
-	{
-		DB_CompressorType compressor;
-		char magic[3];
-	};
-
-#pragma pack(push, 1)
-	struct XBlockCompressionBlockHeader
-	{
-		unsigned int compressedSize;
-		std::uint64_t uncompressedSize;
-	};
-
-	struct XBlockCompressionBlockSizeAndCompressionType
-	{
-		unsigned int blockSize : 24;
-		unsigned int compressionType : 8;
-	};
-
-	struct XBlockCompressionDataHeader
-	{
-		std::uint64_t uncompressedSize;
-		XBlockCompressionBlockSizeAndCompressionType blockSizeAndType;
-	};
-#pragma pack(pop)
-
-	enum XBlockCompressionType
-	{
-		XBLOCK_COMPRESSION_INVALID = 0x0,
-		XBLOCK_COMPRESSION_ZLIB_SIZE = 0x1,
-		XBLOCK_COMPRESSION_ZLIB_SPEED = 0x2,
-		XBLOCK_COMPRESSION_LZ4HC = 0x3,
-		XBLOCK_COMPRESSION_LZ4 = 0x4,
-		XBLOCK_COMPRESSION_NONE = 0x5,
-	};
-
 	struct XFileReadData
 	{
 		bool header_parsed;
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// iw7 .ff container layout, split from structs.hpp so it builds without d3d11
+
+namespace zonetool::iw7
+{
+	enum DB_CompressorType : std::uint8_t
+	{
+		DB_COMPRESSOR_INVALID = 0x0,
+		DB_COMPRESSOR_PASSTHROUGH = 0x1,
+		DB_COMPRESSOR_BLOCK = 0x2,
+	};
+
+	enum XFileBlock
+	{
+		XFILE_BLOCK_TEMP = 0x0,
+		XFILE_BLOCK_TEMP_PRELOAD = 0x1,
+		XFILE_BLOCK_TEMP_POSTLOAD = 0x2,
+		XFILE_BLOCK_IMAGE_STREAM = 0x3,
+		XFILE_BLOCK_SHARED_STREAM = 0x4,
+		XFILE_BLOCK_CALLBACK = 0x5,
+		XFILE_BLOCK_RUNTIME = 0x6,
+		XFILE_BLOCK_UNK7 = 0x7,
+		XFILE_BLOCK_VIRTUAL = 0x8,
+		XFILE_BLOCK_SCRIPT = 0x9,
+		MAX_XFILE_COUNT = 0xA,
+	};
+
+	struct XStreamFile
+	{
+		std::uint64_t offset;
+		std::uint64_t offsetEnd;
+		std::uint16_t fileIndex;
+		bool isLocalized;
+	};
+
+	struct DB_AuthHash
+	{
+		unsigned char bytes[32];
+	};
+
+	struct DB_AuthSignature
+	{
+		unsigned char bytes[256];
+	};
+
+	struct DB_MasterBlock
+	{
+		DB_AuthHash chunkHashes[512];
+	}; static_assert(sizeof(DB_MasterBlock) == 0x4000);
+
+	struct DB_AuthSubHeader
+	{
+		char fastfileName[32];
+		unsigned int reserved;
+		DB_AuthHash masterBlockHashes[192];
+	};
+
+	struct DB_AuthHeader // sub_1409E6100
+	{
+		char magic[8]; // IWffs100
+		unsigned int reserved;
+		DB_AuthHash subheaderHash;
+		DB_AuthSignature signedSubheaderHash;
+		DB_AuthSubHeader subheader;
+		char padding[9904]; // not used
+	}; static_assert(sizeof(DB_AuthHeader) == 0x4000);
+
+	struct XFileStreamData
+	{
+		std::uint64_t size;
+		std::uint64_t unk1;
+		std::uint64_t unk2;
+		std::uint64_t block_size[MAX_XFILE_COUNT];
+		std::uint64_t unk_arr[8];
+	}; static_assert(sizeof(XFileStreamData) == 168);
+
+	struct XFileHeader
+	{
+		char magic[8];
+		std::uint32_t version;
+		std::uint8_t unused; // (unused)
+		std::uint8_t has_no_image_fastfile; // .ffi
+		std::uint8_t has_no_shared_fastfile; // .ffs
+		std::uint8_t unk1;
+		std::uint32_t fileTimeHigh; // (unused)
+		std::uint32_t fileTimeLow; // (unused)
+		XFileStreamData stream_data;
+		std::uint32_t shared_ff_hash; // some check
+		std::uint32_t shared_ff_count; // streamed shared_asset count
+		std::uint32_t image_ff_hash; // some check
+		std::uint32_t image_ff_count; // streamed image count
+		// image streams 24 * sharedcount
+		// image streams 24 * imagecount
+		std::uint64_t fileLen;
+		std::uint64_t fileLenUnk1;
+		std::uint64_t fileLenUnk2;
+		// if signed: DB_AuthHeader info;
+		// XFileCompressorHeader
+	};
+
+	struct XFileCompressorHeader
+	{
+		DB_CompressorType compressor;
+		char magic[3];
+	};
+
+#pragma pack(push, 1)
+	struct XBlockCompressionBlockHeader
+	{
+		unsigned int compressedSize;
+		std::uint64_t uncompressedSize;
+	};
+
+	struct XBlockCompressionBlockSizeAndCompressionType
+	{
+		unsigned int blockSize : 24;
+		unsigned int compressionType : 8;
+	};
+
+	struct XBlockCompressionDataHeader
+	{
+		std::uint64_t uncompressedSize;
+		XBlockCompressionBlockSizeAndCompressionType blockSizeAndType;
+	};
+#pragma pack(pop)
+
+	enum XBlockCompressionType
+	{
+		XBLOCK_COMPRESSION_INVALID = 0x0,
+		XBLOCK_COMPRESSION_ZLIB_SIZE = 0x1,
+		XBLOCK_COMPRESSION_ZLIB_SPEED = 0x2,
+		XBLOCK_COMPRESSION_LZ4HC = 0x3,
+		XBLOCK_COMPRESSION_LZ4 = 0x4,
+		XBLOCK_COMPRESSION_NONE = 0x5,
+	};
+}
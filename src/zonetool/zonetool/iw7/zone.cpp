@@ -2,6 +2,8 @@
 #include "zonetool.hpp"
 #include "zone.hpp"
 #include "zonetool/utils/utils.hpp"
+#include "zonetool/utils/profiler.hpp"
+#include "zonetool/utils/size_report.hpp"
 
 #include <utils/io.hpp>
 #include <utils/cryptography.hpp>
@@ -61,103 +63,103 @@ namespace zonetool::iw7
 
 		std::vector<std::uint8_t> compress_block_signed(const std::uint8_t* data, const std::size_t size, const int type, std::vector<DB_AuthHash>& chunk_hashes)
 		{
-			auto* block_buffer = reinterpret_cast<std::uint8_t*>(malloc(BLOCK_SIZE_CHUNK_SIGNED));
-
-			std::vector<std::uint8_t> out_buffer;
-
-			auto bytes_to_compress = size;
-			if (bytes_to_compress > std::numeric_limits<unsigned int>::max())
+			if (size > std::numeric_limits<unsigned int>::max())
 			{
 				throw std::runtime_error("cannot compress more than `std::numeric_limits<unsigned int>::max()` bytes");
 			}
 
-			auto data_ptr = reinterpret_cast<const char*>(data);
-
-			const auto write = [&](void* data, const size_t len)
+			if (size && type != XBLOCK_COMPRESSION_LZ4)
 			{
-				for (auto i = 0ull; i < len; i++)
-				{
-					out_buffer.push_back(reinterpret_cast<char*>(data)[i]);
-				}
-			};
+				__debugbreak();
+			}
+
+			// every chunk eats a fixed MAX_BLOCK_SIZE of input and is padded to a fixed size on disk,
+			// so chunks don't depend on each other and can be compressed and hashed in any order
+			const auto chunk_count = static_cast<std::size_t>((size + MAX_BLOCK_SIZE - 1) / MAX_BLOCK_SIZE);
+
+			std::vector<std::uint8_t> out_buffer(std::max(chunk_count * BLOCK_SIZE_CHUNK_SIGNED, sizeof(XFileCompressorHeader)));
+
+			const auto hash_offset = chunk_hashes.size();
+			chunk_hashes.resize(hash_offset + chunk_count);
 
 			XFileCompressorHeader compress_header{};
 			memcpy(compress_header.magic, "IWC", 3);
 			compress_header.compressor = DB_COMPRESSOR_BLOCK;
-			write(&compress_header, sizeof(XFileCompressorHeader));
+			memcpy(out_buffer.data(), &compress_header, sizeof(XFileCompressorHeader));
 
-			auto first_block = true;
+			std::atomic_size_t next_chunk = 0;
+			std::atomic_bool overflow = false;
 
-			const auto compress_block_lz4 = [&]()
+			const auto compress_chunk = [&](const std::size_t index)
 			{
-				memset(block_buffer, 0, sizeof(block_buffer));
-
-				const auto uncompressed_size = static_cast<unsigned int>(std::min(bytes_to_compress, MAX_BLOCK_SIZE));
-				memcpy(block_buffer, data_ptr, uncompressed_size);
-
-				const auto block_size = first_block ? BLOCK_SIZE_FIRST_SIGNED : BLOCK_SIZE_SIGNED;
-				const auto bound = LZ4_compressBound(static_cast<int>(block_size));
-				assert(bound > block_size);
+				const auto chunk = out_buffer.data() + index * BLOCK_SIZE_CHUNK_SIGNED;
+				const auto input_offset = index * MAX_BLOCK_SIZE;
+				const auto uncompressed_size = static_cast<unsigned int>(std::min(size - input_offset, MAX_BLOCK_SIZE));
 
-				std::string buffer;
-				buffer.resize(block_size);
-
-				const auto compressed_size = LZ4_compress_HC(reinterpret_cast<char*>(block_buffer),
-					buffer.data(), uncompressed_size, bound, LZ4HC_CLEVEL_DEFAULT);
-				assert(buffer.size() == block_size);
+				auto write_ptr = chunk;
+				auto block_size = BLOCK_SIZE_SIGNED;
 
-				if (first_block)
+				if (index == 0)
 				{
 					XBlockCompressionDataHeader header{};
-					header.uncompressedSize = bytes_to_compress;
+					header.uncompressedSize = size;
 					header.blockSizeAndType.blockSize = MAX_BLOCK_SIZE;
 					header.blockSizeAndType.compressionType = XBLOCK_COMPRESSION_LZ4;
 
-					write(&header, sizeof(header));
+					write_ptr += sizeof(XFileCompressorHeader);
+					memcpy(write_ptr, &header, sizeof(header));
+					write_ptr += sizeof(header);
+					block_size = BLOCK_SIZE_FIRST_SIGNED;
+				}
+
+				const auto compressed_size = LZ4_compress_HC(reinterpret_cast<const char*>(data + input_offset),
+					reinterpret_cast<char*>(write_ptr + sizeof(XBlockCompressionBlockHeader)), uncompressed_size,
+					static_cast<int>(block_size), LZ4HC_CLEVEL_DEFAULT);
+
+				if (compressed_size <= 0)
+				{
+					overflow = true;
+					return;
 				}
 
 				XBlockCompressionBlockHeader block_header{};
 				block_header.compressedSize = compressed_size;
 				block_header.uncompressedSize = uncompressed_size;
+				memcpy(write_ptr, &block_header, sizeof(block_header));
 
-				write(&block_header, sizeof(block_header));
-
-				write(buffer.data(), buffer.size());
-
-				first_block = false;
-
-				bytes_to_compress -= uncompressed_size;
-				data_ptr += uncompressed_size;
-
-				assert(buffer.size() % BLOCK_SIZE_CHUNK_SIGNED);
+				auto& hash = chunk_hashes[hash_offset + index];
+				hash_state state{};
+				sha256_init(&state);
+				sha256_process(&state, chunk, BLOCK_SIZE_CHUNK_SIGNED);
+				sha256_done(&state, hash.bytes);
 			};
 
-			const auto compress_block_zlib = [&]()
-			{
-				__debugbreak();
-			};
+			const auto thread_count = std::min(static_cast<std::size_t>(std::max(1u, std::thread::hardware_concurrency())), chunk_count);
 
-			while (bytes_to_compress > 0)
+			std::vector<std::thread> threads;
+			for (auto i = 0u; i < thread_count; i++)
 			{
-				if (type == XBLOCK_COMPRESSION_LZ4)
+				threads.emplace_back([&]
 				{
-					compress_block_lz4();
-				}
-				else
+					for (auto index = next_chunk++; index < chunk_count && !overflow; index = next_chunk++)
+					{
+						compress_chunk(index);
+					}
+				});
+			}
+
+			for (auto& thread : threads)
+			{
+				if (thread.joinable())
 				{
-					__debugbreak();
+					thread.join();
 				}
-
-				// calc hash
-				DB_AuthHash hash{};
-				hash_state state{};
-				sha256_init(&state);
-				sha256_process(&state, out_buffer.data() + out_buffer.size() - BLOCK_SIZE_CHUNK_SIGNED, BLOCK_SIZE_CHUNK_SIGNED);
-				sha256_done(&state, hash.bytes);
-				chunk_hashes.push_back(hash);
 			}
 
-			free(block_buffer);
+			if (overflow)
+			{
+				throw std::runtime_error("block does not fit in a signed chunk");
+			}
 
 			return out_buffer;
 		}
@@ -486,6 +488,8 @@ namespace zonetool::iw7
 
 		const std::string& name = get_asset_name(XAssetType(type), pointer);
 
+		this->m_dependencies.add_reference(type, name);
+
 		// don't add asset if it already exists
 		for (std::size_t idx = 0; idx < m_assets.size(); idx++)
 		{
@@ -499,8 +503,16 @@ namespace zonetool::iw7
 		if (type == __type__) \
 		{ \
 			auto asset = std::make_shared < ___ >(); \
-			asset->init(pointer, this->m_zonemem.get()); \
-			asset->load_depending(this); \
+			{ \
+				profiler::scope _("parse", name, type_to_string(XAssetType(type))); \
+				asset->init(pointer, this->m_zonemem.get()); \
+			} \
+			{ \
+				profiler::scope _("load_depending", name, type_to_string(XAssetType(type))); \
+				this->m_dependencies.begin_asset(type, name); \
+				asset->load_depending(this); \
+				this->m_dependencies.end_asset(); \
+			} \
 			m_assets.push_back(asset); \
 		}
 
@@ -516,6 +528,20 @@ namespace zonetool::iw7
 		}
 	}
 
+	void zone_interface::add_assets_of_type_by_pointer(std::int32_t type, const std::vector<void*>& pointers)
+	{
+		if (type == ASSET_TYPE_LOCALIZE_ENTRY)
+		{
+			add_assets_by_pointer<localize, LocalizeEntry>(this->m_assets, type, pointers);
+			return;
+		}
+
+		for (auto* pointer : pointers)
+		{
+			this->add_asset_of_type_by_pointer(type, pointer);
+		}
+	}
+
 	void zone_interface::add_asset_of_type(std::int32_t type, const std::string& _name)
 	{
 		std::string name = _name;
@@ -534,6 +560,9 @@ namespace zonetool::iw7
 			}
 		}
 
+		// whatever is loading its dependencies right now has to be written after this
+		this->m_dependencies.add_reference(type, name);
+
 		// don't add asset if it already exists
 		if (get_asset_pointer(type, name))
 		{
@@ -544,8 +573,16 @@ namespace zonetool::iw7
 		if (type == __type__) \
 		{ \
 			auto asset = std::make_shared < ___ >(); \
-			asset->init(name, this->m_zonemem.get()); \
-			asset->load_depending(this); \
+			{ \
+				profiler::scope _("parse", name, type_to_string(XAssetType(type))); \
+				asset->init(name, this->m_zonemem.get()); \
+			} \
+			{ \
+				profiler::scope _("load_depending", name, type_to_string(XAssetType(type))); \
+				this->m_dependencies.begin_asset(type, name); \
+				asset->load_depending(this); \
+				this->m_dependencies.end_asset(); \
+			} \
 			m_assets.push_back(asset); \
 		}
 
@@ -623,6 +660,11 @@ namespace zonetool::iw7
 		return type_to_int(type);
 	}
 
+	zone_memory* zone_interface::get_memory()
+	{
+		return this->m_zonemem.get();
+	}
+
 	void zone_interface::add_asset_of_type(const std::string& type, const std::string& name)
 	{
 		std::int32_t itype = type_to_int(type);
@@ -637,6 +679,12 @@ namespace zonetool::iw7
 
 		ZONETOOL_INFO("Compiling fastfile \"%s\"...", this->name_.data());
 
+		if (asset_order::is_enabled())
+		{
+			profiler::scope _("phase", "sort");
+			asset_order::sort(m_assets, this->m_dependencies);
+		}
+
 		{
 			std::vector<gfx_image*> images;
 			for (std::size_t i = 0; i < m_assets.size(); i++)
@@ -662,9 +710,13 @@ namespace zonetool::iw7
 		std::uintptr_t zero = 0; // data_none
 
 		// write asset types to header
-		for (std::size_t i = 0; i < m_assets.size(); i++)
 		{
-			m_assets[i]->prepare(buf, this->m_zonemem.get());
+			profiler::scope _("phase", "prepare");
+			for (std::size_t i = 0; i < m_assets.size(); i++)
+			{
+				profiler::scope asset_scope("prepare", m_assets[i].get(), type_to_string(XAssetType(m_assets[i]->type())));
+				m_assets[i]->prepare(buf, this->m_zonemem.get());
+			}
 		}
 
 		buf->push_stream(XFILE_BLOCK_TEMP);
@@ -915,22 +967,34 @@ namespace zonetool::iw7
 			buf->write(&following);
 		}
 
+		// per asset stream usage for -sizereport
+		size_report report(buf, MAX_XFILE_COUNT);
+
 		// write assets
-		for (auto& asset : m_assets)
 		{
+			profiler::scope _("phase", "write");
+			for (auto& asset : m_assets)
+			{
 #ifdef DEBUG
-			ZONETOOL_INFO("writing asset \"%s\" of type %s...", asset->name().data(), type_to_string(XAssetType(asset->type())));
+				ZONETOOL_INFO("writing asset \"%s\" of type %s...", asset->name().data(), type_to_string(XAssetType(asset->type())));
 #endif
 
-			// push stream
-			buf->push_stream(XFILE_BLOCK_TEMP);
-			buf->align(7);
+				profiler::scope asset_scope("write", asset.get(), type_to_string(XAssetType(asset->type())));
+				asset_scope.track_streams(buf, MAX_XFILE_COUNT);
+				report.begin_asset();
 
-			// write asset
-			asset->write(this, buf);
+				// push stream
+				buf->push_stream(XFILE_BLOCK_TEMP);
+				buf->align(7);
 
-			// pop stream
-			buf->pop_stream();
+				// write asset
+				asset->write(this, buf);
+
+				// pop stream
+				buf->pop_stream();
+
+				report.end_asset(asset.get(), type_to_string(XAssetType(asset->type())));
+			}
 		}
 
 		// pop stream
@@ -945,11 +1009,19 @@ namespace zonetool::iw7
 #if (COMPRESSOR == COMPRESSOR_BLOCK)
 #ifdef FF_SIGNED
 		std::vector<DB_AuthHash> chunk_hashes{};
-		const auto buf_compressed = compression::iwc::compress_block_signed(buf->buffer(), buf->size(), COMPRESS_BLOCK_TYPE, chunk_hashes);
+		const auto buf_compressed = [&]
+		{
+			profiler::scope _("phase", "compress");
+			return compression::iwc::compress_block_signed(buf->buffer(), buf->size(), COMPRESS_BLOCK_TYPE, chunk_hashes);
+		}();
 		const auto buf_output = buf_compressed.data();
 		const auto buf_output_size = buf_compressed.size();
 #else
-		const auto buf_compressed = compression::iwc::compress_block(buf->buffer(), buf->size(), COMPRESS_BLOCK_TYPE);
+		const auto buf_compressed = [&]
+		{
+			profiler::scope _("phase", "compress");
+			return compression::iwc::compress_block(buf->buffer(), buf->size(), COMPRESS_BLOCK_TYPE);
+		}();
 		const auto buf_output = buf_compressed.data();
 		const auto buf_output_size = buf_compressed.size();
 #endif
@@ -1102,7 +1174,16 @@ namespace zonetool::iw7
 		assert(fastfile.size() == header.fileLen);
 
 		std::string path = this->name_ + ".ff";
-		fastfile.save(path);
+		{
+			profiler::scope _("phase", "save");
+			fastfile.save(path);
+		}
+
+		report.save(path, COMPRESS_BLOCK_TYPE == COMPRESS_BLOCK_TYPE_LZ4 ? size_report::codec::lz4 : size_report::codec::zlib);
+		asset_order::write_graph(this->m_dependencies, path, [](const std::int32_t type)
+		{
+			return type_to_string(XAssetType(type));
+		});
 
 		ZONETOOL_INFO("Successfully compiled fastfile \"%s\"!", this->name_.data());
 		ZONETOOL_INFO("Compiling took %llu msec.", (GetTickCount64() - start_time));
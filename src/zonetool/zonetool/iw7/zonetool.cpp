@@ -7,6 +7,7 @@
 #include "../utils/csv_generator.hpp"
 
 #include "zonetool/utils/compression.hpp"
+#include "zonetool/utils/profiler.hpp"
 
 #include "../utils/gsc.hpp"
 #include "zonetool/utils/csv_generator.hpp"
@@ -78,10 +79,15 @@ namespace zonetool::iw7
 		return false;
 	}
 
+	bool is_database_ready()
+	{
+		return WaitForSingleObject(*reinterpret_cast<HANDLE*>(0x14602BD40), 0) == WAIT_OBJECT_0;
+	}
+
 	void wait_for_database()
 	{
 		// wait for database to be ready
-		while (!WaitForSingleObject(*reinterpret_cast<HANDLE*>(0x14602BD40), 0) == 0)
+		while (!is_database_ready())
 		{
 			Sleep(5);
 		}
@@ -351,10 +357,12 @@ namespace zonetool::iw7
 	utils::hook::detour db_finish_load_x_file_hook;
 	void db_finish_load_x_file_stub()
 	{
-		if (std::string(g_load->file->name) == filesystem::get_fastfile() &&
+		const std::string zone = g_load->file->name;
+		if (globals.load_finished.is_awaited(zone) &&
 			reinterpret_cast<std::uintptr_t>(_ReturnAddress()) == 0x1409E7745ui64)
 		{
 			stop_dumping();
+			globals.load_finished.signal(zone);
 		}
 		return db_finish_load_x_file_hook.invoke<void>();
 	}
@@ -431,6 +439,19 @@ namespace zonetool::iw7
 		ZONETOOL_INFO("Unloaded loaded zones...");
 	}
 
+	// a zone that fails to load never reaches the finish hook, reset the dump state instead of waiting forever
+	bool wait_for_zone_load(const std::string& name)
+	{
+		if (globals.load_finished.wait(is_database_ready))
+		{
+			return true;
+		}
+
+		ZONETOOL_ERROR("Zone \"%s\" did not finish loading", name.data());
+		stop_dumping();
+		return false;
+	}
+
 	void dump_zone(const std::string& name, const game::game_mode target, const std::optional<std::string> fastfile = {})
 	{
 		if (!zone_exists(name.data()))
@@ -455,17 +476,16 @@ namespace zonetool::iw7
 
 		globals.dump = true;
 		globals.dump_csv = true;
+		globals.load_finished.arm(name);
 		if (!load_zone(name, DB_LOAD_ASYNC, false))
 		{
 			globals.dump = false;
 			globals.dump_csv = false;
+			globals.load_finished.cancel();
 			return;
 		}
 
-		while (globals.dump)
-		{
-			Sleep(1);
-		}
+		wait_for_zone_load(name);
 	}
 
 	void dump_csv(const std::string& name)
@@ -483,15 +503,17 @@ namespace zonetool::iw7
 		filesystem::set_fastfile(name);
 
 		globals.dump_csv = true;
+		globals.load_finished.arm(name);
 		if (!load_zone(name, DB_LOAD_ASYNC, true))
 		{
 			globals.dump_csv = false;
+			globals.load_finished.cancel();
 			return;
 		}
 
-		while (globals.dump_csv)
+		if (!wait_for_zone_load(name))
 		{
-			Sleep(1);
+			return;
 		}
 
 		ZONETOOL_INFO("Csv \"%s\" dumped...", name.data());
@@ -508,15 +530,15 @@ namespace zonetool::iw7
 		wait_for_database();
 
 		globals.verify = true;
+		globals.load_finished.arm(name);
 		if (!load_zone(name, DB_LOAD_ASYNC, true))
 		{
 			globals.verify = false;
+			globals.load_finished.cancel();
+			return;
 		}
 
-		while (globals.verify)
-		{
-			Sleep(1);
-		}
+		wait_for_zone_load(name);
 	}
 
 	void add_assets_using_iterator(const std::string& fastfile, const std::string& type, const std::string& folder,
@@ -854,13 +876,17 @@ namespace zonetool::iw7
 		ignore_assets.clear();
 		clear_asset_fields();
 
+		profiler::begin(fastfile);
+
 		try
 		{
+			profiler::scope _("phase", "parse");
 			parse_csv_file(zone.get(), fastfile, fastfile);
 		}
 		catch (std::exception& ex)
 		{
 			ZONETOOL_ERROR("%s", ex.what());
+			profiler::end();
 			return;
 		}
 
@@ -881,6 +907,9 @@ namespace zonetool::iw7
 		// compile zone
 		zone->build(buffer.get());
 
+		profiler::end();
+		log::flush();
+
 		ignore_assets.clear();
 		clear_asset_fields();
 	}
@@ -2,6 +2,8 @@
 #include "zonetool.hpp"
 #include "zone.hpp"
 #include "zonetool/utils/utils.hpp"
+#include "zonetool/utils/profiler.hpp"
+#include "zonetool/utils/size_report.hpp"
 #include "zonetool/utils/imagefile.hpp"
 
 #include <utils/flags.hpp>
@@ -73,6 +75,8 @@ namespace zonetool::s1
 
 		const std::string& name = get_asset_name(XAssetType(type), pointer);
 
+		this->m_dependencies.add_reference(type, name);
+
 		// don't add asset if it already exists
 		for (std::size_t idx = 0; idx < m_assets.size(); idx++)
 		{
@@ -86,8 +90,16 @@ namespace zonetool::s1
 		if (type == __type__) \
 		{ \
 			auto asset = std::make_shared < ___ >(); \
-			asset->init(pointer, this->m_zonemem.get()); \
-			asset->load_depending(this); \
+			{ \
+				profiler::scope _("parse", name, type_to_string(XAssetType(type))); \
+				asset->init(pointer, this->m_zonemem.get()); \
+			} \
+			{ \
+				profiler::scope _("load_depending", name, type_to_string(XAssetType(type))); \
+				this->m_dependencies.begin_asset(type, name); \
+				asset->load_depending(this); \
+				this->m_dependencies.end_asset(); \
+			} \
 			m_assets.push_back(asset); \
 		}
 
@@ -104,6 +116,20 @@ namespace zonetool::s1
 		}
 	}
 
+	void zone_interface::add_assets_of_type_by_pointer(std::int32_t type, const std::vector<void*>& pointers)
+	{
+		if (type == ASSET_TYPE_LOCALIZE_ENTRY)
+		{
+			add_assets_by_pointer<localize, LocalizeEntry>(this->m_assets, type, pointers);
+			return;
+		}
+
+		for (auto* pointer : pointers)
+		{
+			this->add_asset_of_type_by_pointer(type, pointer);
+		}
+	}
+
 	void zone_interface::add_asset_of_type(std::int32_t type, const std::string& name)
 	{
 		if (name.empty())
@@ -111,6 +137,9 @@ namespace zonetool::s1
 			return;
 		}
 
+		// whatever is loading its dependencies right now has to be written after this
+		this->m_dependencies.add_reference(type, name);
+
 		// don't add asset if it already exists
 		if (get_asset_pointer(type, name))
 		{
@@ -126,8 +155,16 @@ namespace zonetool::s1
 		if (type == __type__) \
 		{ \
 			auto asset = std::make_shared < ___ >(); \
-			asset->init(name, this->m_zonemem.get()); \
-			asset->load_depending(this); \
+			{ \
+				profiler::scope _("parse", name, type_to_string(XAssetType(type))); \
+				asset->init(name, this->m_zonemem.get()); \
+			} \
+			{ \
+				profiler::scope _("load_depending", name, type_to_string(XAssetType(type))); \
+				this->m_dependencies.begin_asset(type, name); \
+				asset->load_depending(this); \
+				this->m_dependencies.end_asset(); \
+			} \
 			m_assets.push_back(asset); \
 		}
 
@@ -201,6 +238,11 @@ namespace zonetool::s1
 		return type_to_int(type);
 	}
 
+	zone_memory* zone_interface::get_memory()
+	{
+		return this->m_zonemem.get();
+	}
+
 	void zone_interface::add_asset_of_type(const std::string& type, const std::string& name)
 	{
 		std::int32_t itype = type_to_int(type);
@@ -215,6 +257,12 @@ namespace zonetool::s1
 
 		ZONETOOL_INFO("Compiling fastfile \"%s\"...", this->name_.data());
 
+		if (asset_order::is_enabled())
+		{
+			profiler::scope _("phase", "sort");
+			asset_order::sort(m_assets, this->m_dependencies);
+		}
+
 		constexpr std::size_t num_streams = 7;
 		XZoneMemory<num_streams> mem;
 
@@ -239,6 +287,7 @@ namespace zonetool::s1
 
 			if (images.size() > 0)
 			{
+				profiler::scope _("phase", "imagefile");
 				imagefile::generate(filesystem::get_fastfile(),
 					CUSTOM_IMAGEFILE_INDEX, FF_VERSION, FF_HEADER, images, this->m_zonemem.get());
 			}
@@ -251,9 +300,13 @@ namespace zonetool::s1
 		std::uintptr_t zero = 0;
 
 		// write asset types to header
-		for (std::size_t i = 0; i < m_assets.size(); i++)
 		{
-			m_assets[i]->prepare(buf, this->m_zonemem.get());
+			profiler::scope _("phase", "prepare");
+			for (std::size_t i = 0; i < m_assets.size(); i++)
+			{
+				profiler::scope asset_scope("prepare", m_assets[i].get(), type_to_string(XAssetType(m_assets[i]->type())));
+				m_assets[i]->prepare(buf, this->m_zonemem.get());
+			}
 		}
 
 		// write scriptstring count
@@ -497,22 +550,34 @@ namespace zonetool::s1
 			buf->write(&pad);
 		}
 
+		// per asset stream usage for -sizereport
+		size_report report(buf, num_streams);
+
 		// write assets
-		for (auto& asset : m_assets)
 		{
+			profiler::scope _("phase", "write");
+			for (auto& asset : m_assets)
+			{
 #ifdef DEBUG
-			ZONETOOL_INFO("writing asset \"%s\" of type %s...", asset->name().data(), type_to_string(XAssetType(asset->type())));
+				ZONETOOL_INFO("writing asset \"%s\" of type %s...", asset->name().data(), type_to_string(XAssetType(asset->type())));
 #endif
 
-			// push stream
-			buf->push_stream(XFILE_BLOCK_TEMP);
-			buf->align(3);
+				profiler::scope asset_scope("write", asset.get(), type_to_string(XAssetType(asset->type())));
+				asset_scope.track_streams(buf, num_streams);
+				report.begin_asset();
 
-			// write asset
-			asset->write(this, buf);
+				// push stream
+				buf->push_stream(XFILE_BLOCK_TEMP);
+				buf->align(3);
 
-			// pop stream
-			buf->pop_stream();
+				// write asset
+				asset->write(this, buf);
+
+				// pop stream
+				buf->pop_stream();
+
+				report.end_asset(asset.get(), type_to_string(XAssetType(asset->type())));
+			}
 		}
 
 		// pop stream
@@ -534,11 +599,15 @@ namespace zonetool::s1
 #endif
 
 		// Compress buffer
+		auto buf_compressed = [&]
+		{
+			profiler::scope _("phase", "compress");
 #if (COMPRESS_TYPE == COMPRESS_TYPE_LZ4)
-		auto buf_compressed = buf->compress_lz4(); // idk how to compress lz4 fastfiles properly
+			return buf->compress_lz4(); // idk how to compress lz4 fastfiles properly
 #elif (COMPRESS_TYPE == COMPRESS_TYPE_ZLIB)
-		auto buf_compressed = buf->compress_zlib();
+			return buf->compress_zlib();
 #endif
+		}();
 
 		// Generate FF header
 		auto header = this->m_zonemem->allocate<XFileHeader>();
@@ -601,7 +670,16 @@ namespace zonetool::s1
 		fastfile.write(buf_compressed.data(), buf_compressed.size());
 
 		std::string path = this->name_ + ".ff";
-		fastfile.save(path);
+		{
+			profiler::scope _("phase", "save");
+			fastfile.save(path);
+		}
+
+		report.save(path, COMPRESS_TYPE == COMPRESS_TYPE_LZ4 ? size_report::codec::lz4 : size_report::codec::zlib);
+		asset_order::write_graph(this->m_dependencies, path, [](const std::int32_t type)
+		{
+			return type_to_string(XAssetType(type));
+		});
 
 		ZONETOOL_INFO("Successfully compiled fastfile \"%s\"!", this->name_.data());
 		ZONETOOL_INFO("Compiling took %llu msec.", (GetTickCount64() - start_time));
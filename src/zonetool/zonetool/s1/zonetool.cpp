@@ -1,6 +1,8 @@
 #include <std_include.hpp>
 #include "zonetool.hpp"
 
+#include "component/s1/fastfiles.hpp"
+
 #include <utils/io.hpp>
 
 #include "zonetool/h1/zonetool.hpp"
@@ -11,6 +13,7 @@
 
 #include "../utils/gsc.hpp"
 #include "../utils/csv_generator.hpp"
+#include "../utils/profiler.hpp"
 
 namespace zonetool::s1
 {
@@ -83,10 +86,15 @@ namespace zonetool::s1
 		return false;
 	}
 
+	bool is_database_ready()
+	{
+		return WaitForSingleObject(*reinterpret_cast<HANDLE*>(0x147DCEC28), 0) == WAIT_OBJECT_0;
+	}
+
 	void wait_for_database()
 	{
 		// wait for database to be ready
-		while (!WaitForSingleObject(*reinterpret_cast<HANDLE*>(0x147DCEC28), 0) == 0)
+		while (!is_database_ready())
 		{
 			Sleep(5);
 		}
@@ -545,8 +553,15 @@ namespace zonetool::s1
 
 	void db_finish_load_x_file_stub()
 	{
+		const auto zone = ::s1::fastfiles::get_current_fastfile();
+		if (!globals.load_finished.is_awaited(zone))
+		{
+			return db_finish_load_x_file_hook.invoke<void>();
+		}
+
 		globals.verify = false;
 		stop_dumping();
+		globals.load_finished.signal(zone);
 		return db_finish_load_x_file_hook.invoke<void>();
 	}
 
@@ -631,6 +646,19 @@ namespace zonetool::s1
 		ZONETOOL_INFO("Unloaded zones...");
 	}
 
+	// a zone that fails to load never reaches the finish hook, reset the dump state instead of waiting forever
+	bool wait_for_zone_load(const std::string& name)
+	{
+		if (globals.load_finished.wait(is_database_ready))
+		{
+			return true;
+		}
+
+		ZONETOOL_ERROR("Zone \"%s\" did not finish loading", name.data());
+		stop_dumping();
+		return false;
+	}
+
 	void dump_zone(const std::string& name, const game::game_mode target, const std::optional<std::string> fastfile = {})
 	{
 		if (!zone_exists(name.data()))
@@ -654,15 +682,15 @@ namespace zonetool::s1
 		}
 
 		globals.dump = true;
+		globals.load_finished.arm(name);
 		if (!load_zone(name, DB_LOAD_ASYNC, false))
 		{
 			globals.dump = false;
+			globals.load_finished.cancel();
+			return;
 		}
 
-		while (globals.dump)
-		{
-			Sleep(1);
-		}
+		wait_for_zone_load(name);
 	}
 
 	void verify_zone(const std::string& name)
@@ -676,15 +704,15 @@ namespace zonetool::s1
 		wait_for_database();
 
 		globals.verify = true;
+		globals.load_finished.arm(name);
 		if (!load_zone(name, DB_LOAD_ASYNC, true))
 		{
 			globals.verify = false;
+			globals.load_finished.cancel();
+			return;
 		}
 
-		while (globals.verify)
-		{
-			Sleep(1);
-		}
+		wait_for_zone_load(name);
 	}
 
 	void add_assets_using_iterator(const std::string& fastfile, const std::string& type, const std::string& folder,
@@ -948,8 +976,11 @@ namespace zonetool::s1
 			return;
 		}
 
+		profiler::begin(fastfile);
+
 		try
 		{
+			profiler::scope _("phase", "parse");
 			parse_csv_file(zone.get(), fastfile, fastfile);
 		}
 		catch (std::exception& ex)
@@ -966,6 +997,9 @@ namespace zonetool::s1
 		// compile zone
 		zone->build(buffer.get());
 
+		profiler::end();
+		log::flush();
+
 		// clear asset shit
 		material::fixed_nml_images_map.clear();
 		techset::vertexdecl_pointers.clear();
@@ -9,6 +9,184 @@ namespace zonetool
 		std::string name_;
 		S* asset_ = nullptr;
 
+		// collects a whole language file before handing it to the zone in one batch
+		class localize_table
+		{
+		public:
+			localize_table(zone_memory* mem)
+				: mem_(mem)
+			{
+			}
+
+			// first definition wins, like .str files did when their entries were added one by one
+			void add(const std::string_view& name, const std::string_view& value)
+			{
+				if (this->entries_by_name_.contains(name))
+				{
+					return;
+				}
+
+				this->insert(name, value);
+			}
+
+			// last definition wins, like reading the json into an object did
+			void set(const std::string_view& name, const std::string_view& value)
+			{
+				const auto itr = this->entries_by_name_.find(name);
+				if (itr != this->entries_by_name_.end())
+				{
+					itr->second->value = this->mem_->intern_string(value);
+					return;
+				}
+
+				this->insert(name, value);
+			}
+
+			void sort_by_name()
+			{
+				std::sort(this->entries_.begin(), this->entries_.end(), [](const void* a, const void* b)
+				{
+					return std::strcmp(static_cast<const S*>(a)->name, static_cast<const S*>(b)->name) < 0;
+				});
+			}
+
+			void submit(zone_base* zone)
+			{
+				zone->add_assets_of_type_by_pointer(Type, this->entries_);
+				this->entries_.clear();
+			}
+
+		private:
+			zone_memory* mem_;
+			std::vector<void*> entries_;
+			std::unordered_map<std::string_view, S*> entries_by_name_;
+
+			void insert(const std::string_view& name, const std::string_view& value)
+			{
+				auto* entry = this->mem_->allocate<S>();
+				entry->name = this->mem_->duplicate_string(name);
+				entry->value = this->mem_->intern_string(value);
+
+				this->entries_by_name_.emplace(entry->name, entry);
+				this->entries_.emplace_back(entry);
+			}
+		};
+
+		class localize_json_sax : public nlohmann::json_sax<json>
+		{
+		public:
+			localize_json_sax(localize_table& table)
+				: table_(table)
+			{
+			}
+
+			bool null() override
+			{
+				return this->invalid_value();
+			}
+
+			bool boolean(bool) override
+			{
+				return this->invalid_value();
+			}
+
+			bool number_integer(number_integer_t) override
+			{
+				return this->invalid_value();
+			}
+
+			bool number_unsigned(number_unsigned_t) override
+			{
+				return this->invalid_value();
+			}
+
+			bool number_float(number_float_t, const string_t&) override
+			{
+				return this->invalid_value();
+			}
+
+			bool string(string_t& value) override
+			{
+				if (this->depth_ != 1)
+				{
+					return this->invalid_value();
+				}
+
+				this->table_.set(this->key_, value);
+				return true;
+			}
+
+			bool binary(binary_t&) override
+			{
+				return this->invalid_value();
+			}
+
+			bool start_object(std::size_t) override
+			{
+				if (this->depth_++ != 0)
+				{
+					return this->invalid_value();
+				}
+
+				return true;
+			}
+
+			bool key(string_t& name) override
+			{
+				this->key_ = std::move(name);
+				return true;
+			}
+
+			bool end_object() override
+			{
+				this->depth_--;
+				return true;
+			}
+
+			bool start_array(std::size_t) override
+			{
+				return this->invalid_value();
+			}
+
+			bool end_array() override
+			{
+				return true;
+			}
+
+			bool parse_error(std::size_t position, const std::string&, const nlohmann::detail::exception& ex) override
+			{
+				ZONETOOL_ERROR("Localized strings json is malformed at byte %zu: %s", position, ex.what());
+				return false;
+			}
+
+		private:
+			localize_table& table_;
+			string_t key_;
+			int depth_ = 0;
+
+			bool invalid_value()
+			{
+				if (this->depth_ == 0)
+				{
+					ZONETOOL_ERROR("Localized strings json file should be an object!");
+				}
+				else
+				{
+					ZONETOOL_ERROR("Localized string \"%s\" should be a string!", this->key_.data());
+				}
+
+				return false;
+			}
+		};
+
+		static std::string_view next_line(std::string_view& text)
+		{
+			const auto end = text.find('\n');
+			const auto line = text.substr(0, end);
+			text.remove_prefix(end == std::string_view::npos ? text.size() : end + 1);
+			return line;
+		}
+
 	public:
 		static bool parse_localizedstrings_json(zone_base* zone, const std::string& file_name)
 		{
@@ -25,39 +203,21 @@ namespace zonetool
 
 			const auto size = file.size();
 			const auto bytes = file.read_bytes(size);
-			const auto localize = json::parse(bytes);
+			file.close();
 
 			ZONETOOL_INFO("Parsing localizedstrings \"%s.json\"...", file_name.data());
-			if (!localize.is_object())
-			{
-				ZONETOOL_ERROR("Localized strings json file should be an object!");
-				return false;
-			}
-
-			for (const auto& [key, value] : localize.items())
-			{
-				const auto value_str = value.get<std::string>();
 
-				S loc{};
-				loc.name = key.data();
-				loc.value = value_str.data();
+			localize_table table(zone->get_memory());
+			localize_json_sax sax(table);
 
-				auto type = zone->get_type_by_name("localize");
-				if (type == -1)
-				{
-					ZONETOOL_ERROR("Could not translate typename localize to an integer!");
-				}
-				try
-				{
-					zone->add_asset_of_type_by_pointer(type, &loc);
-				}
-				catch (const std::exception& e)
-				{
-					ZONETOOL_FATAL("A fatal exception occured while adding localizedstring: \"%s\" from file: \"%s\", exception was: \n%s",
-						key.data(), path.data(), e.what());
-				}
+			if (!json::sax_parse(bytes.begin(), bytes.end(), &sax))
+			{
+				return false;
 			}
 
+			// keep the key order the zone used to get these in
+			table.sort_by_name();
+			table.submit(zone);
 			return true;
 		}
 
@@ -68,161 +228,138 @@ namespace zonetool
 			file.open("rb");
 
 			auto* fp = file.get_fp();
-			if (fp)
+			if (!fp)
 			{
-				ZONETOOL_INFO("Parsing localizedstrings \"%s.str\"...", file_name.data());
+				return false;
+			}
 
-				auto bytes = file.read_bytes(file.size());
-				std::string str = std::string(bytes.begin(), bytes.end());
+			ZONETOOL_INFO("Parsing localizedstrings \"%s.str\"...", file_name.data());
 
-				std::stringstream stringstream(str);
-				std::string string;
+			const auto bytes = file.read_bytes(file.size());
+			file.close();
 
-				char* data;
-				size_t size = 0;
+			localize_table table(zone->get_memory());
 
-				bool failed = false;
-				std::string name;
-				std::string value;
-				size_t line = 0;
-				size_t i = 0;
-				while (getline(stringstream, string))
+			// lines are read in place, past the end reads as a terminator
+			std::string_view text(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+			std::string_view data;
+			const auto at = [&](const std::size_t index)
+			{
+				return index < data.size() ? data[index] : '\0';
+			};
+
+			bool failed = false;
+			std::string_view name;
+			std::string value;
+			size_t line = 0;
+			size_t i = 0;
+			while (!text.empty())
+			{
+				data = next_line(text);
+				const auto size = data.size();
+				++line;
+				if (size < 2)
+					continue;
+				for (i = 0; i < size; i++)
 				{
-					data = string.data();
-					size = string.size();
-					++line;
-					if (size < 2)
+					if (i + 1 < size && data[i] == '/' && data[i + 1] == '/')
+						break;
+					if (isspace(static_cast<unsigned char>(data[i])))
 						continue;
-					for (i = 0; i < size; i++)
+					if (data[i] >= 'A' && data[i] <= 'Z')
 					{
-						if (i + 1 < size && data[i] == '/' && data[i + 1] == '/')
+						const auto remaining = data.substr(i);
+						if (remaining.starts_with("REFERENCE"))
+						{
+							i += 9;
+							while (isspace(static_cast<unsigned char>(at(i))))
+							{
+								i++;
+							}
+
+							const auto start = i;
+							while (i < size && !isspace(static_cast<unsigned char>(data[i])))
+							{
+								i++;
+							}
+							name = data.substr(start, i - start);
 							break;
-						if (isspace(data[i]))
-							continue;
-						if (data[i] >= 'A' && data[i] <= 'Z')
+						}
+						if (remaining.starts_with("LANG_"))
 						{
-							if (!strncmp(&data[i], "REFERENCE", 9))
+							i += 5;
+							while (at(i) != '"')
 							{
-								i += 9;
-								while (isspace(data[i]))
-								{
-									if (i >= size)
-									{
-										failed = true;
-										break;
-									}
-									i++;
-								}
-								if (failed)
+								if (i >= size)
 								{
+									failed = true;
 									break;
 								}
-
-								name.clear();
-								while (!isspace(data[i]))
-								{
-									if (i >= size)
-									{
-										break;
-									}
-									name += data[i];
-									i++;
-								}
+								i++;
+							}
+							if (failed)
+							{
 								break;
 							}
-							if (!strncmp(&data[i], "LANG_", 5))
+
+							i++;
+							value.clear();
+							while (at(i) != '"')
 							{
-								i += 5;
-								while (data[i] != '"')
-								{
-									if (i >= size)
-									{
-										failed = true;
-										break;
-									}
-									i++;
-								}
-								if (failed)
+								if (i >= size)
 								{
+									failed = true;
 									break;
 								}
-
-								i++;
-								value.clear();
-								while (data[i] != '"')
+								if (data[i] == '\\' && i + 1 < size)
 								{
-									if (i >= size)
+									switch (data[i + 1])
 									{
-										failed = true;
+									case 'n':
+										value += '\n';
+										i += 2;
 										break;
-									}
-									if (data[i] == '\\' && i + 1 < size)
-									{
-										switch (data[i + 1])
-										{
-										case 'n':
-											value += '\n';
-											i += 2;
-											break;
-										case 't':
-											value += '\t';
-											i += 2;
-											break;
-										default:
-											value += '\\';
-											i++;
-											break;
-										}
-									}
-									else
-									{
-										value += data[i];
+									case 't':
+										value += '\t';
+										i += 2;
+										break;
+									default:
+										value += '\\';
 										i++;
+										break;
 									}
 								}
-								break;
-							}
-							if (!strncmp(&data[i], "ENDMARKER", 9))
-							{
-								file.close();
-								return true;
+								else
+								{
+									value += data[i];
+									i++;
+								}
 							}
+							break;
 						}
-					}
-					if (failed)
-					{
-						ZONETOOL_WARNING("\"%s\" parse failed at line: %zu index: %zu", path.data(), line, i);
-						file.close();
-						return false;
-					}
-					if (!name.empty() && !value.empty())
-					{
-						S loc{};
-						loc.name = name.data();
-						loc.value = value.data();
-
-						auto type = zone->get_type_by_name("localize");
-						if (type == -1)
-						{
-							ZONETOOL_ERROR("Could not translate typename localize to an integer!");
-						}
-						try
-						{
-							zone->add_asset_of_type_by_pointer(type, &loc);
-						}
-						catch (std::exception& ex)
+						if (remaining.starts_with("ENDMARKER"))
 						{
-							ZONETOOL_FATAL("A fatal exception occured while adding localizedstring: \"%s\" from file: \"%s\", exception was: \n%s",
-								name.data(), path.data(), ex.what());
+							table.submit(zone);
+							return true;
 						}
-						name.clear();
-						value.clear();
 					}
 				}
-				file.close();
-				return true;
+				if (failed)
+				{
+					ZONETOOL_WARNING("\"%s\" parse failed at line: %zu index: %zu", path.data(), line, i);
+					table.submit(zone);
+					return false;
+				}
+				if (!name.empty() && !value.empty())
+				{
+					table.add(name, value);
+					name = {};
+					value.clear();
+				}
 			}
-			return false;
+
+			table.submit(zone);
+			return true;
 		}
 
 		S* parse(const std::string& name, zone_memory* mem)
@@ -268,6 +405,13 @@ namespace zonetool
 			this->name_ = this->asset_->name;
 		}
 
+		// entries from a localize_table already live in zone memory
+		void init(S* asset)
+		{
+			this->asset_ = asset;
+			this->name_ = this->asset_->name;
+		}
+
 		void init(const std::string& name, zone_memory* mem)
 		{
 			this->name_ = name;
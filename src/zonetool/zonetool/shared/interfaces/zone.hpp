@@ -17,11 +17,44 @@ namespace zonetool
 		virtual void* get_asset_pointer(std::int32_t type, const std::string& name) = 0;
 
 		virtual void add_asset_of_type_by_pointer(std::int32_t type, void* pointer) = 0;
+		// pointers must already live in the zone memory, assets with a name that is already taken are skipped
+		virtual void add_assets_of_type_by_pointer(std::int32_t type, const std::vector<void*>& pointers) = 0;
 
 		virtual void add_asset_of_type(const std::string& type, const std::string& name) = 0;
 		virtual void add_asset_of_type(std::int32_t type, const std::string& name) = 0;
 		virtual std::int32_t get_type_by_name(const std::string& type) = 0;
 
+		virtual zone_memory* get_memory() = 0;
+
 		virtual void build(zone_buffer* buf) = 0;
 	};
+
+	// the batch part of add_assets_of_type_by_pointer, one pass over the zone for the names it already has instead of
+	// one per entry. Asset takes the entry through init(Entry*)
+	template <typename Asset, typename Entry, typename Assets>
+	void add_assets_by_pointer(Assets& assets, const std::int32_t type, const std::vector<void*>& pointers)
+	{
+		std::unordered_set<std::string> names;
+		for (const auto& asset : assets)
+		{
+			if (asset->type() == type)
+			{
+				names.emplace(asset->name());
+			}
+		}
+
+		assets.reserve(assets.size() + pointers.size());
+		for (auto* pointer : pointers)
+		{
+			auto* entry = static_cast<Entry*>(pointer);
+			if (!entry || !names.emplace(entry->name).second)
+			{
+				continue;
+			}
+
+			auto asset = std::make_shared<Asset>();
+			asset->init(entry);
+			assets.push_back(std::move(asset));
+		}
+	}
 }
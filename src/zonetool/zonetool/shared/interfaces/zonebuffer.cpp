@@ -137,6 +137,34 @@ namespace zonetool
 		return write_stream(str.data(), str.size() + 1);
 	}
 
+	char* zone_buffer::write_pooled_str(const char* str)
+	{
+		// runtime block data isn't in the file and the temp block (0 in every game) is gone once the asset is loaded,
+		// neither can be pointed back at
+		if (this->stream_ == this->zone_stream_runtime || this->stream_ == 0)
+		{
+			return this->write_str(str);
+		}
+
+		const auto found = this->pooled_strings_.find(str);
+		if (found != this->pooled_strings_.end() && found->second.stream == this->stream_)
+		{
+			return this->get_zone_pointer<char>(found->second.stream, found->second.ptr);
+		}
+
+		const auto size = std::strlen(str) + 1;
+
+		sub_zone_buffer buffer{};
+		buffer.start = reinterpret_cast<std::size_t>(str);
+		buffer.end = buffer.start + size;
+		buffer.ptr = this->zone_streams_[this->stream_];
+		buffer.stream = this->stream_;
+		this->pooled_strings_[str] = buffer;
+
+		this->write_stream(str, size);
+		return reinterpret_cast<char*>(this->data_following);
+	}
+
 	std::vector<std::uint8_t>* zone_buffer::buffer_raw()
 	{
 		return &this->buffer_;
@@ -162,6 +190,7 @@ namespace zonetool
 		this->length_ = 0;
 
 		this->sub_zone_buffers_.clear();
+		this->pooled_strings_.clear();
 		this->init_script_strings();
 		this->depth_stencil_state_bits_.clear();
 		this->blend_state_bits_.clear();
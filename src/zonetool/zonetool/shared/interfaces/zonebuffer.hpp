@@ -146,6 +146,11 @@ namespace zonetool
 		char* write_str(const std::string& _str);
 		void write_str_raw(const std::string& _str);
 
+		// for strings owned by zone memory: the first write of a pointer emits the string, later writes of the same
+		// pointer in the same stream point back at it. only zone_memory::intern_string hands out shared pointers,
+		// duplicate_string copies are private. the runtime and temp blocks always get their own copy
+		char* write_pooled_str(const char* str);
+
 		template <typename T>
 		T* write(T* data, const std::size_t count = 1)
 		{
@@ -244,6 +249,7 @@ namespace zonetool
 		void init_script_strings();
 
 		std::vector<sub_zone_buffer> sub_zone_buffers_;
+		std::unordered_map<const char*, sub_zone_buffer> pooled_strings_;
 
 	};
 }
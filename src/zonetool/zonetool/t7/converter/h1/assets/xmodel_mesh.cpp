@@ -6,6 +6,10 @@
 
 #include "zonetool/t7/common/xpak.hpp"
 
+#include "zonetool/utils/vertex_convert.hpp"
+
+#include <utils/flags.hpp>
+
 namespace zonetool::t7
 {
 	namespace converter::h1
@@ -184,61 +188,24 @@ namespace zonetool::t7
 
 						new_surf->verts0.packedVerts0 = allocator.allocate_array<zonetool::h1::GfxPackedVertex>(new_surf->vertCount);
 
-						for (auto j = 0; j < new_surf->vertCount; j++)
-						{
-							new_surf->verts0.packedVerts0[j].xyz[0] = positions[j][0];
-							new_surf->verts0.packedVerts0[j].xyz[1] = positions[j][1];
-							new_surf->verts0.packedVerts0[j].xyz[2] = positions[j][2];
-
-							new_surf->verts0.packedVerts0[j].color.array[0] = verts[j].Color[0];
-							new_surf->verts0.packedVerts0[j].color.array[1] = verts[j].Color[1];
-							new_surf->verts0.packedVerts0[j].color.array[2] = verts[j].Color[2];
-							new_surf->verts0.packedVerts0[j].color.array[3] = verts[j].Color[3];
-
-							memcpy(&new_surf->verts0.packedVerts0[j].texCoord.packed, &verts[j].UVUPosition, sizeof(int)); // check
-
-							new_surf->verts0.packedVerts0[j].normal.packed = verts[j].VertexNormal;
-							new_surf->verts0.packedVerts0[j].tangent.packed = verts[j].VertexTangent;
-
-							float unpacked_normal[3]{};
-							PackedVec::Vec3UnpackUnitVec_IW8(verts[j].VertexNormal, unpacked_normal);
+						static_assert(sizeof(zonetool::h1::GfxPackedVertex) == sizeof(vertex_convert::packed_vertex));
+						static_assert(sizeof(GfxStreamVertex) == sizeof(vertex_convert::stream_vertex));
 
-							float unpacked_tangent[3]{};
-							PackedVec::Vec3UnpackUnitVec_IW8(verts[j].VertexTangent, unpacked_tangent);
-
-							new_surf->verts0.packedVerts0[j].binormalSign = 1.0f; // check
-						}
+						vertex_convert::interleave(reinterpret_cast<vertex_convert::packed_vertex*>(new_surf->verts0.packedVerts0), positions,
+							reinterpret_cast<const vertex_convert::stream_vertex*>(verts), std::bit_cast<std::uint32_t>(1.0f), new_surf->vertCount); // check binormalSign
 
 						new_surf->triIndices = reinterpret_cast<zonetool::h1::Face*>(indices);
 						new_surf->triIndices2 = reinterpret_cast<zonetool::h1::Face*>(indices);
 
-						std::vector<GfxStreamWeight*> weights_arr[4];
 						if ((surf->flags & XSURFACE_FLAG_SKINNED) != 0)
 						{
+							static_assert(sizeof(GfxStreamWeight) == sizeof(vertex_convert::stream_weight));
+
 							// calc counts
-							for (auto j = 0u; j < surf->vertCount; j++)
+							const auto buckets = vertex_convert::bucket_blend_weights(reinterpret_cast<const vertex_convert::stream_weight*>(weights), surf->vertCount);
+							for (auto j = 0u; j < buckets.counts.size(); j++)
 							{
-								auto weight = &weights[j];
-
-								auto idx = 0;
-
-								if (weight->WeightVal2)
-								{
-									idx++;
-								}
-
-								if (weight->WeightVal3)
-								{
-									idx++;
-								}
-
-								if (weight->WeightVal4)
-								{
-									idx++;
-								}
-
-								new_surf->blendVertCounts[idx]++;
-								weights_arr[idx].push_back(weight);
+								new_surf->blendVertCounts[j] = buckets.counts[j];
 							}
 
 							const auto total_blend_verts = (new_surf->blendVertCounts[0]
@@ -254,9 +221,10 @@ namespace zonetool::t7
 							{
 								new_surf->blendVerts = allocator.manual_allocate<zonetool::h1::XBlendInfo>(2 * total_blend_verts);
 								unsigned short b = 0;
+								std::uint32_t w = 0;
 								for (short s = 0; s < (new_surf->blendVertCounts[0]); s++)
 								{
-									auto weight = weights_arr[0][s];
+									auto weight = &weights[buckets.order[w++]];
 
 									new_surf->blendVerts[b] = weight->WeightID1 * 64;
 
@@ -265,7 +233,7 @@ namespace zonetool::t7
 
 								for (short s = 0; s < (new_surf->blendVertCounts[1]); s++)
 								{
-									auto weight = weights_arr[1][s];
+									auto weight = &weights[buckets.order[w++]];
 
 									new_surf->blendVerts[b] = weight->WeightID1 * 64;
 									new_surf->blendVerts[b + 1] = weight->WeightID2 * 64;
@@ -277,7 +245,7 @@ namespace zonetool::t7
 
 								for (short s = 0; s < (new_surf->blendVertCounts[2]); s++)
 								{
-									auto weight = weights_arr[2][s];
+									auto weight = &weights[buckets.order[w++]];
 
 									new_surf->blendVerts[b] = weight->WeightID1 * 64;
 									new_surf->blendVerts[b + 1] = weight->WeightID2 * 64;
@@ -291,7 +259,7 @@ namespace zonetool::t7
 
 								for (short s = 0; s < (new_surf->blendVertCounts[3]); s++)
 								{
-									auto weight = weights_arr[3][s];
+									auto weight = &weights[buckets.order[w++]];
 
 									new_surf->blendVerts[b] = weight->WeightID1 * 64;
 									new_surf->blendVerts[b + 1] = weight->WeightID2 * 64;
@@ -313,13 +281,8 @@ namespace zonetool::t7
 
 					// unknown
 					new_surf->unknown0 = allocator.allocate_array<zonetool::h1::UnknownXSurface0>(new_surf->vertCount); // related to indices2?
-					for (unsigned short j = 0; j < new_surf->vertCount; j++)
-					{
-						new_surf->unknown0[j].xyz[0] = new_surf->verts0.packedVerts0[j].xyz[0];
-						new_surf->unknown0[j].xyz[1] = new_surf->verts0.packedVerts0[j].xyz[1];
-						new_surf->unknown0[j].xyz[2] = new_surf->verts0.packedVerts0[j].xyz[2];
-						new_surf->unknown0[j].normal = new_surf->verts0.packedVerts0[j].normal;
-					}
+					vertex_convert::extract_position_normals(reinterpret_cast<vertex_convert::position_normal*>(new_surf->unknown0),
+						reinterpret_cast<const vertex_convert::packed_vertex*>(new_surf->verts0.packedVerts0), new_surf->vertCount);
 
 					static_assert(sizeof(zonetool::h1::XRigidVertList) == sizeof(zonetool::t7::XRigidVertList));
 					static_assert(sizeof(zonetool::h1::XSurfaceCollisionTree) == sizeof(zonetool::t7::XSurfaceCollisionTree));
@@ -333,6 +296,14 @@ namespace zonetool::t7
 
 				memcpy(new_asset->partBits, asset->partBits, sizeof(float[8]));
 
+				if (utils::flags::has_flag("optimizemeshes"))
+				{
+					zonetool::h1::xsurface::optimize(new_asset, [&](const std::size_t size)
+					{
+						return allocator.allocate_array<char>(size);
+					});
+				}
+
 				return new_asset;
 			}
 
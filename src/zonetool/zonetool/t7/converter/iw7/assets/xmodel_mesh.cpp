@@ -6,13 +6,15 @@
 
 #include "zonetool/t7/common/xpak.hpp"
 
+#include "zonetool/utils/vertex_convert.hpp"
+
 namespace zonetool::t7
 {
 	namespace converter::iw7
 	{
 		namespace xmodel_mesh
 		{
-			void GenerateIW7BlendVerts(zonetool::iw7::XSurface* surf, utils::memory::allocator& mem, std::vector<GfxStreamWeight*>* weights_arr)
+			void GenerateIW7BlendVerts(zonetool::iw7::XSurface* surf, utils::memory::allocator& mem, GfxStreamWeight* weights, const vertex_convert::blend_buckets& buckets)
 			{
 				unsigned int size = (2 * surf->blendVertCounts[0]
 					+ 4 * surf->blendVertCounts[1]
@@ -27,16 +29,17 @@ namespace zonetool::t7
 				assert(surf->blendVertSize % 2 == 0);
 
 				unsigned int a = 0;
+				std::uint32_t w = 0;
 				for (unsigned short s = 0; s < surf->blendVertCounts[0]; s++)
 				{
-					auto weight = weights_arr[0][s];
+					auto weight = &weights[buckets.order[w++]];
 					surf->blendVerts[a++] = weight->WeightID1;
 					surf->blendVerts[a++] = 0;
 				}
 
 				for (unsigned short s = 0; s < surf->blendVertCounts[1]; s++)
 				{
-					auto weight = weights_arr[1][s];
+					auto weight = &weights[buckets.order[w++]];
 					surf->blendVerts[a++] = weight->WeightID1;
 					surf->blendVerts[a++] = weight->WeightID2;
 					surf->blendVerts[a++] = weight->WeightVal1;
@@ -45,7 +48,7 @@ namespace zonetool::t7
 
 				for (unsigned short s = 0; s < surf->blendVertCounts[2]; s++)
 				{
-					auto weight = weights_arr[2][s];
+					auto weight = &weights[buckets.order[w++]];
 					surf->blendVerts[a++] = weight->WeightID1;
 					surf->blendVerts[a++] = weight->WeightID2;
 					surf->blendVerts[a++] = weight->WeightVal1;
@@ -56,7 +59,7 @@ namespace zonetool::t7
 
 				for (unsigned short s = 0; s < surf->blendVertCounts[3]; s++)
 				{
-					auto weight = weights_arr[3][s];
+					auto weight = &weights[buckets.order[w++]];
 					surf->blendVerts[a++] = weight->WeightID1;
 					surf->blendVerts[a++] = weight->WeightID2;
 					surf->blendVerts[a++] = weight->WeightVal1;
@@ -125,58 +128,28 @@ namespace zonetool::t7
 
 						new_surf->verts0.packedVerts0 = allocator.allocate_array<zonetool::iw7::GfxPackedVertex>(new_surf->vertCount);
 
-						for (auto j = 0; j < new_surf->vertCount; j++)
-						{
-							new_surf->verts0.packedVerts0[j].xyz[0] = positions[j][0];
-							new_surf->verts0.packedVerts0[j].xyz[1] = positions[j][1];
-							new_surf->verts0.packedVerts0[j].xyz[2] = positions[j][2];
-
-							new_surf->verts0.packedVerts0[j].color.array[0] = verts[j].Color[0];
-							new_surf->verts0.packedVerts0[j].color.array[1] = verts[j].Color[1];
-							new_surf->verts0.packedVerts0[j].color.array[2] = verts[j].Color[2];
-							new_surf->verts0.packedVerts0[j].color.array[3] = verts[j].Color[3];
+						static_assert(sizeof(zonetool::iw7::GfxPackedVertex) == sizeof(vertex_convert::packed_vertex));
+						static_assert(sizeof(GfxStreamVertex) == sizeof(vertex_convert::stream_vertex));
 
-							memcpy(&new_surf->verts0.packedVerts0[j].texCoord.packed, &verts[j].UVUPosition, sizeof(int)); // check
-
-							new_surf->verts0.packedVerts0[j].normal.packed = verts[j].VertexNormal;
-							new_surf->verts0.packedVerts0[j].tangent.packed = verts[j].VertexTangent;
-
-							float default_visibility[4] = { 0.0f, 0.0f, 1.0f, 0.0f };
-							new_surf->verts0.packedVerts0[j].selfVisibility.packed = self_visibility::XSurfacePackSelfVisibility(default_visibility);
-						}
+						float default_visibility[4] = { 0.0f, 0.0f, 1.0f, 0.0f };
+						vertex_convert::interleave(reinterpret_cast<vertex_convert::packed_vertex*>(new_surf->verts0.packedVerts0), positions,
+							reinterpret_cast<const vertex_convert::stream_vertex*>(verts), self_visibility::XSurfacePackSelfVisibility(default_visibility),
+							new_surf->vertCount);
 
 						new_surf->triIndices = reinterpret_cast<zonetool::iw7::Face*>(indices);
 
-						std::vector<GfxStreamWeight*> weights_arr[4];
 						if ((surf->flags & XSURFACE_FLAG_SKINNED) != 0)
 						{
+							static_assert(sizeof(GfxStreamWeight) == sizeof(vertex_convert::stream_weight));
+
 							// calc counts
-							for (auto j = 0u; j < surf->vertCount; j++)
+							const auto buckets = vertex_convert::bucket_blend_weights(reinterpret_cast<const vertex_convert::stream_weight*>(weights), surf->vertCount);
+							for (auto j = 0u; j < buckets.counts.size(); j++)
 							{
-								auto weight = &weights[j];
-
-								auto idx = 0;
-
-								if (weight->WeightVal2)
-								{
-									idx++;
-								}
-
-								if (weight->WeightVal3)
-								{
-									idx++;
-								}
-
-								if (weight->WeightVal4)
-								{
-									idx++;
-								}
-
-								new_surf->blendVertCounts[idx]++;
-								weights_arr[idx].push_back(weight);
+								new_surf->blendVertCounts[j] = buckets.counts[j];
 							}
 
-							GenerateIW7BlendVerts(new_surf, allocator, weights_arr);
+							GenerateIW7BlendVerts(new_surf, allocator, weights, buckets);
 						}
 					}
 
@@ -91,10 +91,15 @@ namespace zonetool::t7
 		return false;
 	}
 
+	bool is_database_ready()
+	{
+		return utils::hook::invoke<bool>(0x1405261E0);
+	}
+
 	void wait_for_database()
 	{
 		// wait for database to be ready
-		while (!utils::hook::invoke<bool>(0x1405261E0))
+		while (!is_database_ready())
 		{
 			Sleep(5);
 		}
@@ -368,10 +373,11 @@ namespace zonetool::t7
 	utils::hook::detour db_finish_load_x_file_hook;
 	void db_finish_load_x_file_stub(void* a1, void* a2)
 	{
-		const auto ff_name = *reinterpret_cast<const char**>(0x1468FD4A8);
-		if (ff_name == filesystem::get_fastfile())
+		const std::string ff_name = *reinterpret_cast<const char**>(0x1468FD4A8);
+		if (globals.load_finished.is_awaited(ff_name))
 		{
 			stop_dumping();
+			globals.load_finished.signal(ff_name);
 		}
 		
 		return db_finish_load_x_file_hook.invoke<void>(a1, a2);
@@ -457,6 +463,19 @@ namespace zonetool::t7
 		ZONETOOL_INFO("Unloaded loaded zones...");
 	}
 
+	// a zone that fails to load never reaches the finish hook, reset the dump state instead of waiting forever
+	bool wait_for_zone_load(const std::string& name)
+	{
+		if (globals.load_finished.wait(is_database_ready))
+		{
+			return true;
+		}
+
+		ZONETOOL_ERROR("Zone \"%s\" did not finish loading", name.data());
+		stop_dumping();
+		return false;
+	}
+
 	void dump_zone(const std::string& name, const game::game_mode target, const std::optional<std::string> fastfile = {})
 	{
 		if (!zone_exists(name.data()))
@@ -481,17 +500,16 @@ namespace zonetool::t7
 
 		globals.dump = true;
 		globals.dump_csv = true;
+		globals.load_finished.arm(name);
 		if (!load_zone(name, false, false))
 		{
 			globals.dump = false;
 			globals.dump_csv = false;
+			globals.load_finished.cancel();
 			return;
 		}
 
-		while (globals.dump)
-		{
-			Sleep(1);
-		}
+		wait_for_zone_load(name);
 	}
 
 	void dump_csv(const std::string& name)
@@ -509,15 +527,17 @@ namespace zonetool::t7
 		filesystem::set_fastfile(name);
 
 		globals.dump_csv = true;
+		globals.load_finished.arm(name);
 		if (!load_zone(name, false, true))
 		{
 			globals.dump_csv = false;
+			globals.load_finished.cancel();
 			return;
 		}
 
-		while (globals.dump_csv)
+		if (!wait_for_zone_load(name))
 		{
-			Sleep(1);
+			return;
 		}
 
 		ZONETOOL_INFO("Csv \"%s\" dumped...", name.data());
@@ -534,15 +554,15 @@ namespace zonetool::t7
 		wait_for_database();
 
 		globals.verify = true;
+		globals.load_finished.arm(name);
 		if (!load_zone(name, false, true))
 		{
 			globals.verify = false;
+			globals.load_finished.cancel();
+			return;
 		}
 
-		while (globals.verify)
-		{
-			Sleep(1);
-		}
+		wait_for_zone_load(name);
 	}
 
 	void iterate_zones()
@@ -0,0 +1,302 @@
+#include <std_include.hpp>
+#include "asset_order.hpp"
+
+#include "utils.hpp"
+
+#include <utils/flags.hpp>
+
+namespace zonetool::asset_order
+{
+	namespace
+	{
+		std::optional<bool> enabled_override;
+
+		std::size_t count_type_runs(const std::vector<std::shared_ptr<asset_interface>>& assets)
+		{
+			std::size_t runs = 0;
+			for (auto i = 0u; i < assets.size(); i++)
+			{
+				if (!i || assets[i]->type() != assets[i - 1]->type())
+				{
+					runs++;
+				}
+			}
+
+			return runs;
+		}
+
+		std::string get_graph_path(const std::string& fastfile_path, const char* extension)
+		{
+			return std::filesystem::path(fastfile_path).replace_extension().string() + "_deps" + extension;
+		}
+
+		void write_file(const std::string& path, const std::string& data)
+		{
+			auto file = filesystem::file(path);
+			file.create_path();
+			file.open("wb", false, true);
+			file.write(data.data(), data.size(), 1);
+			file.close();
+		}
+
+		std::string escape_dot(const std::string& value)
+		{
+			std::string result;
+			result.reserve(value.size());
+
+			for (const auto c : value)
+			{
+				if (c == '"' || c == '\\')
+				{
+					result.push_back('\\');
+				}
+
+				result.push_back(c);
+			}
+
+			return result;
+		}
+	}
+
+	bool is_enabled()
+	{
+		return enabled_override.value_or(utils::flags::has_flag("sortassets"));
+	}
+
+	void set_enabled(const std::optional<bool> enabled)
+	{
+		enabled_override = enabled;
+	}
+
+	dependencies::asset_key dependencies::get_key(const std::int32_t type, const std::string& name)
+	{
+		// referenced assets are the same entry with a leading comma
+		return {type, name.starts_with(",") ? name.substr(1) : name};
+	}
+
+	void dependencies::begin_asset(const std::int32_t type, const std::string& name)
+	{
+		auto key = get_key(type, name);
+		if (this->node_keys_.emplace(key).second)
+		{
+			this->nodes_.emplace_back(type, name);
+		}
+
+		this->loading_.emplace_back(std::move(key));
+	}
+
+	void dependencies::end_asset()
+	{
+		this->loading_.pop_back();
+	}
+
+	void dependencies::add_reference(const std::int32_t type, const std::string& name)
+	{
+		if (this->loading_.empty())
+		{
+			return;
+		}
+
+		this->references_[this->loading_.back()].emplace_back(get_key(type, name));
+	}
+
+	void sort(std::vector<std::shared_ptr<asset_interface>>& assets, const dependencies& graph)
+	{
+		const auto count = assets.size();
+
+		std::vector<dependencies::asset_key> keys(count);
+		std::map<dependencies::asset_key, std::size_t> indices;
+		for (auto i = 0u; i < count; i++)
+		{
+			keys[i] = dependencies::get_key(assets[i]->type(), assets[i]->name());
+			indices.emplace(keys[i], i);
+		}
+
+		std::vector<std::vector<std::size_t>> users(count);
+		std::vector<std::size_t> pending(count);
+		for (const auto& [user_key, references] : graph.references_)
+		{
+			const auto user = indices.find(user_key);
+			if (user == indices.end())
+			{
+				continue;
+			}
+
+			for (const auto& reference_key : references)
+			{
+				const auto reference = indices.find(reference_key);
+				if (reference == indices.end() || reference->second == user->second)
+				{
+					continue;
+				}
+
+				users[reference->second].emplace_back(user->second);
+				pending[user->second]++;
+			}
+		}
+
+		const auto compare = [&](const std::size_t a, const std::size_t b)
+		{
+			return std::tie(keys[a], a) > std::tie(keys[b], b);
+		};
+
+		std::priority_queue<std::size_t, std::vector<std::size_t>, decltype(compare)> ready(compare);
+		for (auto i = 0u; i < count; i++)
+		{
+			if (!pending[i])
+			{
+				ready.push(i);
+			}
+		}
+
+		std::vector<std::shared_ptr<asset_interface>> sorted;
+		sorted.reserve(count);
+
+		while (!ready.empty())
+		{
+			const auto index = ready.top();
+			ready.pop();
+
+			sorted.emplace_back(assets[index]);
+			for (const auto user : users[index])
+			{
+				if (!--pending[user])
+				{
+					ready.push(user);
+				}
+			}
+		}
+
+		if (sorted.size() != count)
+		{
+			ZONETOOL_WARNING("Assets depend on each other in a cycle, keeping the csv order");
+			return;
+		}
+
+		ZONETOOL_INFO("Sorted %zu assets, %zu type runs -> %zu", count, count_type_runs(assets), count_type_runs(sorted));
+		assets = std::move(sorted);
+	}
+
+	bool is_graph_export_enabled()
+	{
+		// the parallel parse reads the graph of the previous build, keep it current
+		return utils::flags::has_flag("depgraph") || utils::flags::has_flag("parallelparse");
+	}
+
+	void write_graph(const dependencies& graph, const std::string& fastfile_path, const type_name_callback& get_type_name)
+	{
+		if (!is_graph_export_enabled())
+		{
+			return;
+		}
+
+		auto nodes = graph.nodes_;
+		std::map<dependencies::asset_key, std::size_t> indices;
+		for (auto i = 0u; i < nodes.size(); i++)
+		{
+			indices.emplace(dependencies::get_key(nodes[i].first, nodes[i].second), i);
+		}
+
+		// references to assets that were never parsed by name still show up as nodes
+		const auto get_index = [&](const dependencies::asset_key& key)
+		{
+			const auto [itr, inserted] = indices.emplace(key, nodes.size());
+			if (inserted)
+			{
+				nodes.emplace_back(key);
+			}
+
+			return itr->second;
+		};
+
+		std::vector<std::pair<std::size_t, std::size_t>> edges;
+		for (auto i = 0u; i < graph.nodes_.size(); i++)
+		{
+			const auto itr = graph.references_.find(dependencies::get_key(graph.nodes_[i].first, graph.nodes_[i].second));
+			if (itr == graph.references_.end())
+			{
+				continue;
+			}
+
+			std::set<std::size_t> seen;
+			for (const auto& reference : itr->second)
+			{
+				const auto index = get_index(reference);
+				if (index != i && seen.emplace(index).second)
+				{
+					edges.emplace_back(i, index);
+				}
+			}
+		}
+
+		ordered_json data;
+		data["nodes"] = ordered_json::array();
+		data["edges"] = ordered_json::array();
+
+		std::string dot = "digraph \"" + escape_dot(std::filesystem::path(fastfile_path).stem().string()) + "\"\n{\n";
+		dot += "\tnode [shape=box];\n";
+
+		for (auto i = 0u; i < nodes.size(); i++)
+		{
+			const auto& [type, name] = nodes[i];
+			const auto referenced = name.starts_with(",");
+			const auto type_name = get_type_name(type);
+			const auto asset_name = referenced ? name.substr(1) : name;
+
+			data["nodes"].push_back(
+			{
+				{"type", type_name},
+				{"name", asset_name},
+				{"referenced", referenced},
+			});
+
+			dot += "\tn" + std::to_string(i) + " [label=\"" + escape_dot(type_name) + "\\n" + escape_dot(asset_name) + "\""
+				+ (referenced ? ", style=dashed" : "") + "];\n";
+		}
+
+		for (const auto& [user, reference] : edges)
+		{
+			data["edges"].push_back({user, reference});
+			dot += "\tn" + std::to_string(user) + " -> n" + std::to_string(reference) + ";\n";
+		}
+
+		dot += "}\n";
+
+		write_file(get_graph_path(fastfile_path, ".json"), data.dump(4, ' ', false, ordered_json::error_handler_t::replace));
+		write_file(get_graph_path(fastfile_path, ".dot"), dot);
+
+		ZONETOOL_INFO("Wrote dependency graph with %zu assets and %zu edges", nodes.size(), edges.size());
+	}
+
+	std::vector<std::pair<std::int32_t, std::string>> read_graph_nodes(const std::string& fastfile_path, const type_id_callback& get_type_id)
+	{
+		std::vector<std::pair<std::int32_t, std::string>> nodes;
+
+		std::ifstream stream(get_graph_path(fastfile_path, ".json"), std::ios::binary);
+		if (!stream.is_open())
+		{
+			return nodes;
+		}
+
+		const auto data = json::parse(stream, nullptr, false);
+		if (data.is_discarded() || !data.contains("nodes") || !data["nodes"].is_array())
+		{
+			ZONETOOL_WARNING("Dependency graph of \"%s\" is not valid json", fastfile_path.data());
+			return nodes;
+		}
+
+		for (const auto& node : data["nodes"])
+		{
+			const auto type = get_type_id(node.value("type", ""));
+			if (type < 0)
+			{
+				continue;
+			}
+
+			const auto name = node.value("name", "");
+			nodes.emplace_back(type, node.value("referenced", false) ? "," + name : name);
+		}
+
+		return nodes;
+	}
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace zonetool
+{
+	class asset_interface;
+}
+
+namespace zonetool::asset_order
+{
+	// groups the asset list by type and name before a zone is written so similar data shares compression blocks,
+	// enabled with -sortassets
+	bool is_enabled();
+	void set_enabled(std::optional<bool> enabled);
+
+	using type_name_callback = std::function<std::string(std::int32_t type)>;
+	using type_id_callback = std::function<std::int32_t(const std::string& type)>;
+
+	// records which assets every asset pulls in from load_depending, those have to stay in front of it
+	class dependencies
+	{
+	public:
+		void begin_asset(std::int32_t type, const std::string& name);
+		void end_asset();
+
+		// called for every asset added or looked up while another asset loads its dependencies
+		void add_reference(std::int32_t type, const std::string& name);
+
+	private:
+		friend void sort(std::vector<std::shared_ptr<asset_interface>>& assets, const dependencies& graph);
+		friend void write_graph(const dependencies& graph, const std::string& fastfile_path, const type_name_callback& get_type_name);
+
+		using asset_key = std::pair<std::int32_t, std::string>;
+		static asset_key get_key(std::int32_t type, const std::string& name);
+
+		std::vector<asset_key> loading_;
+		std::map<asset_key, std::vector<asset_key>> references_;
+
+		// every asset in the order it was parsed, under the name it was requested with (referenced ones keep the comma)
+		std::vector<std::pair<std::int32_t, std::string>> nodes_;
+		std::set<asset_key> node_keys_;
+	};
+
+	// stable topological sort: among the assets whose dependencies are already placed, the lowest (type, name) goes next
+	void sort(std::vector<std::shared_ptr<asset_interface>>& assets, const dependencies& graph);
+
+	// -depgraph (or -parallelparse) writes <zone>_deps.json and <zone>_deps.dot next to the fastfile
+	bool is_graph_export_enabled();
+	void write_graph(const dependencies& graph, const std::string& fastfile_path, const type_name_callback& get_type_name);
+
+	// assets of a previously exported graph in the order that build parsed them, empty if there is none
+	std::vector<std::pair<std::int32_t, std::string>> read_graph_nodes(const std::string& fastfile_path, const type_id_callback& get_type_id);
+}
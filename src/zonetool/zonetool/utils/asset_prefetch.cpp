@@ -0,0 +1,168 @@
+#include <std_include.hpp>
+#include "asset_prefetch.hpp"
+
+#include "utils.hpp"
+
+namespace zonetool
+{
+	asset_prefetch::asset_prefetch(const std::vector<asset_key>& keys, parse_callback parse)
+		: parse_(std::move(parse))
+	{
+		this->jobs_.reserve(keys.size());
+		for (const auto& key : keys)
+		{
+			if (this->indices_.emplace(key, this->jobs_.size()).second)
+			{
+				auto& entry = this->jobs_.emplace_back();
+				entry.key = key;
+			}
+		}
+
+		if (this->jobs_.empty())
+		{
+			return;
+		}
+
+		// the loading thread runs load_depending and parses whatever the workers haven't reached yet
+		const auto worker_count = std::min(static_cast<std::size_t>(std::max(2u, std::thread::hardware_concurrency()) - 1), this->jobs_.size());
+		for (auto i = 0u; i < worker_count; i++)
+		{
+			this->workers_.emplace_back(&asset_prefetch::work, this);
+		}
+
+		ZONETOOL_INFO("Prefetching %zu assets on %zu threads", this->jobs_.size(), worker_count);
+	}
+
+	asset_prefetch::~asset_prefetch()
+	{
+		this->stop();
+	}
+
+	std::shared_ptr<asset_interface> asset_prefetch::take(const std::int32_t type, const std::string& name)
+	{
+		const auto itr = this->indices_.find({type, name});
+		if (itr == this->indices_.end())
+		{
+			return {};
+		}
+
+		const auto index = itr->second;
+		auto& entry = this->jobs_[index];
+
+		std::unique_lock lock(this->mutex_);
+		if (entry.status == state::taken)
+		{
+			return {};
+		}
+
+		if (entry.status == state::pending)
+		{
+			entry.status = state::parsing;
+			lock.unlock();
+			this->run(index);
+			lock.lock();
+		}
+
+		this->job_done_.wait(lock, [&]
+		{
+			return entry.status == state::done;
+		});
+
+		entry.status = state::taken;
+		this->taken_count_++;
+
+		if (entry.error)
+		{
+			std::rethrow_exception(std::exchange(entry.error, nullptr));
+		}
+
+		return std::move(entry.asset);
+	}
+
+	void asset_prefetch::stop()
+	{
+		{
+			std::lock_guard _(this->mutex_);
+			if (this->stopping_)
+			{
+				return;
+			}
+
+			this->stopping_ = true;
+		}
+
+		for (auto& worker : this->workers_)
+		{
+			if (worker.joinable())
+			{
+				worker.join();
+			}
+		}
+
+		if (!this->jobs_.empty())
+		{
+			ZONETOOL_INFO("Used %zu of %zu prefetched assets", this->taken_count_, this->jobs_.size());
+		}
+
+		this->jobs_.clear();
+		this->indices_.clear();
+	}
+
+	void asset_prefetch::run(const std::size_t index)
+	{
+		auto& entry = this->jobs_[index];
+
+		std::shared_ptr<asset_interface> asset;
+		std::exception_ptr error;
+
+		try
+		{
+			asset = this->parse_(entry.key.first, entry.key.second);
+		}
+		catch (const database_unavailable&)
+		{
+			// not on disk, take's caller parses it again with the database fallback
+		}
+		catch (...)
+		{
+			error = std::current_exception();
+		}
+
+		{
+			std::lock_guard _(this->mutex_);
+			entry.asset = std::move(asset);
+			entry.error = error;
+			entry.status = state::done;
+		}
+
+		this->job_done_.notify_all();
+	}
+
+	void asset_prefetch::work()
+	{
+		set_database_access(false);
+
+		while (true)
+		{
+			std::size_t index;
+
+			{
+				std::lock_guard _(this->mutex_);
+				while (this->next_job_ < this->jobs_.size() && this->jobs_[this->next_job_].status != state::pending)
+				{
+					this->next_job_++;
+				}
+
+				if (this->stopping_ || this->next_job_ == this->jobs_.size())
+				{
+					return;
+				}
+
+				index = this->next_job_++;
+				this->jobs_[index].status = state::parsing;
+			}
+
+			this->run(index);
+		}
+	}
+}
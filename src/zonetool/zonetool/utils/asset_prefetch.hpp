@@ -0,0 +1,73 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace zonetool
+{
+	class asset_interface;
+
+	// parses the assets of a previous build's dependency graph on worker threads while the zone loads them serially.
+	// parsing an asset never looks at the assets it depends on, only load_depending does, so every node can be parsed
+	// on its own. the jobs run in the order the last build parsed them, which is the order the zone will ask for them.
+	// workers have no access to the game's asset database, a parse that falls back to it is left to take's caller
+	class asset_prefetch
+	{
+	public:
+		using asset_key = std::pair<std::int32_t, std::string>;
+		using parse_callback = std::function<std::shared_ptr<asset_interface>(std::int32_t type, const std::string& name)>;
+
+		asset_prefetch(const std::vector<asset_key>& keys, parse_callback parse);
+		~asset_prefetch();
+
+		asset_prefetch(const asset_prefetch&) = delete;
+		asset_prefetch& operator=(const asset_prefetch&) = delete;
+
+		// waits for the asset if it is scheduled and not started yet parses it right away on this thread.
+		// empty if it isn't part of the graph, was already taken or needs the database, parse errors are rethrown here
+		std::shared_ptr<asset_interface> take(std::int32_t type, const std::string& name);
+
+		// drops whatever wasn't taken, the graph was from an older csv
+		void stop();
+
+	private:
+		enum class state : std::uint8_t
+		{
+			pending,
+			parsing,
+			done,
+			taken,
+		};
+
+		struct job
+		{
+			asset_key key;
+			state status = state::pending;
+			std::shared_ptr<asset_interface> asset;
+			std::exception_ptr error;
+		};
+
+		void run(std::size_t index);
+		void work();
+
+		std::vector<job> jobs_;
+		std::map<asset_key, std::size_t> indices_;
+		parse_callback parse_;
+
+		std::mutex mutex_;
+		std::condition_variable job_done_;
+		std::size_t next_job_ = 0;
+		std::size_t taken_count_ = 0;
+		bool stopping_ = false;
+
+		std::vector<std::thread> workers_;
+	};
+}
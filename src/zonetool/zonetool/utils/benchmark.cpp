@@ -0,0 +1,302 @@
+#include <std_include.hpp>
+#include "benchmark.hpp"
+#include "profiler.hpp"
+
+#include "utils.hpp"
+
+#include <zoneinspect/fastfile.hpp>
+#include <zoneinspect/zone.hpp>
+
+#include <utils/io.hpp>
+#include <utils/string.hpp>
+
+#include <random>
+
+#include <zlib.h>
+
+namespace zonetool::benchmark
+{
+	namespace
+	{
+		double to_mb(const std::size_t bytes)
+		{
+			return static_cast<double>(bytes) / 1024.0 / 1024.0;
+		}
+
+		// text with enough repetition to compress like real scripts and tables, but not trivially
+		std::string generate_text(std::mt19937& rng, const std::size_t size, const bool multiline = true)
+		{
+			static const char* words[] =
+			{
+				"level", "self", "thread", "wait", "notify", "endon", "waittill", "player", "origin", "angles",
+				"spawn", "model", "weapon", "array", "struct", "if", "else", "for", "return", "undefined",
+			};
+
+			std::string text;
+			text.reserve(size + 32);
+
+			while (text.size() < size)
+			{
+				text += words[rng() % std::size(words)];
+				text += (!multiline || rng() % 8) ? ' ' : '\n';
+
+				if (!(rng() % 16))
+				{
+					text += std::to_string(rng());
+					text += ';';
+				}
+			}
+
+			text.resize(size);
+			return text;
+		}
+
+		std::string compress(const std::string& data)
+		{
+			auto size = compressBound(static_cast<uLong>(data.size()));
+			std::string compressed(size, '\0');
+			compress2(reinterpret_cast<Bytef*>(compressed.data()), &size, reinterpret_cast<const Bytef*>(data.data()),
+				static_cast<uLong>(data.size()), Z_BEST_COMPRESSION);
+			compressed.resize(size);
+			return compressed;
+		}
+
+#pragma pack(push, 1)
+		struct dds_pixel_format
+		{
+			std::uint32_t size;
+			std::uint32_t flags;
+			std::uint32_t four_cc;
+			std::uint32_t rgb_bit_count;
+			std::uint32_t r_mask;
+			std::uint32_t g_mask;
+			std::uint32_t b_mask;
+			std::uint32_t a_mask;
+		};
+
+		struct dds_header
+		{
+			std::uint32_t magic;
+			std::uint32_t size;
+			std::uint32_t flags;
+			std::uint32_t height;
+			std::uint32_t width;
+			std::uint32_t pitch;
+			std::uint32_t depth;
+			std::uint32_t mip_count;
+			std::uint32_t reserved1[11];
+			dds_pixel_format format;
+			std::uint32_t caps[4];
+			std::uint32_t reserved2;
+		};
+#pragma pack(pop)
+
+		static_assert(sizeof(dds_header) == 128);
+
+		// uncompressed A8R8G8B8 dds, loaded through the custom image path
+		std::string generate_image(std::mt19937& rng, const std::size_t size)
+		{
+			dds_header header{};
+			header.magic = 0x20534444; // "DDS "
+			header.size = 124;
+			header.flags = 0x100F; // caps | height | width | pitch | pixelformat
+			header.height = static_cast<std::uint32_t>(size);
+			header.width = static_cast<std::uint32_t>(size);
+			header.pitch = static_cast<std::uint32_t>(size * 4);
+			header.format.size = sizeof(dds_pixel_format);
+			header.format.flags = 0x41; // rgb | alphapixels
+			header.format.rgb_bit_count = 32;
+			header.format.r_mask = 0x00FF0000;
+			header.format.g_mask = 0x0000FF00;
+			header.format.b_mask = 0x000000FF;
+			header.format.a_mask = 0xFF000000;
+			header.caps[0] = 0x1000; // texture
+
+			std::string data(reinterpret_cast<const char*>(&header), sizeof(header));
+			data.reserve(sizeof(header) + size * size * 4);
+
+			const auto seed = static_cast<std::uint8_t>(rng());
+			for (auto y = 0u; y < size; y++)
+			{
+				for (auto x = 0u; x < size; x++)
+				{
+					data += static_cast<char>(x + seed);
+					data += static_cast<char>(y);
+					data += static_cast<char>((x ^ y) + (rng() & 7));
+					data += static_cast<char>(0xFF);
+				}
+			}
+
+			return data;
+		}
+
+		std::string get_source_path(const std::string& fastfile, const std::string& name)
+		{
+			return "zonetool\\" + fastfile + "\\" + name;
+		}
+
+		bool check_count(const char* name, const std::size_t count, const std::size_t expected)
+		{
+			if (count == expected)
+			{
+				return true;
+			}
+
+			ZONETOOL_ERROR("Expected %zu %s assets, the fastfile has %zu", expected, name, count);
+			return false;
+		}
+
+		std::size_t get_peak_working_set()
+		{
+			PROCESS_MEMORY_COUNTERS counters{};
+			if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+			{
+				return 0;
+			}
+
+			return counters.PeakWorkingSetSize;
+		}
+	}
+
+	void write_sources(const std::string& fastfile, const settings& settings)
+	{
+		std::mt19937 rng(0x5A17);
+		std::string csv;
+
+		for (auto i = 0u; i < settings.rawfiles; i++)
+		{
+			const auto name = utils::string::va("benchmark/raw_%u.txt", i);
+			utils::io::write_file(get_source_path(fastfile, name), generate_text(rng, settings.rawfile_size));
+			csv += "rawfile,"s + name + "\n";
+		}
+
+		for (auto i = 0u; i < settings.stringtables; i++)
+		{
+			std::string table;
+			for (auto row = 0u; row < settings.stringtable_rows; row++)
+			{
+				table += utils::string::va("%u,ref_%u_%u,%s,%u\n", row, i, row, generate_text(rng, 16, false).data(), rng() % 1000);
+			}
+
+			const auto name = utils::string::va("benchmark/table_%u.csv", i);
+			utils::io::write_file(get_source_path(fastfile, name), table);
+			csv += "stringtable,"s + name + "\n";
+		}
+
+		if (settings.localize_entries)
+		{
+			std::string localize = "VERSION \"1\"\nFILENOTES \"\"\n\n";
+			for (auto i = 0u; i < settings.localize_entries; i++)
+			{
+				localize += utils::string::va("REFERENCE BENCHMARK_%u\nLANG_ENGLISH \"%s\"\n\n", i, generate_text(rng, 48, false).data());
+			}
+			localize += "ENDMARKER\n";
+
+			utils::io::write_file(get_source_path(fastfile, "localizedstrings\\benchmark.str"), localize);
+			csv += "localize,benchmark\n";
+		}
+
+		for (auto i = 0u; i < settings.scriptfiles; i++)
+		{
+			const std::string name = utils::string::va("benchmark_script_%u", i);
+			const auto source = generate_text(rng, 8 * 1024);
+			const auto compressed = compress(source);
+
+			std::string bytecode(2 * 1024, '\0');
+			for (auto& byte : bytecode)
+			{
+				byte = static_cast<char>(rng() % 96);
+			}
+
+			const std::int32_t lengths[] =
+			{
+				static_cast<std::int32_t>(compressed.size()),
+				static_cast<std::int32_t>(source.size()),
+				static_cast<std::int32_t>(bytecode.size()),
+			};
+
+			std::string scriptfile = name;
+			scriptfile.push_back('\0');
+			scriptfile.append(reinterpret_cast<const char*>(lengths), sizeof(lengths));
+			scriptfile += compressed;
+			scriptfile += bytecode;
+
+			utils::io::write_file(get_source_path(fastfile, name + ".gscbin"), scriptfile);
+			csv += "scriptfile," + name + "\n";
+		}
+
+		for (auto i = 0u; i < settings.images; i++)
+		{
+			const std::string name = utils::string::va("benchmark_image_%u", i);
+			utils::io::write_file(get_source_path(fastfile, "images\\" + name + ".dds"), generate_image(rng, settings.image_size));
+			csv += "image," + name + "\n";
+		}
+
+		utils::io::write_file("zone_source\\" + fastfile + ".csv", csv);
+	}
+
+	bool verify_and_report(const std::string& fastfile, const settings& settings, const asset_types& types, const double total_msec)
+	{
+		const auto path = filesystem::get_zone_path(fastfile + ".ff") + fastfile + ".ff";
+
+		std::string file;
+		if (!utils::io::read_file(path, &file))
+		{
+			ZONETOOL_ERROR("Could not read back \"%s\"", path.data());
+			return false;
+		}
+
+		auto valid = true;
+		std::size_t zone_size = 0;
+
+		try
+		{
+			const std::vector<std::uint8_t> data(file.begin(), file.end());
+			const auto ff = zoneinspect::read_fastfile(data, std::thread::hardware_concurrency());
+			const auto zone = zoneinspect::read_zone(ff);
+			zone_size = ff.zone.size();
+
+			for (const auto& error : zone.errors)
+			{
+				ZONETOOL_ERROR("%s", error.data());
+				valid = false;
+			}
+
+			std::unordered_map<std::uint64_t, std::size_t> counts;
+			for (const auto& asset : zone.assets)
+			{
+				counts[asset.type]++;
+			}
+
+			// the branding rawfile is added to every zone
+			valid &= check_count("rawfile", counts[static_cast<std::uint64_t>(types.rawfile)], settings.rawfiles + 1);
+			valid &= check_count("stringtable", counts[static_cast<std::uint64_t>(types.stringtable)], settings.stringtables);
+			valid &= check_count("localize", counts[static_cast<std::uint64_t>(types.localize)], settings.localize_entries);
+			valid &= check_count("scriptfile", counts[static_cast<std::uint64_t>(types.scriptfile)], settings.scriptfiles);
+			valid &= check_count("image", counts[static_cast<std::uint64_t>(types.image)], settings.images);
+			valid &= check_count("total", zone.assets.size(), settings.rawfiles + 1 + settings.stringtables +
+				settings.localize_entries + settings.scriptfiles + settings.images);
+		}
+		catch (const std::exception& e)
+		{
+			ZONETOOL_ERROR("Could not decode \"%s\": %s", path.data(), e.what());
+			return false;
+		}
+
+		ZONETOOL_INFO("Benchmark \"%s\": zone %.2fmb, fastfile %.2fmb, round trip %s", fastfile.data(),
+			to_mb(zone_size), to_mb(file.size()), valid ? "ok" : "FAILED");
+		log::flush();
+
+		printf("  %-10s %10s %10s\n", "phase", "msec", "mb/s");
+		for (const auto& phase : profiler::get_phases())
+		{
+			printf("  %-10s %10.2f %10.2f\n", phase.name.data(), phase.msec,
+				phase.msec > 0.0 ? to_mb(zone_size) / (phase.msec / 1000.0) : 0.0);
+		}
+
+		printf("  %-10s %10.2f %10.2f\n", "total", total_msec, total_msec > 0.0 ? to_mb(zone_size) / (total_msec / 1000.0) : 0.0);
+		printf("  peak working set %.2fmb\n", to_mb(get_peak_working_set()));
+
+		return valid;
+	}
+}
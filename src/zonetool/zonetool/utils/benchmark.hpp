@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace zonetool::benchmark
+{
+	// how many synthetic assets of each kind a benchmark zone gets
+	struct settings
+	{
+		std::size_t rawfiles = 256;
+		std::size_t rawfile_size = 64 * 1024;
+		std::size_t stringtables = 32;
+		std::size_t stringtable_rows = 512;
+		std::size_t localize_entries = 4096;
+		std::size_t scriptfiles = 64;
+		std::size_t images = 16;
+		std::size_t image_size = 512;
+	};
+
+	// asset types are game specific, the game passes in its own ids
+	struct asset_types
+	{
+		std::int32_t rawfile;
+		std::int32_t stringtable;
+		std::int32_t localize;
+		std::int32_t scriptfile;
+		std::int32_t image;
+	};
+
+	// writes the synthetic asset sources and zone_source csv for fastfile
+	void write_sources(const std::string& fastfile, const settings& settings);
+
+	// reads the built fastfile back with the offline reader, checks the asset list and prints the phase timings of the last profiler recording
+	bool verify_and_report(const std::string& fastfile, const settings& settings, const asset_types& types, double total_msec);
+}
@@ -10,40 +10,178 @@ namespace csv_generator
 {
 	namespace
 	{
-		std::unordered_set<std::string> parse_create_fx_gsc(const std::string& data)
+		enum class token_type
 		{
-			std::unordered_set<std::string> sounds;
-			std::regex pattern("\\w+\\.v\\[\\s*\"soundalias\"\\s*\\]\\s*=\\s*\"([\\w\\s]+?)\"", std::regex_constants::icase);
-			std::smatch matches;
+			identifier,
+			string,
+			symbol,
+		};
+
+		struct token
+		{
+			token_type type;
+			std::string_view value;
+		};
+
+		bool is_identifier_char(const char c)
+		{
+			return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+		}
 
-			auto search_start = data.cbegin();
-			while (std::regex_search(search_start, data.cend(), matches, pattern))
+		// one pass over the script, comments are skipped and strings keep their contents without the quotes
+		std::vector<token> tokenize_gsc(const std::string_view& data)
+		{
+			std::vector<token> tokens;
+
+			std::size_t pos = 0;
+			while (pos < data.size())
 			{
-				sounds.insert(matches[1].str());
-				search_start = matches.suffix().first;
+				const auto c = data[pos];
+
+				if (std::isspace(static_cast<unsigned char>(c)))
+				{
+					pos++;
+				}
+				else if (data.substr(pos, 2) == "//")
+				{
+					const auto end = data.find('\n', pos);
+					pos = end == std::string_view::npos ? data.size() : end;
+				}
+				else if (data.substr(pos, 2) == "/*")
+				{
+					const auto end = data.find("*/", pos + 2);
+					pos = end == std::string_view::npos ? data.size() : end + 2;
+				}
+				else if (c == '"')
+				{
+					auto end = pos + 1;
+					while (end < data.size() && data[end] != '"')
+					{
+						end += data[end] == '\\' ? 2 : 1;
+					}
+
+					end = std::min(end, data.size());
+					tokens.emplace_back(token{token_type::string, data.substr(pos + 1, end - pos - 1)});
+					pos = end + 1;
+				}
+				else if (is_identifier_char(c))
+				{
+					auto end = pos + 1;
+					while (end < data.size() && is_identifier_char(data[end]))
+					{
+						end++;
+					}
+
+					tokens.emplace_back(token{token_type::identifier, data.substr(pos, end - pos)});
+					pos = end;
+				}
+				else
+				{
+					tokens.emplace_back(token{token_type::symbol, data.substr(pos, 1)});
+					pos++;
+				}
 			}
 
-			return sounds;
+			return tokens;
 		}
 
-		std::unordered_set<std::string> parse_fx_gsc(const std::string& data)
+		bool equals_ignore_case(const std::string_view& a, const std::string_view& b)
 		{
-			std::unordered_set<std::string> effects;
-			std::regex pattern("loadfx\\s*\\(\\s*\"([^\"]+)\"\\s*\\);", std::regex_constants::icase);
-			std::smatch matches;
+			return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(), [](const char x, const char y)
+			{
+				return std::tolower(static_cast<unsigned char>(x)) == std::tolower(static_cast<unsigned char>(y));
+			});
+		}
 
-			auto search_start = data.cbegin();
-			while (std::regex_search(search_start, data.cend(), matches, pattern))
+		// pattern entries match a token of their type by text ignoring case, "*" matches any text and "$" also captures it
+		std::vector<std::string> match_tokens(const std::vector<token>& tokens, const std::vector<std::pair<token_type, std::string_view>>& pattern)
+		{
+			std::vector<std::string> values;
+			std::unordered_set<std::string> found;
+
+			for (auto i = 0u; i + pattern.size() <= tokens.size(); i++)
 			{
-				effects.insert(matches[1].str());
-				search_start = matches.suffix().first;
+				std::string_view capture;
+				auto matched = true;
+
+				for (auto o = 0u; o < pattern.size() && matched; o++)
+				{
+					const auto& [type, text] = pattern[o];
+					const auto& current = tokens[i + o];
+
+					if (current.type != type)
+					{
+						matched = false;
+					}
+					else if (text == "$")
+					{
+						capture = current.value;
+					}
+					else if (text != "*")
+					{
+						matched = equals_ignore_case(current.value, text);
+					}
+				}
+
+				if (matched && !capture.empty() && found.emplace(capture).second)
+				{
+					values.emplace_back(capture);
+				}
 			}
 
-			return effects;
+			return values;
+		}
+
+		// aliases are only word characters and spaces, like the createfx regex used to accept
+		bool is_sound_alias(const std::string& alias)
+		{
+			return std::all_of(alias.begin(), alias.end(), [](const char c)
+			{
+				return is_identifier_char(c) || std::isspace(static_cast<unsigned char>(c));
+			});
+		}
+
+		// <ent>.v["soundalias"] = "<alias>"
+		std::vector<std::string> parse_create_fx_gsc(const std::string& data)
+		{
+			const auto tokens = tokenize_gsc(data);
+			auto sounds = match_tokens(tokens,
+			{
+				{token_type::identifier, "*"},
+				{token_type::symbol, "."},
+				{token_type::identifier, "v"},
+				{token_type::symbol, "["},
+				{token_type::string, "soundalias"},
+				{token_type::symbol, "]"},
+				{token_type::symbol, "="},
+				{token_type::string, "$"},
+			});
+
+			std::erase_if(sounds, [](const std::string& sound)
+			{
+				return !is_sound_alias(sound);
+			});
+
+			return sounds;
+		}
+
+		// loadfx("<effect>");
+		std::vector<std::string> parse_fx_gsc(const std::string& data)
+		{
+			const auto tokens = tokenize_gsc(data);
+			return match_tokens(tokens,
+			{
+				{token_type::identifier, "loadfx"},
+				{token_type::symbol, "("},
+				{token_type::string, "$"},
+				{token_type::symbol, ")"},
+				{token_type::symbol, ";"},
+			});
 		}
 	}
 
-	void generate_map_csv(const std::string& map, const mapents::token_name_callback& get_token_name, bool is_sp)
+	void generate_map_csv(const std::string& map, const mapents::token_name_callback& get_token_name, bool is_sp,
+		const dependency_callback& get_dependencies)
 	{
 		const auto root_dir = "zonetool/" + map;
 		if (!utils::io::directory_exists(root_dir))
@@ -80,13 +218,32 @@ namespace csv_generator
 			add_str("\n");
 		};
 
-		const auto add_asset = [&](const std::string& type, const std::string& name)
+		std::vector<asset_entry> roots;
+		std::vector<asset_entry> missing;
+
+		// missing files are written commented out and are not scanned
+		const auto add_asset = [&](const std::string& type, const std::string& name, const bool commented = false)
 		{
+			if (commented)
+			{
+				add_str("#");
+				missing.emplace_back(type, name);
+			}
+			else
+			{
+				roots.emplace_back(type, name);
+			}
+
 			ZONETOOL_INFO("Adding %s \"%s\"", type.data(), name.data());
 			add_line(utils::string::va("%s,%s", type.data(), name.data()));
 		};
 
-		add_line("// Generated by x64-ZoneTool\n");
+		const auto add_header = [&]
+		{
+			add_line("// Generated by x64-ZoneTool\n");
+		};
+
+		add_header();
 
 		if (!is_sp)
 		{
@@ -214,11 +371,7 @@ namespace csv_generator
 
 			const std::string path = root_dir + "/" + name + ext;
 			const std::string path_json = path + ".json";
-			if (!utils::io::file_exists(path) && !utils::io::file_exists(path_json))
-			{
-				add_str("#");
-			}
-			add_asset(type, name);
+			add_asset(type, name, !utils::io::file_exists(path) && !utils::io::file_exists(path_json));
 		};
 
 		const auto add_iterator = [&](const std::string& type, const std::string& folder,
@@ -263,21 +416,15 @@ namespace csv_generator
 			}
 		};
 
-		const auto add_if_exists = [&](const std::string& text, const std::string& path)
 		{
-			if (!utils::io::file_exists(root_dir + "/" + path))
+			const std::string compass_name = utils::string::va("compass_map_%s", map.data());
+			const std::string compass_path = utils::string::va("%s/materials/%s.json", root_dir.data(), compass_name.data());
+			if (utils::io::file_exists(compass_path))
 			{
-				return false;
+				add_line("// compass");
+				add_asset("material", compass_name);
+				add_line("");
 			}
-
-			add_line(text);
-			return true;
-		};
-
-		{
-			const std::string compass_name = utils::string::va("compass_map_%s", map.data());
-			const std::string compass_path = utils::string::va("materials/%s.json", compass_name.data());
-			add_if_exists(utils::string::va("// compass\nmaterial,compass_map_%s\n", map.data()), compass_path);
 		}
 
 		add_iterator("stringtable", "maps/createart/", ".csv", "// lightsets");
@@ -288,12 +435,7 @@ namespace csv_generator
 		const auto add_gsc = [&](const std::string& path)
 		{
 			const std::string gsc_path = root_dir + "/" + path;
-			if (!utils::io::file_exists(gsc_path))
-			{
-				add_str("#");
-			}
-			
-			add_asset("rawfile", path);
+			add_asset("rawfile", path, !utils::io::file_exists(gsc_path));
 		};
 
 		const auto add_gsc_if_exists = [&](const std::string& path)
@@ -334,6 +476,55 @@ namespace csv_generator
 		add_map_asset(is_sp ? "col_map_sp" : "col_map_mp", ".colmap");
 		add_line("");
 
+		// the scan returns the roots and everything they pull in, dependencies before the assets using them.
+		// that order replaces the sections above, only the missing files are kept from them
+		if (get_dependencies)
+		{
+			ZONETOOL_INFO("Scanning dependencies...");
+			const auto assets = get_dependencies(map, roots);
+
+			csv.clear();
+			add_header();
+
+			if (!missing.empty())
+			{
+				add_line("// missing");
+				for (const auto& [type, name] : missing)
+				{
+					add_line(utils::string::va("#%s,%s", type.data(), name.data()));
+				}
+
+				add_line("");
+			}
+
+			std::set<asset_entry> added_assets;
+			const auto add_scanned = [&](const std::string& type, const std::string& name)
+			{
+				if (added_assets.emplace(type, name).second)
+				{
+					add_line(utils::string::va("%s,%s", type.data(), name.data()));
+				}
+			};
+
+			add_line("// assets in load order");
+			for (const auto& [type, name] : assets)
+			{
+				add_scanned(type, name);
+			}
+
+			// roots that failed to load are kept so the build reports them
+			for (const auto& [type, name] : roots)
+			{
+				if (!added_assets.contains({type, name}))
+				{
+					ZONETOOL_WARNING("%s \"%s\" was not loaded by the dependency scan", type.data(), name.data());
+					add_scanned(type, name);
+				}
+			}
+
+			add_line("");
+		}
+
 		const auto csv_path = "zone_source/" + map + ".csv";
 
 		ZONETOOL_INFO("CSV saved to %s", csv_path.data());
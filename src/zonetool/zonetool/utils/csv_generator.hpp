@@ -5,16 +5,33 @@
 
 namespace csv_generator
 {
-	void generate_map_csv(const std::string& map, const mapents::token_name_callback& get_token_name, bool is_sp = false);
+	// type and name as written to the csv
+	using asset_entry = std::pair<std::string, std::string>;
+
+	// loads the given assets the way a build would and returns them with everything they pull in,
+	// dependencies before the assets using them
+	using dependency_callback = std::function<std::vector<asset_entry>(const std::string& map, const std::vector<asset_entry>& roots)>;
+
+	void generate_map_csv(const std::string& map, const mapents::token_name_callback& get_token_name, bool is_sp = false,
+		const dependency_callback& get_dependencies = {});
 
 	template <typename T>
-	std::function<void(const T& params)> create_command(const mapents::token_name_callback& get_token_name)
+	std::function<void(const T& params)> create_command(const mapents::token_name_callback& get_token_name,
+		const dependency_callback& get_dependencies = {})
 	{
 		return [=](const T& params)
 		{
 			if (params.size() < 2)
 			{
-				ZONETOOL_INFO("Usage: generatecsv <map> [mode]");
+				if (get_dependencies)
+				{
+					ZONETOOL_INFO("Usage: generatecsv <map> [mode] [deps]");
+				}
+				else
+				{
+					ZONETOOL_INFO("Usage: generatecsv <map> [mode]");
+				}
+
 				return;
 			}
 
@@ -24,7 +41,13 @@ namespace csv_generator
 				is_sp = params.get(2) == "sp"s;
 			}
 
-			generate_map_csv(params.get(1), get_token_name, is_sp);
+			auto scan_dependencies = false;
+			if (params.size() >= 4)
+			{
+				scan_dependencies = params.get(3) == "deps"s;
+			}
+
+			generate_map_csv(params.get(1), get_token_name, is_sp, scan_dependencies ? get_dependencies : dependency_callback{});
 		};
 	}
 }
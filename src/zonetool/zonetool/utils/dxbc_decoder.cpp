@@ -0,0 +1,340 @@
+#include <std_include.hpp>
+#include "dxbc_decoder.hpp"
+
+namespace shader::decoder
+{
+	namespace
+	{
+		// values from d3d11TokenizedProgramFormat.hpp
+		constexpr std::uint32_t opcode_customdata = 53;
+		constexpr std::uint32_t opcode_count = 235;
+
+		constexpr std::uint32_t operand_immediate32 = 4;
+		constexpr std::uint32_t operand_immediate64 = 5;
+		constexpr std::uint32_t operand_constant_buffer = 8;
+
+		enum index_representation : std::uint32_t
+		{
+			index_immediate32 = 0,
+			index_immediate64 = 1,
+			index_relative = 2,
+			index_immediate32_plus_relative = 3,
+			index_immediate64_plus_relative = 4,
+		};
+
+		// relative indices are operands themselves, fxc never nests them deeper than one level
+		constexpr auto max_relative_depth = 4;
+
+		struct opcode_layout
+		{
+			bool valid;
+			// false for declarations that only carry raw dwords
+			bool operands;
+			// dwords between the opcode tokens and the first operand
+			std::uint8_t leading_dwords;
+			// dwords after the last operand, return types, system value names, strides and counts
+			std::uint8_t trailing_dwords;
+		};
+
+		// the instruction length comes from the opcode token, the table says which of those dwords are operands
+		constexpr auto opcode_table = []
+		{
+			std::array<opcode_layout, opcode_count> table{};
+			for (auto& layout : table)
+			{
+				layout = {true, true, 0, 0};
+			}
+
+			// reserved
+			table[107].valid = false;
+			table[112].valid = false;
+			table[209].valid = false;
+			table[218].valid = false;
+
+			table[88].trailing_dwords = 1; // dcl_resource, return type
+			table[91].trailing_dwords = 1; // dcl_indexRange, count
+			table[92].operands = false; // dcl_outputtopology
+			table[93].operands = false; // dcl_inputprimitive
+			table[94].operands = false; // dcl_maxout
+			table[96].trailing_dwords = 1; // dcl_input_sgv, name
+			table[97].trailing_dwords = 1; // dcl_input_siv, name
+			table[99].trailing_dwords = 1; // dcl_input_ps_sgv, name
+			table[100].trailing_dwords = 1; // dcl_input_ps_siv, name
+			table[102].trailing_dwords = 1; // dcl_output_sgv, name
+			table[103].trailing_dwords = 1; // dcl_output_siv, name
+			table[104].operands = false; // dcl_temps
+			table[105].operands = false; // dcl_indexableTemp
+			table[106].operands = false; // dcl_globalFlags
+			table[120].leading_dwords = 1; // fcall, function index
+			table[144].operands = false; // dcl_function_body
+			table[145].operands = false; // dcl_function_table
+			table[146].operands = false; // dcl_interface
+			table[147].operands = false; // dcl_input_control_point_count
+			table[148].operands = false; // dcl_output_control_point_count
+			table[149].operands = false; // dcl_tessellator_domain
+			table[150].operands = false; // dcl_tessellator_partitioning
+			table[151].operands = false; // dcl_tessellator_output_primitive
+			table[152].operands = false; // dcl_hs_max_tessfactor
+			table[153].operands = false; // dcl_hs_fork_phase_instance_count
+			table[154].operands = false; // dcl_hs_join_phase_instance_count
+			table[155].operands = false; // dcl_thread_group
+			table[156].trailing_dwords = 1; // dcl_uav_typed, return type
+			table[158].trailing_dwords = 1; // dcl_uav_structured, stride
+			table[159].trailing_dwords = 1; // dcl_tgsm_raw, byte count
+			table[160].trailing_dwords = 2; // dcl_tgsm_structured, stride and count
+			table[162].trailing_dwords = 1; // dcl_resource_structured, stride
+			table[206].operands = false; // dcl_gs_instance_count
+			return table;
+		}();
+
+		class program_reader
+		{
+		public:
+			program_reader(const unsigned char* tokens, const std::size_t count, const std::size_t base_offset)
+				: tokens_(tokens)
+				, count_(count)
+				, base_offset_(base_offset)
+			{
+			}
+
+			bool decode(std::vector<constant_buffer_reference>& references) const
+			{
+				// version and length tokens, the length counts every dword of the program including those two
+				const auto end = std::min(static_cast<std::size_t>(this->at(1)), this->count_);
+				std::size_t pos = 2;
+
+				while (pos < end)
+				{
+					const auto token = this->at(pos);
+					const auto opcode = token & 0x7FF;
+
+					// immediate constant buffers and comments, the dword after the opcode token is the full length
+					if (opcode == opcode_customdata)
+					{
+						const auto length = pos + 1 < end ? this->at(pos + 1) : 0;
+						if (length < 2 || pos + length > end)
+						{
+							return false;
+						}
+
+						pos += length;
+						continue;
+					}
+
+					const auto length = (token >> 24) & 0x7F;
+					if (!length || pos + length > end)
+					{
+						return false;
+					}
+
+					const auto instruction_end = pos + length;
+					pos++;
+
+					for (auto extended = token >> 31; extended; extended = this->at(pos++) >> 31)
+					{
+						if (pos >= instruction_end)
+						{
+							return false;
+						}
+					}
+
+					const auto& layout = opcode < opcode_count ? opcode_table[opcode] : opcode_layout{};
+					if (layout.valid && layout.operands)
+					{
+						pos += layout.leading_dwords;
+
+						const auto operands_end = instruction_end - layout.trailing_dwords;
+						if (pos > operands_end)
+						{
+							return false;
+						}
+
+						while (pos < operands_end)
+						{
+							if (!this->decode_operand(pos, operands_end, 0, references))
+							{
+								return false;
+							}
+						}
+					}
+
+					pos = instruction_end;
+				}
+
+				return true;
+			}
+
+		private:
+			std::uint32_t at(const std::size_t index) const
+			{
+				if (index >= this->count_)
+				{
+					return 0;
+				}
+
+				std::uint32_t token{};
+				std::memcpy(&token, this->tokens_ + index * 4, sizeof(token));
+				return token;
+			}
+
+			bool decode_operand(std::size_t& pos, const std::size_t end, const int depth,
+				std::vector<constant_buffer_reference>& references) const
+			{
+				if (pos >= end || depth > max_relative_depth)
+				{
+					return false;
+				}
+
+				const auto token = this->at(pos++);
+
+				// modifier and min precision tokens
+				for (auto extended = token >> 31; extended; extended = this->at(pos++) >> 31)
+				{
+					if (pos >= end)
+					{
+						return false;
+					}
+				}
+
+				const auto type = (token >> 12) & 0xFF;
+
+				std::size_t components{};
+				switch (token & 3)
+				{
+				case 0:
+					components = 0;
+					break;
+				case 1:
+					components = 1;
+					break;
+				case 2:
+					components = 4;
+					break;
+				default:
+					// n component operands are reserved
+					return false;
+				}
+
+				// immediate values come before the indices
+				if (type == operand_immediate32)
+				{
+					pos += components;
+				}
+				else if (type == operand_immediate64)
+				{
+					pos += components * 2;
+				}
+
+				const auto dimension = (token >> 20) & 3;
+				std::uint32_t representations[3]{};
+				std::uint32_t indices[3]{};
+				std::size_t index_positions[3]{};
+
+				for (auto i = 0u; i < dimension; i++)
+				{
+					representations[i] = (token >> (22 + i * 3)) & 7;
+					index_positions[i] = pos;
+
+					switch (representations[i])
+					{
+					case index_immediate32:
+					case index_immediate32_plus_relative:
+						indices[i] = this->at(pos);
+						pos += 1;
+						break;
+					case index_immediate64:
+					case index_immediate64_plus_relative:
+						pos += 2;
+						break;
+					case index_relative:
+						break;
+					default:
+						return false;
+					}
+
+					if (pos > end)
+					{
+						return false;
+					}
+
+					if (representations[i] >= index_relative && !this->decode_operand(pos, end, depth + 1, references))
+					{
+						return false;
+					}
+				}
+
+				if (pos > end)
+				{
+					return false;
+				}
+
+				if (type == operand_constant_buffer && dimension == 2 && representations[0] == index_immediate32 &&
+					(representations[1] == index_immediate32 || representations[1] == index_immediate32_plus_relative))
+				{
+					references.push_back({indices[0], indices[1], this->base_offset_ + index_positions[1] * 4,
+						representations[1] == index_immediate32_plus_relative});
+				}
+
+				return true;
+			}
+
+			const unsigned char* tokens_;
+			std::size_t count_;
+			std::size_t base_offset_;
+		};
+
+		struct container_header
+		{
+			char magic[4];
+			std::uint32_t checksum[4];
+			std::uint32_t version;
+			std::uint32_t size;
+			std::uint32_t chunk_count;
+		};
+
+		std::uint32_t read_dword(const unsigned char* data, const std::size_t offset)
+		{
+			std::uint32_t value{};
+			std::memcpy(&value, data + offset, sizeof(value));
+			return value;
+		}
+	}
+
+	bool get_constant_buffer_references(const unsigned char* program, const std::size_t program_size,
+		std::vector<constant_buffer_reference>& references)
+	{
+		if (program_size < sizeof(container_header))
+		{
+			return false;
+		}
+
+		container_header header{};
+		std::memcpy(&header, program, sizeof(header));
+
+		const auto size = std::min(static_cast<std::size_t>(header.size), program_size);
+		if (header.chunk_count > (size - sizeof(header)) / 4)
+		{
+			return false;
+		}
+
+		for (auto i = 0u; i < header.chunk_count; i++)
+		{
+			const std::size_t chunk = read_dword(program, sizeof(header) + i * 4);
+			if (chunk + 8 > size)
+			{
+				return false;
+			}
+
+			if (std::memcmp(program + chunk, "SHDR", 4) && std::memcmp(program + chunk, "SHEX", 4))
+			{
+				continue;
+			}
+
+			const auto chunk_size = std::min(static_cast<std::size_t>(read_dword(program, chunk + 4)), size - chunk - 8);
+			const program_reader reader(program + chunk + 8, chunk_size / 4, chunk + 8);
+			return reader.decode(references);
+		}
+
+		return false;
+	}
+}
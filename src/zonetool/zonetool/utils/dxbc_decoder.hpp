@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace shader::decoder
+{
+	// a cb#[reg] operand, offset is the byte offset of the register index dword from the start of the dxbc container
+	struct constant_buffer_reference
+	{
+		std::uint32_t slot;
+		std::uint32_t reg;
+		std::size_t offset;
+		// cb#[r#.x + reg], reg is only the base
+		bool relative;
+	};
+
+	// decodes the SHDR/SHEX chunk token by token as laid out in d3d11TokenizedProgramFormat.hpp and collects every
+	// 2d constant buffer operand with an immediate slot, including the ones of dcl_constantbuffer (reg is the size there).
+	// false if there is no shader chunk or an instruction doesn't fit its length, the references found so far are kept
+	bool get_constant_buffer_references(const unsigned char* program, std::size_t program_size,
+		std::vector<constant_buffer_reference>& references);
+}
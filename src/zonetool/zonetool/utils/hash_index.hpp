@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <vector>
+
+namespace zonetool::hash_index
+{
+	// chained index over a list of hashed entries (iw7 SndBank::aliasIndex): slot id % count holds the first entry
+	// of that bucket, collisions are linked through next into free slots. Entry needs value and next members
+	constexpr std::uint16_t invalid = std::numeric_limits<std::uint16_t>::max();
+
+	// index holds count entries, false if count doesn't fit the 16 bit links
+	template <typename Entry, typename GetId>
+	bool build(Entry* index, const std::size_t count, GetId&& get_id)
+	{
+		if (count >= invalid)
+		{
+			return false;
+		}
+
+		std::memset(index, 0xFF, sizeof(Entry) * count);
+		if (!count)
+		{
+			return true;
+		}
+
+		// counting sort by home bucket, stable so the lowest entry owns the bucket
+		std::vector<std::uint32_t> bucket_start(count + 1);
+		std::vector<std::uint16_t> sorted(count);
+
+		for (auto i = 0u; i < count; i++)
+		{
+			bucket_start[get_id(i) % count + 1]++;
+		}
+
+		for (auto i = 0u; i < count; i++)
+		{
+			bucket_start[i + 1] += bucket_start[i];
+		}
+
+		{
+			auto fill = bucket_start;
+			for (auto i = 0u; i < count; i++)
+			{
+				sorted[fill[get_id(i) % count]++] = static_cast<std::uint16_t>(i);
+			}
+		}
+
+		// every used bucket gets its first entry in place, so chains never pass through foreign buckets
+		for (auto bucket = 0u; bucket < count; bucket++)
+		{
+			if (bucket_start[bucket] != bucket_start[bucket + 1])
+			{
+				index[bucket].value = sorted[bucket_start[bucket]];
+			}
+		}
+
+		// collisions go to the next free slot, the cursor only ever moves forward
+		auto free_slot = 0u;
+		for (auto bucket = 0u; bucket < count; bucket++)
+		{
+			auto tail = bucket;
+			for (auto i = bucket_start[bucket] + 1; i < bucket_start[bucket + 1]; i++)
+			{
+				while (free_slot < count && index[free_slot].value != invalid)
+				{
+					free_slot++;
+				}
+
+				// can't happen, there are as many slots as entries
+				if (free_slot >= count)
+				{
+					return false;
+				}
+
+				index[tail].next = static_cast<std::uint16_t>(free_slot);
+				index[free_slot].value = sorted[i];
+				tail = free_slot;
+			}
+		}
+
+		return true;
+	}
+
+	// same walk the game does in SND_FindAlias
+	template <typename Entry, typename GetId>
+	std::optional<std::uint16_t> find(const Entry* index, const std::size_t count, const std::uint32_t id, GetId&& get_id)
+	{
+		if (!count)
+		{
+			return {};
+		}
+
+		auto slot = static_cast<std::uint16_t>(id % count);
+		while (index[slot].value != invalid)
+		{
+			if (get_id(index[slot].value) == id)
+			{
+				return index[slot].value;
+			}
+
+			slot = index[slot].next;
+			if (slot == invalid)
+			{
+				break;
+			}
+		}
+
+		return {};
+	}
+}
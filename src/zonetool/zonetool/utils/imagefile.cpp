@@ -2,7 +2,314 @@
 
 #include "imagefile.hpp"
 
+#include <condition_variable>
+#include <deque>
+
+#include <utils/flags.hpp>
+
 namespace zonetool::imagefile
 {
+	namespace
+	{
+		constexpr std::size_t default_memory_budget_mb = 1024;
+
+		std::size_t get_memory_budget()
+		{
+			if (const auto value = utils::flags::get_flag("imagememory"); value.has_value())
+			{
+				const auto budget = std::strtoull(value.value().data(), nullptr, 10);
+				if (budget > 0)
+				{
+					return static_cast<std::size_t>(budget) * 1024 * 1024;
+				}
+			}
+
+			return default_memory_budget_mb * 1024 * 1024;
+		}
+
+		// every worker owns a queue sorted largest first and takes from its front, idle workers steal the smallest
+		// job from the back of another queue. a job only starts once its input fits in the memory budget next to
+		// everything read or compressed but not written yet, a job larger than the budget runs once nothing else is held.
+		// blocks are written in index order, finished ones wait for the blocks before them and keep their budget
+		class job_scheduler
+		{
+		public:
+			job_scheduler(const std::vector<std::size_t>& sizes, const std::size_t worker_count, const std::size_t limit)
+				: sizes_(sizes)
+				, queues_(worker_count)
+				, limit_(limit)
+				, remaining_(sizes.size())
+			{
+				std::vector<std::size_t> order(sizes.size());
+				for (auto i = 0u; i < order.size(); i++)
+				{
+					order[i] = i;
+				}
+
+				std::stable_sort(order.begin(), order.end(), [&](const std::size_t a, const std::size_t b)
+				{
+					return sizes[a] > sizes[b];
+				});
+
+				for (auto i = 0u; i < order.size(); i++)
+				{
+					this->queues_[i % worker_count].emplace_back(order[i]);
+				}
+			}
+
+			std::optional<std::size_t> take(const std::size_t worker)
+			{
+				std::unique_lock lock(this->mutex_);
+
+				while (this->remaining_ > 0)
+				{
+					if (const auto job = this->take_fitting(worker); job.has_value())
+					{
+						return this->start(job.value());
+					}
+
+					// the held blocks can only be written once the next one is done, it runs past the budget
+					if (const auto job = this->take_index(this->next_write_); job.has_value())
+					{
+						return this->start(job.value());
+					}
+
+					this->changed_.wait(lock);
+				}
+
+				return {};
+			}
+
+			// called for every index in order once its block is written
+			void written(const std::size_t index)
+			{
+				{
+					std::lock_guard _(this->mutex_);
+					this->used_ -= this->sizes_[index];
+					this->next_write_ = index + 1;
+				}
+
+				this->changed_.notify_all();
+			}
+
+			std::size_t get_peak()
+			{
+				std::lock_guard _(this->mutex_);
+				return this->peak_;
+			}
+
+		private:
+			bool fits(const std::size_t index) const
+			{
+				return this->used_ == 0 || this->used_ + this->sizes_[index] <= this->limit_;
+			}
+
+			std::optional<std::size_t> take_fitting(const std::size_t worker)
+			{
+				auto& own = this->queues_[worker];
+				if (!own.empty() && this->fits(own.front()))
+				{
+					const auto job = own.front();
+					own.pop_front();
+					return job;
+				}
+
+				for (auto i = 0u; i < this->queues_.size(); i++)
+				{
+					auto& victim = this->queues_[(worker + i) % this->queues_.size()];
+					if (!victim.empty() && this->fits(victim.back()))
+					{
+						const auto job = victim.back();
+						victim.pop_back();
+						return job;
+					}
+				}
+
+				return {};
+			}
+
+			std::optional<std::size_t> take_index(const std::size_t index)
+			{
+				for (auto& queue : this->queues_)
+				{
+					if (const auto itr = std::find(queue.begin(), queue.end(), index); itr != queue.end())
+					{
+						queue.erase(itr);
+						return index;
+					}
+				}
+
+				return {};
+			}
+
+			std::size_t start(const std::size_t index)
+			{
+				this->remaining_--;
+				this->used_ += this->sizes_[index];
+				this->peak_ = std::max(this->peak_, this->used_);
+
+				// other workers may be waiting on a job that was queued behind this one
+				this->changed_.notify_all();
+				return index;
+			}
+
+			const std::vector<std::size_t>& sizes_;
+			std::vector<std::deque<std::size_t>> queues_;
+
+			std::mutex mutex_;
+			std::condition_variable changed_;
+			std::size_t limit_;
+			std::size_t remaining_;
+			std::size_t next_write_ = 0;
+			std::size_t used_ = 0;
+			std::size_t peak_ = 0;
+		};
+	}
+
+	pak_writer::pak_writer(const std::string& path, const void* header, const std::size_t header_size, const std::size_t hash_offset)
+		: hash_offset_(hash_offset)
+		, size_(header_size)
+	{
+		this->stream_.open(path, std::ios::binary | std::ios::trunc);
+		this->stream_.write(reinterpret_cast<const char*>(header), header_size);
+
+		sha256_init(&this->hash_state_);
+	}
+
+	bool pak_writer::is_open() const
+	{
+		return this->stream_.is_open() && this->stream_.good();
+	}
+
+	std::uint64_t pak_writer::write(const std::string& data)
+	{
+		const auto offset = this->size_;
+
+		this->stream_.write(data.data(), data.size());
+
+		// sha256_process takes a 32 bit length
+		constexpr std::size_t chunk_size = 0x10000000;
+		for (std::size_t pos = 0; pos < data.size(); pos += chunk_size)
+		{
+			const auto len = std::min(chunk_size, data.size() - pos);
+			sha256_process(&this->hash_state_, reinterpret_cast<const unsigned char*>(data.data() + pos), static_cast<unsigned long>(len));
+		}
+
+		this->size_ += data.size();
+		return offset;
+	}
+
+	std::uint64_t pak_writer::size() const
+	{
+		return this->size_;
+	}
+
+	pak_writer::block_range pak_writer::write_block(const std::string& data, const std::string& content_hash)
+	{
+		if (const auto itr = this->blocks_.find(content_hash); itr != this->blocks_.end())
+		{
+			this->duplicate_count_++;
+			this->duplicate_size_ += data.size();
+			return itr->second;
+		}
+
+		const auto offset = this->write(data);
+		const block_range range{offset, this->size_};
+		this->blocks_.emplace(content_hash, range);
+		return range;
+	}
+
+	std::size_t pak_writer::get_duplicate_count() const
+	{
+		return this->duplicate_count_;
+	}
+
+	std::uint64_t pak_writer::get_duplicate_size() const
+	{
+		return this->duplicate_size_;
+	}
+
+	bool pak_writer::finish()
+	{
+		DB_AuthHash hash{};
+		sha256_done(&this->hash_state_, hash.bytes);
+
+		this->stream_.seekp(this->hash_offset_);
+		this->stream_.write(reinterpret_cast<const char*>(hash.bytes), sizeof(hash.bytes));
+		this->stream_.close();
+
+		return !this->stream_.fail();
+	}
+
+	void compress_blocks(const std::vector<std::size_t>& sizes, const compress_callback& compress, const write_callback& write)
+	{
+		const auto count = sizes.size();
+		if (count == 0)
+		{
+			return;
+		}
+
+		const auto worker_count = std::min(static_cast<std::size_t>(std::max(1u, std::thread::hardware_concurrency())), count);
+
+		job_scheduler scheduler(sizes, worker_count, get_memory_budget());
+
+		std::mutex results_mutex;
+		std::condition_variable result_ready;
+		std::vector<std::optional<std::string>> results(count);
+
+		const auto work = [&](const std::size_t worker)
+		{
+			while (const auto job = scheduler.take(worker))
+			{
+				const auto index = job.value();
+				auto data = compress(index);
+
+				{
+					std::lock_guard _(results_mutex);
+					results[index] = std::move(data);
+				}
+
+				result_ready.notify_one();
+			}
+		};
+
+		std::vector<std::thread> threads;
+		for (auto i = 0u; i < worker_count; i++)
+		{
+			threads.emplace_back(work, i);
+		}
+
+		std::size_t total_size = 0;
+		for (auto index = 0u; index < count; index++)
+		{
+			std::string data;
+
+			{
+				std::unique_lock lock(results_mutex);
+				result_ready.wait(lock, [&]
+				{
+					return results[index].has_value();
+				});
+
+				data = std::move(results[index].value());
+				results[index].reset();
+			}
+
+			write(index, std::move(data));
+
+			total_size += sizes[index];
+			scheduler.written(index);
+		}
+
+		for (auto& thread : threads)
+		{
+			if (thread.joinable())
+			{
+				thread.join();
+			}
+		}
 
+		ZONETOOL_INFO("Compressed %zu blocks (%.2fmb) on %zu threads, peak %.2fmb held", count,
+			static_cast<double>(total_size) / 1024 / 1024, worker_count, static_cast<double>(scheduler.get_peak()) / 1024 / 1024);
+	}
 }
@@ -10,94 +10,73 @@
 
 namespace zonetool::imagefile
 {
-	template <typename T>
-	void compress_images(const std::vector<T*>& images)
+	// writes a pak straight to disk, the header hash covers everything after the header and is
+	// updated as blocks come in, then patched into the header by finish
+	class pak_writer
 	{
-		ZONETOOL_INFO("Compressing images...");
+	public:
+		pak_writer(const std::string& path, const void* header, std::size_t header_size, std::size_t hash_offset);
+
+		pak_writer(const pak_writer&) = delete;
+		pak_writer& operator=(const pak_writer&) = delete;
 
-		const auto max_threads = std::thread::hardware_concurrency() * 2;
-		const auto images_per_thread = std::max(1, static_cast<int>(images.size() / max_threads));
+		bool is_open() const;
 
-		std::vector<std::thread> threads;
+		// returns the file offset the data starts at, the header included
+		std::uint64_t write(const std::string& data);
+		std::uint64_t size() const;
 
-		const auto start_thread = [&](const int index, const int count)
+		struct block_range
 		{
-			threads.emplace_back([&, index, count]
-			{
-				for (auto i = index; i < index + count; i++)
-				{
-					const auto image = images[i];
-					for (auto o = 0; o < 4; o++)
-					{
-						auto& path = image->image_stream_blocks_paths[o];
-						if (!path.has_value())
-						{
-							continue;
-						}
-
-						const auto block = utils::io::read_file(path.value());
-						const auto compressed = compression::lz4::compress_lz4_block(block);
-						image->image_stream_blocks[o].emplace(compressed);
-					}
-				}
-			});
+			std::uint64_t offset;
+			std::uint64_t offset_end;
 		};
 
-		auto images_left = static_cast<int>(images.size());
-		auto index = 0;
-		while (images_left > 0)
-		{
-			const auto count = std::min(images_left, images_per_thread);
-			start_thread(index, count);
-			index += count;
-			images_left -= count;
-		}
+		// blocks with a content hash seen before are not written again and share the first range
+		block_range write_block(const std::string& data, const std::string& content_hash);
 
-		for (auto& thread : threads)
-		{
-			if (thread.joinable())
-			{
-				thread.join();
-			}
-		}
-	}
+		std::size_t get_duplicate_count() const;
+		std::uint64_t get_duplicate_size() const;
+
+		bool finish();
+
+	private:
+		std::ofstream stream_;
+		hash_state hash_state_{};
+		std::size_t hash_offset_;
+		std::uint64_t size_;
+
+		std::unordered_map<std::string, block_range> blocks_;
+		std::size_t duplicate_count_ = 0;
+		std::uint64_t duplicate_size_ = 0;
+	};
+
+	using compress_callback = std::function<std::string(std::size_t index)>;
+	using write_callback = std::function<void(std::size_t index, std::string&& data)>;
+
+	// runs compress for every index on a work stealing pool, largest input first, and hands the results to
+	// write on the calling thread in index order. sizes are the input sizes, a job only starts once its input
+	// fits in the memory budget (-imagememory <mb>) next to everything that is not written yet, finished blocks
+	// waiting for an earlier one included
+	void compress_blocks(const std::vector<std::size_t>& sizes, const compress_callback& compress, const write_callback& write);
 
 	template <typename T>
 	void generate(const std::string& fastfile, std::uint16_t index, int ff_version, const std::string& ff_header,
 		std::vector<T*> images, zone_memory* mem)
 	{
-		compress_images(images);
-
 		if (images.size() == 0)
 		{
 			return;
 		}
 
-		std::string image_file_buffer;
-
-		ZONETOOL_INFO("Writing imagefile...");
-
-		XPakHeader header{};
-		std::memcpy(&header.header, ff_header.data(), ff_header.size());
-		header.version = ff_version;
-
-		image_file_buffer.append(reinterpret_cast<char*>(&header), sizeof(XPakHeader));
-
-		const auto write_image_file = [&]
+		struct stream_block
 		{
-			const auto header = reinterpret_cast<XPakHeader*>(image_file_buffer.data());
-
-			const auto hash_start = reinterpret_cast<std::uint8_t*>(image_file_buffer.data() + sizeof(XPakHeader));
-			const auto len = image_file_buffer.size() - sizeof(XPakHeader);
-
-			const auto hash = utils::cryptography::sha256::compute(hash_start, len, false);
-			std::memcpy(header->hash.bytes, hash.data(), sizeof(header->hash));
-
-			const auto save_path = utils::io::directory_exists("zone") ? "zone/" : "";
-			const auto name = utils::string::va("%s%s.pak", save_path, fastfile.data(), index);
-			utils::io::write_file(name, image_file_buffer);
+			T* image;
+			int stream;
 		};
 
+		std::vector<stream_block> blocks;
+		std::vector<std::size_t> sizes;
 		for (auto i = 0; i < 4; i++)
 		{
 			for (const auto& image : images)
@@ -109,23 +88,62 @@ namespace zonetool::imagefile
 
 				image->image_stream_files[i] = mem->allocate<XStreamFile>();
 
-				if (!image->image_stream_blocks[i].has_value())
+				if (const auto& path = image->image_stream_blocks_paths[i]; path.has_value())
 				{
-					continue;
+					blocks.emplace_back(stream_block{image, i});
+					sizes.emplace_back(utils::io::file_size(path.value()));
 				}
+			}
+		}
 
-				const auto& data = image->image_stream_blocks[i].value();
-				const auto offset = image_file_buffer.size();
-				image_file_buffer.append(reinterpret_cast<const char*>(data.data()), data.size());
-				const auto offset_end = image_file_buffer.size();
-				image->image_stream_blocks[i].reset();
+		ZONETOOL_INFO("Compressing and writing imagefile...");
 
-				image->image_stream_files[i]->fileIndex = index;
-				image->image_stream_files[i]->offset = offset;
-				image->image_stream_files[i]->offsetEnd = offset_end;
-			}
+		XPakHeader header{};
+		std::memcpy(&header.header, ff_header.data(), ff_header.size());
+		header.version = ff_version;
+
+		const auto save_path = utils::io::directory_exists("zone") ? "zone/" : "";
+		const std::string name = utils::string::va("%s%s.pak", save_path, fastfile.data(), index);
+
+		pak_writer writer(name, &header, sizeof(XPakHeader), offsetof(XPakHeader, hash));
+		if (!writer.is_open())
+		{
+			ZONETOOL_ERROR("Failed to open \"%s\" for writing", name.data());
+			return;
+		}
+
+		// hashed on the workers, each index is only touched by the job that owns it. blocks are written in
+		// (stream, image) order, so the pak layout and the stream file offsets are the same on every build
+		std::vector<std::string> content_hashes(blocks.size());
+
+		compress_blocks(sizes, [&](const std::size_t i)
+		{
+			const auto& block = blocks[i];
+			const auto data = utils::io::read_file(block.image->image_stream_blocks_paths[block.stream].value());
+			auto compressed = compression::lz4::compress_lz4_block(data);
+			content_hashes[i] = utils::cryptography::sha256::compute(compressed, false);
+			return compressed;
+		}, [&](const std::size_t i, std::string&& data)
+		{
+			const auto& block = blocks[i];
+			const auto range = writer.write_block(data, content_hashes[i]);
+
+			auto* stream_file = block.image->image_stream_files[block.stream];
+			stream_file->fileIndex = index;
+			stream_file->offset = range.offset;
+			stream_file->offsetEnd = range.offset_end;
+		});
+
+		if (!writer.finish())
+		{
+			ZONETOOL_ERROR("Failed to write \"%s\"", name.data());
+			return;
 		}
 
-		write_image_file();
+		if (writer.get_duplicate_count())
+		{
+			ZONETOOL_INFO("Shared %zu duplicate image blocks, saved %.2fmb", writer.get_duplicate_count(),
+				static_cast<double>(writer.get_duplicate_size()) / 1024 / 1024);
+		}
 	}
 }
@@ -7,6 +7,13 @@ namespace zonetool
 {
 	namespace filesystem
 	{
+		namespace
+		{
+			// only the main thread changes the search paths, asset_prefetch workers resolve files through them
+			std::mutex search_paths_mutex;
+			std::size_t search_paths_version = 0;
+		}
+
 		file::file(const std::string& filepath_)
 		{
 			this->initialize(filepath_);
@@ -208,7 +215,7 @@ namespace zonetool
 		{
 			if (this->fp)
 			{
-				return fclose(this->fp);
+				return fclose(std::exchange(this->fp, nullptr));
 			}
 			return -1;
 		}
@@ -279,21 +286,35 @@ namespace zonetool
 			return paths;
 		}
 
+		std::size_t get_search_paths_version()
+		{
+			std::lock_guard<std::mutex> _(search_paths_mutex);
+			return search_paths_version;
+		}
+
 		void add_paths_from_directory(const std::string& dir, bool insert_at_beginning)
 		{
 			const auto extra_paths = load_extra_search_paths(dir);
+
+			std::lock_guard<std::mutex> _(search_paths_mutex);
 			auto& search_paths = get_search_paths();
 			search_paths.insert(insert_at_beginning ? search_paths.begin() : search_paths.end(), 
 				extra_paths.begin(), extra_paths.end());
+			search_paths_version++;
 		}
 
 		void set_fastfile(const std::string& ff)
 		{
-			auto& search_paths = get_search_paths();
+			{
+				std::lock_guard<std::mutex> _(search_paths_mutex);
+				auto& search_paths = get_search_paths();
+
+				search_paths.clear();
+				search_paths.emplace_back("zonetool\\" + ff + "\\");
+				search_paths.emplace_back("zonetool\\");
+				search_paths_version++;
+			}
 
-			search_paths.clear();
-			search_paths.emplace_back("zonetool\\" + ff + "\\");
-			search_paths.emplace_back("zonetool\\");
 			add_paths_from_directory("zonetool_paths");
 
 			fastfile = ff;
@@ -317,7 +338,13 @@ namespace zonetool
 
 		std::string get_file_path(const std::string& name)
 		{
-			const auto& search_paths = get_search_paths();
+			std::vector<std::string> search_paths;
+
+			{
+				std::lock_guard<std::mutex> _(search_paths_mutex);
+				search_paths = get_search_paths();
+			}
+
 			for (const auto& search_path : search_paths)
 			{
 				const auto full_path = search_path + "\\"s + name;
@@ -81,6 +81,9 @@ namespace zonetool
 		std::string get_dump_path();
 		bool create_directory(const std::string& name);
 		void add_paths_from_directory(const std::string& dir, bool insert_at_beginning = false);
+		// only safe to use on the thread that changes the search paths, other threads go through get_file_path
 		std::vector<std::string>& get_search_paths();
+		// changes whenever the search paths do
+		std::size_t get_search_paths_version();
 	}
 }
\ No newline at end of file
@@ -0,0 +1,402 @@
+#include <std_include.hpp>
+#include "json_fields.hpp"
+
+#include <utils/io.hpp>
+
+#include <zlib.h>
+
+namespace zonetool::json_fields
+{
+	namespace
+	{
+		template <typename T, typename V>
+		void store(std::uint8_t* dest, const V value)
+		{
+			const auto converted = static_cast<T>(value);
+			std::memcpy(dest, &converted, sizeof(T));
+		}
+
+		template <typename V>
+		void store(const field& field, std::uint8_t* dest, const V value)
+		{
+			switch (field.kind)
+			{
+			case field_kind::int8:
+				return store<std::int8_t>(dest, value);
+			case field_kind::uint8:
+				return store<std::uint8_t>(dest, value);
+			case field_kind::int16:
+				return store<std::int16_t>(dest, value);
+			case field_kind::uint16:
+				return store<std::uint16_t>(dest, value);
+			case field_kind::int32:
+				return store<std::int32_t>(dest, value);
+			case field_kind::uint32:
+				return store<std::uint32_t>(dest, value);
+			case field_kind::int64:
+				return store<std::int64_t>(dest, value);
+			case field_kind::uint64:
+				return store<std::uint64_t>(dest, value);
+			case field_kind::float32:
+				return store<float>(dest, value);
+			case field_kind::float64:
+				return store<double>(dest, value);
+			case field_kind::boolean:
+				return store<bool>(dest, value != 0);
+			}
+		}
+
+		std::size_t size_of(const field_kind kind)
+		{
+			switch (kind)
+			{
+			case field_kind::int8:
+			case field_kind::uint8:
+			case field_kind::boolean:
+				return 1;
+			case field_kind::int16:
+			case field_kind::uint16:
+				return 2;
+			case field_kind::int32:
+			case field_kind::uint32:
+			case field_kind::float32:
+				return 4;
+			default:
+				return 8;
+			}
+		}
+
+		[[noreturn]] void throw_type_error(const field& field, const char* type)
+		{
+			throw std::runtime_error("json field \""s + std::string(field.name) + "\" can't be read from " + type);
+		}
+
+		class field_sax
+		{
+		public:
+			field_sax(const field_table& table, void* object)
+				: table_(table)
+				, object_(static_cast<std::uint8_t*>(object))
+			{
+			}
+
+			bool null()
+			{
+				if (this->in_array())
+				{
+					throw_type_error(*this->stack_.back().array, "null");
+				}
+
+				// fields set to null keep their value
+				if (std::exchange(this->pending_, nullptr))
+				{
+					return true;
+				}
+
+				this->insert(nullptr);
+				return true;
+			}
+
+			bool boolean(const bool value)
+			{
+				return this->scalar(value, true);
+			}
+
+			bool number_integer(const json::number_integer_t value)
+			{
+				return this->scalar(value, false);
+			}
+
+			bool number_unsigned(const json::number_unsigned_t value)
+			{
+				return this->scalar(value, false);
+			}
+
+			bool number_float(const json::number_float_t value, const json::string_t&)
+			{
+				return this->scalar(value, false);
+			}
+
+			bool string(json::string_t& value)
+			{
+				this->check_no_field("a string");
+				this->insert(std::move(value));
+				return true;
+			}
+
+			bool binary(json::binary_t& value)
+			{
+				this->check_no_field("binary");
+				this->insert(json::binary(std::move(value)));
+				return true;
+			}
+
+			bool start_object(std::size_t)
+			{
+				this->check_no_field("an object");
+
+				if (this->stack_.empty())
+				{
+					this->root_ = json::object();
+					this->stack_.push_back({&this->root_});
+					return true;
+				}
+
+				this->stack_.push_back({this->insert(json::object())});
+				return true;
+			}
+
+			bool key(json::string_t& name)
+			{
+				// only keys of the document itself are table fields
+				this->key_ = std::move(name);
+				this->pending_ = this->stack_.size() == 1 ? this->table_.find(this->key_) : nullptr;
+				return true;
+			}
+
+			bool end_object()
+			{
+				this->stack_.pop_back();
+				return true;
+			}
+
+			bool start_array(std::size_t)
+			{
+				if (this->in_array())
+				{
+					throw_type_error(*this->stack_.back().array, "a nested array");
+				}
+
+				const auto* pending = std::exchange(this->pending_, nullptr);
+				if (pending)
+				{
+					if (pending->count == 1)
+					{
+						throw_type_error(*pending, "an array");
+					}
+
+					frame array{};
+					array.base = this->object_ + pending->offset;
+					array.array = pending;
+					this->stack_.push_back(array);
+					return true;
+				}
+
+				this->stack_.push_back({this->insert(json::array())});
+				return true;
+			}
+
+			bool end_array()
+			{
+				const auto& top = this->stack_.back();
+				if (top.array && top.index < top.array->count)
+				{
+					throw_type_error(*top.array, "a shorter array");
+				}
+
+				this->stack_.pop_back();
+				return true;
+			}
+
+			bool parse_error(std::size_t, const std::string&, const json::exception& ex)
+			{
+				throw std::runtime_error(ex.what());
+			}
+
+			json& result()
+			{
+				return this->root_;
+			}
+
+		private:
+			struct frame
+			{
+				json* dom;
+
+				// set while streaming the elements of a scalar array field
+				const field* array = nullptr;
+				std::uint8_t* base = nullptr;
+				std::size_t index = 0;
+			};
+
+			const field_table& table_;
+			std::uint8_t* object_;
+
+			json root_;
+			std::vector<frame> stack_;
+			json::string_t key_;
+			const field* pending_ = nullptr;
+
+			bool in_array() const
+			{
+				return !this->stack_.empty() && this->stack_.back().array;
+			}
+
+			void check_no_field(const char* type)
+			{
+				if (this->in_array())
+				{
+					throw_type_error(*this->stack_.back().array, type);
+				}
+
+				if (this->pending_)
+				{
+					throw_type_error(*this->pending_, type);
+				}
+			}
+
+			// numbers and booleans convert into each other like json::get does, only boolean fields need a boolean
+			template <typename V>
+			bool scalar(const V value, const bool is_boolean)
+			{
+				if (this->in_array())
+				{
+					auto& top = this->stack_.back();
+					if (top.array->kind == field_kind::boolean && !is_boolean)
+					{
+						throw_type_error(*top.array, "a number");
+					}
+
+					// extra elements are ignored, same as reading a fixed number of them by index
+					if (top.index < top.array->count)
+					{
+						store(*top.array, top.base + size_of(top.array->kind) * top.index, value);
+					}
+
+					top.index++;
+					return true;
+				}
+
+				const auto* pending = std::exchange(this->pending_, nullptr);
+				if (!pending)
+				{
+					this->insert(value);
+					return true;
+				}
+
+				if (pending->count > 1)
+				{
+					throw_type_error(*pending, is_boolean ? "a boolean" : "a number");
+				}
+
+				if (pending->kind == field_kind::boolean && !is_boolean)
+				{
+					throw_type_error(*pending, "a number");
+				}
+
+				store(*pending, this->object_ + pending->offset, value);
+				return true;
+			}
+
+			json* insert(json&& value)
+			{
+				if (this->stack_.empty())
+				{
+					this->root_ = std::move(value);
+					return &this->root_;
+				}
+
+				auto& top = this->stack_.back();
+				if (top.dom->is_array())
+				{
+					top.dom->push_back(std::move(value));
+					return &top.dom->back();
+				}
+
+				auto& slot = (*top.dom)[this->key_];
+				slot = std::move(value);
+				return &slot;
+			}
+		};
+
+		constexpr std::uint32_t cache_magic = 'CFJZ';
+		constexpr std::uint32_t cache_version = 2;
+
+		struct cache_header
+		{
+			std::uint32_t magic;
+			std::uint32_t version;
+			std::uint32_t layout_hash;
+			std::uint32_t source_crc;
+			std::uint64_t source_size;
+			std::uint64_t object_size;
+		};
+
+		std::uint32_t get_crc32(const void* data, const std::size_t size)
+		{
+			const auto crc = crc32(0L, Z_NULL, 0);
+			return static_cast<std::uint32_t>(crc32(crc, static_cast<const unsigned char*>(data), static_cast<uInt>(size)));
+		}
+	}
+
+	field_table::field_table(const std::initializer_list<field> fields)
+		: fields_(fields)
+	{
+		this->lookup_.reserve(this->fields_.size());
+
+		auto hash = get_crc32(nullptr, 0);
+		for (auto i = 0u; i < this->fields_.size(); i++)
+		{
+			const auto& field = this->fields_[i];
+			this->lookup_.emplace(field.name, i);
+
+			const std::uint64_t layout[] = {field.offset, static_cast<std::uint64_t>(field.kind), field.count};
+
+			hash = static_cast<std::uint32_t>(crc32(hash, reinterpret_cast<const unsigned char*>(field.name.data()), static_cast<uInt>(field.name.size())));
+			hash = static_cast<std::uint32_t>(crc32(hash, reinterpret_cast<const unsigned char*>(layout), sizeof(layout)));
+		}
+
+		this->layout_hash_ = hash;
+	}
+
+	const field* field_table::find(const std::string_view name) const
+	{
+		const auto iter = this->lookup_.find(name);
+		return iter != this->lookup_.end() ? &this->fields_[iter->second] : nullptr;
+	}
+
+	std::uint32_t field_table::layout_hash() const
+	{
+		return this->layout_hash_;
+	}
+
+	json parse(const std::vector<std::uint8_t>& bytes, const field_table& table, void* object)
+	{
+		field_sax sax(table, object);
+		json::sax_parse(bytes.begin(), bytes.end(), &sax);
+		return std::move(sax.result());
+	}
+
+	json parse_cached(const std::vector<std::uint8_t>& bytes, const field_table& table, void* object, const std::size_t object_size,
+		const std::string& cache_path)
+	{
+		cache_header header{};
+		header.magic = cache_magic;
+		header.version = cache_version;
+		header.layout_hash = table.layout_hash();
+		header.source_crc = get_crc32(bytes.data(), bytes.size());
+		header.source_size = bytes.size();
+		header.object_size = object_size;
+
+		std::string cached;
+		if (utils::io::read_file(cache_path, &cached) && cached.size() >= sizeof(cache_header) + object_size &&
+			std::memcmp(cached.data(), &header, sizeof(cache_header)) == 0)
+		{
+			const auto image = cached.data() + sizeof(cache_header);
+			std::memcpy(object, image, object_size);
+
+			const auto residual = reinterpret_cast<const std::uint8_t*>(image + object_size);
+			return json::from_cbor(residual, reinterpret_cast<const std::uint8_t*>(cached.data() + cached.size()));
+		}
+
+		auto data = parse(bytes, table, object);
+
+		std::string compiled;
+		compiled.append(reinterpret_cast<const char*>(&header), sizeof(cache_header));
+		compiled.append(static_cast<const char*>(object), object_size);
+		json::to_cbor(data, compiled);
+
+		utils::io::write_file(cache_path, compiled);
+		return data;
+	}
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+// the stored type always comes from the member itself, so a table can't write a different type than the struct declares
+#define JSON_FIELD(__struct__, __field__) \
+	zonetool::json_fields::make_field<std::remove_all_extents_t<decltype(__struct__::__field__)>>(#__field__, \
+		offsetof(__struct__, __field__))
+
+#define JSON_FIELD_ARR(__struct__, __field__, __size__) \
+	zonetool::json_fields::make_field<std::remove_all_extents_t<decltype(__struct__::__field__)>>(#__field__, \
+		offsetof(__struct__, __field__), __size__)
+
+namespace zonetool::json_fields
+{
+	enum class field_kind : std::uint8_t
+	{
+		int8,
+		uint8,
+		int16,
+		uint16,
+		int32,
+		uint32,
+		int64,
+		uint64,
+		float32,
+		float64,
+		boolean,
+	};
+
+	struct field
+	{
+		std::string_view name;
+		std::size_t offset;
+		field_kind kind;
+		// scalars read as a json array of this many elements when above 1
+		std::size_t count;
+	};
+
+	template <typename T>
+	constexpr field_kind kind_of()
+	{
+		if constexpr (std::is_same_v<T, bool>)
+		{
+			return field_kind::boolean;
+		}
+		else if constexpr (std::is_floating_point_v<T>)
+		{
+			return sizeof(T) == 4 ? field_kind::float32 : field_kind::float64;
+		}
+		else if constexpr (std::is_enum_v<T>)
+		{
+			return kind_of<std::underlying_type_t<T>>();
+		}
+		else
+		{
+			static_assert(std::is_integral_v<T>, "unsupported json field type");
+
+			constexpr auto is_signed = std::is_signed_v<T>;
+			switch (sizeof(T))
+			{
+			case 1:
+				return is_signed ? field_kind::int8 : field_kind::uint8;
+			case 2:
+				return is_signed ? field_kind::int16 : field_kind::uint16;
+			case 4:
+				return is_signed ? field_kind::int32 : field_kind::uint32;
+			default:
+				return is_signed ? field_kind::int64 : field_kind::uint64;
+			}
+		}
+	}
+
+	template <typename T>
+	constexpr field make_field(const std::string_view name, const std::size_t offset, const std::size_t count = 1)
+	{
+		return {name, offset, kind_of<T>(), count};
+	}
+
+	class field_table
+	{
+	public:
+		field_table(std::initializer_list<field> fields);
+
+		const field* find(std::string_view name) const;
+
+		// changes whenever a field is added, moved or retyped, used to invalidate compiled caches
+		std::uint32_t layout_hash() const;
+
+	private:
+		std::vector<field> fields_;
+		std::unordered_map<std::string_view, std::size_t> lookup_;
+		std::uint32_t layout_hash_{};
+	};
+
+	// streams a json document, values of table fields are written straight into object
+	// everything the table doesn't cover is returned as a regular dom for the remaining parse code.
+	// fields are checked like json::get: null leaves them untouched, a value of the wrong type throws and
+	// arrays need at least count elements
+	json parse(const std::vector<std::uint8_t>& bytes, const field_table& table, void* object);
+
+	// same as parse, but keeps a binary sidecar at cache_path keyed by the json contents
+	// an unchanged document is restored by copying the object image back and reading the residual dom from cbor
+	// object must be zero initialized and object_size bytes long
+	json parse_cached(const std::vector<std::uint8_t>& bytes, const field_table& table, void* object, std::size_t object_size,
+		const std::string& cache_path);
+}
@@ -0,0 +1,390 @@
+#include <std_include.hpp>
+#include "log.hpp"
+
+#include "game/shared.hpp"
+
+#include <utils/flags.hpp>
+#include <utils/string.hpp>
+
+namespace zonetool::log
+{
+	namespace
+	{
+		constexpr std::size_t ring_size = 4096;
+		constexpr std::size_t message_size = 512;
+
+		// -quiet prints this many lines of a format before collapsing the rest
+		constexpr std::size_t quiet_repeat_limit = 3;
+
+		static_assert((ring_size & (ring_size - 1)) == 0);
+
+		struct entry
+		{
+			level lvl;
+			const char* function;
+			const char* fmt;
+			std::uint32_t thread;
+			double time;
+			char message[message_size];
+			std::string long_message;
+		};
+
+		struct slot
+		{
+			std::atomic_size_t sequence;
+			entry data;
+		};
+
+		struct repeat_count
+		{
+			const char* function;
+			std::size_t count;
+		};
+
+		const char* get_level_name(const level lvl)
+		{
+			switch (lvl)
+			{
+			case level::warning:
+				return "WARNING";
+			case level::error:
+				return "ERROR";
+			case level::fatal:
+				return "FATAL";
+			default:
+				return "INFO";
+			}
+		}
+
+		std::vector<std::string> get_category_list(const std::string& flag)
+		{
+			std::vector<std::string> categories;
+			if (const auto value = utils::flags::get_flag(flag); value.has_value())
+			{
+				for (const auto& category : utils::string::split(value.value(), ','))
+				{
+					if (!category.empty())
+					{
+						categories.emplace_back(category);
+					}
+				}
+			}
+
+			return categories;
+		}
+
+		level get_min_level()
+		{
+			const auto value = utils::flags::get_flag("loglevel");
+			if (value == "warning")
+			{
+				return level::warning;
+			}
+
+			if (value == "error")
+			{
+				return level::error;
+			}
+
+			return level::info;
+		}
+
+		std::uint32_t get_thread_index()
+		{
+			static std::atomic_uint32_t next_index = 0;
+			static thread_local const auto index = next_index++;
+			return index;
+		}
+
+		// bounded multi producer ring (sequence numbered slots), only the writer thread consumes
+		class logger
+		{
+		public:
+			logger()
+				: slots_(ring_size)
+				, start_(std::chrono::steady_clock::now())
+				, min_level_(get_min_level())
+				, filter_(get_category_list("logfilter"))
+				, mute_(get_category_list("logmute"))
+				, quiet_(utils::flags::has_flag("quiet"))
+			{
+				for (auto i = 0u; i < ring_size; i++)
+				{
+					this->slots_[i].sequence.store(i, std::memory_order_relaxed);
+				}
+
+				if (const auto path = utils::flags::get_flag("logfile"); path.has_value())
+				{
+					this->file_.open(path.value(), std::ios::binary | std::ios::trunc);
+				}
+
+				std::thread(&logger::run, this).detach();
+			}
+
+			bool accepts(const level lvl) const
+			{
+				return lvl >= this->min_level_;
+			}
+
+			void push(const level lvl, const char* function, const char* fmt, va_list args)
+			{
+				auto pos = this->enqueue_pos_.load(std::memory_order_relaxed);
+				slot* target = nullptr;
+
+				while (true)
+				{
+					target = &this->slots_[pos & (ring_size - 1)];
+					const auto sequence = target->sequence.load(std::memory_order_acquire);
+					const auto diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos);
+
+					if (diff == 0)
+					{
+						if (this->enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+						{
+							break;
+						}
+					}
+					else if (diff < 0)
+					{
+						// full, wait for the writer instead of dropping the line
+						std::this_thread::yield();
+						pos = this->enqueue_pos_.load(std::memory_order_relaxed);
+					}
+					else
+					{
+						pos = this->enqueue_pos_.load(std::memory_order_relaxed);
+					}
+				}
+
+				auto& data = target->data;
+				data.lvl = lvl;
+				data.function = function;
+				data.fmt = fmt;
+				data.thread = get_thread_index();
+				data.time = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - this->start_).count();
+
+				va_list copy;
+				va_copy(copy, args);
+				const auto length = vsnprintf(data.message, sizeof(data.message), fmt, args);
+				if (length >= static_cast<int>(sizeof(data.message)))
+				{
+					data.long_message.resize(static_cast<std::size_t>(length));
+					vsnprintf(data.long_message.data(), data.long_message.size() + 1, fmt, copy);
+				}
+				va_end(copy);
+
+				target->sequence.store(pos + 1, std::memory_order_release);
+
+				this->published_.fetch_add(1, std::memory_order_release);
+				this->wake_.fetch_add(1, std::memory_order_release);
+				this->wake_.notify_one();
+			}
+
+			void flush()
+			{
+				const auto target = this->published_.load(std::memory_order_acquire);
+				const auto request = this->flush_requests_.fetch_add(1, std::memory_order_acq_rel) + 1;
+
+				this->wake_.fetch_add(1, std::memory_order_release);
+				this->wake_.notify_one();
+
+				while (true)
+				{
+					const auto progress = this->progress_.load(std::memory_order_acquire);
+					if (this->flushes_done_.load(std::memory_order_acquire) >= request
+						&& this->drained_.load(std::memory_order_acquire) >= target)
+					{
+						return;
+					}
+
+					this->progress_.wait(progress, std::memory_order_acquire);
+				}
+			}
+
+		private:
+			std::vector<slot> slots_;
+			std::atomic_size_t enqueue_pos_ = 0;
+			std::size_t dequeue_pos_ = 0;
+
+			std::atomic_size_t published_ = 0;
+			std::atomic_size_t drained_ = 0;
+			std::atomic_size_t wake_ = 0;
+			std::atomic_size_t progress_ = 0;
+			std::atomic_size_t flush_requests_ = 0;
+			std::atomic_size_t flushes_done_ = 0;
+
+			std::chrono::steady_clock::time_point start_;
+			level min_level_;
+			std::vector<std::string> filter_;
+			std::vector<std::string> mute_;
+			bool quiet_;
+			std::ofstream file_;
+
+			std::unordered_map<const char*, repeat_count> repeats_;
+
+			// categories are function names, so "image" matches every image::parse/dump
+			static bool matches_any(const std::string& category, const std::vector<std::string>& list)
+			{
+				return std::ranges::any_of(list, [&](const std::string& entry)
+				{
+					return category.find(entry) != std::string::npos;
+				});
+			}
+
+			bool is_category_visible(const std::string& category) const
+			{
+				if (!this->filter_.empty() && !matches_any(category, this->filter_))
+				{
+					return false;
+				}
+
+				return !matches_any(category, this->mute_);
+			}
+
+			// lines beyond the limit are counted and reported on the next flush
+			bool is_repeat(const entry& data)
+			{
+				if (!this->quiet_ || data.lvl != level::info)
+				{
+					return false;
+				}
+
+				auto& repeat = this->repeats_[data.fmt];
+				repeat.function = data.function;
+				return ++repeat.count > quiet_repeat_limit;
+			}
+
+			void write_entry(const entry& data, std::string& console, std::string& file)
+			{
+				const std::string category = strip_template(data.function);
+				const auto* message = data.long_message.empty() ? data.message : data.long_message.data();
+
+				if (this->file_.is_open())
+				{
+					const json line =
+					{
+						{"time", data.time},
+						{"level", get_level_name(data.lvl)},
+						{"category", category},
+						{"thread", data.thread},
+						{"message", message},
+					};
+
+					file += line.dump(-1, ' ', false, json::error_handler_t::replace);
+					file += '\n';
+				}
+
+				if (!this->is_category_visible(category) || this->is_repeat(data))
+				{
+					return;
+				}
+
+				console += utils::string::va("[ %s ][ %s ]: ", get_level_name(data.lvl), category.data());
+				console += message;
+				console += '\n';
+			}
+
+			void write_repeats(std::string& console)
+			{
+				for (const auto& [fmt, repeat] : this->repeats_)
+				{
+					if (repeat.count > quiet_repeat_limit)
+					{
+						console += utils::string::va("[ INFO ][ %s ]: %zu more like \"%s\"\n", strip_template(repeat.function),
+							repeat.count - quiet_repeat_limit, fmt);
+					}
+				}
+
+				this->repeats_.clear();
+			}
+
+			void run()
+			{
+				std::string console;
+				std::string file;
+
+				while (true)
+				{
+					const auto wake = this->wake_.load(std::memory_order_acquire);
+					const auto requests = this->flush_requests_.load(std::memory_order_acquire);
+
+					auto drained = this->drained_.load(std::memory_order_relaxed);
+					while (true)
+					{
+						auto& target = this->slots_[this->dequeue_pos_ & (ring_size - 1)];
+						if (target.sequence.load(std::memory_order_acquire) != this->dequeue_pos_ + 1)
+						{
+							break;
+						}
+
+						this->write_entry(target.data, console, file);
+						target.data.long_message.clear();
+
+						target.sequence.store(this->dequeue_pos_ + ring_size, std::memory_order_release);
+						this->dequeue_pos_++;
+						drained++;
+					}
+
+					if (requests != this->flushes_done_.load(std::memory_order_relaxed))
+					{
+						this->write_repeats(console);
+					}
+
+					if (!console.empty())
+					{
+						fwrite(console.data(), 1, console.size(), stdout);
+						fflush(stdout);
+						console.clear();
+					}
+
+					if (!file.empty())
+					{
+						this->file_.write(file.data(), file.size());
+						this->file_.flush();
+						file.clear();
+					}
+
+					this->drained_.store(drained, std::memory_order_release);
+					this->flushes_done_.store(requests, std::memory_order_release);
+					this->progress_.fetch_add(1, std::memory_order_release);
+					this->progress_.notify_all();
+
+					this->wake_.wait(wake, std::memory_order_acquire);
+				}
+			}
+		};
+
+		logger& get_logger()
+		{
+			// never destroyed, the writer thread is detached and may still be draining at exit
+			static auto* instance = []
+			{
+				auto* result = new logger();
+				std::atexit(flush);
+				std::at_quick_exit(flush);
+				return result;
+			}();
+
+			return *instance;
+		}
+	}
+
+	void write(const level lvl, const char* function, const char* fmt, ...)
+	{
+		auto& instance = get_logger();
+		if (!instance.accepts(lvl))
+		{
+			return;
+		}
+
+		va_list args;
+		va_start(args, fmt);
+		instance.push(lvl, function, fmt, args);
+		va_end(args);
+	}
+
+	void flush()
+	{
+		get_logger().flush();
+	}
+}
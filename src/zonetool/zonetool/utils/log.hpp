@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstdint>
+
+namespace zonetool::log
+{
+	enum class level : std::uint8_t
+	{
+		info,
+		warning,
+		error,
+		fatal,
+	};
+
+	// formats into a lock-free ring that a background thread drains to the console, never blocks on console output.
+	// function is the raw __FUNCTION__ literal, the category is derived from it on the logging thread
+	//
+	// -loglevel <info|warning|error>  minimum level that is printed
+	// -logfilter <a,b>                only print categories containing one of these
+	// -logmute <a,b>                  never print categories containing one of these
+	// -logfile <path>                 also write every entry as a json line
+	// -quiet                          collapse info lines that repeat the same format into one summary line
+	void write(level lvl, const char* function, const char* fmt, ...);
+
+	// waits until everything logged so far is printed
+	void flush();
+}
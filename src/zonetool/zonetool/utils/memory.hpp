@@ -1,12 +1,16 @@
 #pragma once
 
 #include <mutex>
+#include <string_view>
+#include <unordered_set>
 #include <minwindef.h>
 #include <memoryapi.h>
 
 #include <WinBase.h>
 #include <WinUser.h>
 
+#include "log.hpp"
+
 #undef StrDup
 
 namespace zonetool
@@ -19,11 +23,23 @@ namespace zonetool
 		std::size_t mem_pos_;
 		std::recursive_mutex mutex_;
 
+		// every string handed out by intern_string, views into the pool
+		std::unordered_set<std::string_view> strings_;
+
+		char* copy_string(const std::string_view& value)
+		{
+			// the pool is zeroed, so the terminator is already in place
+			auto pointer = this->manual_allocate<char>(value.size() + 1);
+			memcpy(pointer, value.data(), value.size());
+			return pointer;
+		}
+
 	public:
 		zone_memory(const zone_memory& mem) 
 			: memory_pool_(mem.memory_pool_)
 			  , memory_size_(mem.memory_size_)
 			  , mem_pos_(mem.mem_pos_)
+			  , strings_(mem.strings_)
 		{
 		}
 
@@ -47,8 +63,9 @@ namespace zonetool
 
 		void print_statistics()
 		{
-			printf("ZoneTool memory statistics: used %ub of ram (%fmb).\n", static_cast<unsigned int>(this->mem_pos_),
-				static_cast<float>(this->mem_pos_) / 1024 / 1024);
+			log::flush();
+			printf("ZoneTool memory statistics: used %ub of ram (%fmb), %zu unique strings.\n", static_cast<unsigned int>(this->mem_pos_),
+				static_cast<float>(this->mem_pos_) / 1024 / 1024, this->strings_.size());
 		}
 
 		void free()
@@ -59,12 +76,15 @@ namespace zonetool
 			this->memory_pool_ = nullptr;
 			this->memory_size_ = 0;
 			this->mem_pos_ = 0;
+			this->strings_.clear();
 		}
 
 		void clear()
 		{
+			std::lock_guard<std::recursive_mutex> g(this->mutex_);
 			memset(this->memory_pool_, 0, this->memory_size_);
 			this->mem_pos_ = 0;
+			this->strings_.clear();
 		}
 		
 		~zone_memory()
@@ -72,23 +92,36 @@ namespace zonetool
 			this->free();
 		}
 
-		char* duplicate_string(const char* name)
+		// equal strings share one copy, so the result must not be written to. write_pooled_str writes those copies once
+		const char* intern_string(const std::string_view& value)
 		{
 			std::lock_guard<std::recursive_mutex> g(this->mutex_);
 
-			// get string length
-			auto len = strlen(name) + 1;
-			auto pointer = this->manual_allocate<char>(len);
-			memcpy(pointer, name, len);
+			const auto found = this->strings_.find(value);
+			if (found != this->strings_.end())
+			{
+				return found->data();
+			}
 
-			// return pointer
+			const auto* pointer = this->copy_string(value);
+			this->strings_.emplace(pointer, value.size());
 			return pointer;
 		}
 
+		char* duplicate_string(const char* name)
+		{
+			return this->duplicate_string(std::string_view(name));
+		}
+
 		char* duplicate_string(const std::string& name)
+		{
+			return this->duplicate_string(std::string_view(name));
+		}
+
+		char* duplicate_string(const std::string_view& name)
 		{
 			std::lock_guard<std::recursive_mutex> g(this->mutex_);
-			return this->duplicate_string(name.data());
+			return this->copy_string(name);
 		}
 
 		template <typename T>
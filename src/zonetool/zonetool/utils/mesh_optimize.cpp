@@ -0,0 +1,293 @@
+#include <std_include.hpp>
+#include "mesh_optimize.hpp"
+
+namespace zonetool::mesh_optimize
+{
+	namespace
+	{
+		constexpr auto cache_size = 32;
+		constexpr auto cache_decay_power = 1.5f;
+		constexpr auto last_tri_score = 0.75f;
+		constexpr auto valence_boost_scale = 2.0f;
+		constexpr auto valence_boost_power = 0.5f;
+
+		struct vertex_data
+		{
+			int cache_position = -1;
+			std::uint32_t live_tris = 0;
+			std::uint32_t first_tri = 0;
+			float score = 0.0f;
+		};
+
+		float get_vertex_score(const vertex_data& vertex)
+		{
+			if (vertex.live_tris == 0)
+			{
+				return -1.0f;
+			}
+
+			auto score = 0.0f;
+			if (vertex.cache_position >= 0)
+			{
+				if (vertex.cache_position < 3)
+				{
+					// the three vertices of the last triangle score the same so it isn't favoured twice
+					score = last_tri_score;
+				}
+				else
+				{
+					const auto scaler = 1.0f / (cache_size - 3);
+					score = std::pow(1.0f - static_cast<float>(vertex.cache_position - 3) * scaler, cache_decay_power);
+				}
+			}
+
+			return score + valence_boost_scale * std::pow(static_cast<float>(vertex.live_tris), -valence_boost_power);
+		}
+	}
+
+	double get_acmr(const std::uint16_t* indices, const std::size_t tri_count, const std::size_t cache_size)
+	{
+		if (tri_count == 0)
+		{
+			return 0.0;
+		}
+
+		std::vector<std::uint32_t> fifo(cache_size, std::numeric_limits<std::uint32_t>::max());
+		std::size_t head = 0;
+		std::size_t misses = 0;
+
+		for (auto i = 0u; i < tri_count * 3; i++)
+		{
+			if (std::find(fifo.begin(), fifo.end(), indices[i]) != fifo.end())
+			{
+				continue;
+			}
+
+			fifo[head] = indices[i];
+			head = (head + 1) % cache_size;
+			misses++;
+		}
+
+		return static_cast<double>(misses) / static_cast<double>(tri_count);
+	}
+
+	void optimize_vertex_cache(std::uint16_t* indices, const std::size_t tri_count)
+	{
+		if (tri_count < 2)
+		{
+			return;
+		}
+
+		const auto index_count = tri_count * 3;
+
+		// work on compact vertex ids, a range usually only touches a few of the surface vertices
+		std::vector<std::uint16_t> unique(indices, indices + index_count);
+		std::sort(unique.begin(), unique.end());
+		unique.erase(std::unique(unique.begin(), unique.end()), unique.end());
+
+		std::vector<std::uint32_t> local(index_count);
+		for (auto i = 0u; i < index_count; i++)
+		{
+			local[i] = static_cast<std::uint32_t>(std::lower_bound(unique.begin(), unique.end(), indices[i]) - unique.begin());
+		}
+
+		std::vector<vertex_data> vertices(unique.size());
+		for (const auto v : local)
+		{
+			vertices[v].live_tris++;
+		}
+
+		// triangles of every vertex, packed
+		std::uint32_t offset = 0;
+		for (auto& vertex : vertices)
+		{
+			vertex.first_tri = offset;
+			offset += vertex.live_tris;
+		}
+
+		std::vector<std::uint32_t> vertex_tris(index_count);
+		std::vector<std::uint32_t> fill(vertices.size());
+		for (auto i = 0u; i < index_count; i++)
+		{
+			const auto v = local[i];
+			vertex_tris[vertices[v].first_tri + fill[v]++] = i / 3;
+		}
+
+		for (auto& vertex : vertices)
+		{
+			vertex.score = get_vertex_score(vertex);
+		}
+
+		std::vector<float> tri_scores(tri_count);
+		std::vector<bool> emitted(tri_count);
+		for (auto t = 0u; t < tri_count; t++)
+		{
+			tri_scores[t] = vertices[local[t * 3]].score + vertices[local[t * 3 + 1]].score + vertices[local[t * 3 + 2]].score;
+		}
+
+		std::vector<std::uint32_t> cache;
+		std::vector<std::uint32_t> next_cache;
+		cache.reserve(cache_size + 3);
+		next_cache.reserve(cache_size + 3);
+
+		std::vector<std::uint16_t> result;
+		result.reserve(index_count);
+
+		std::size_t dead_end_cursor = 0;
+		auto best_tri = 0u;
+		auto best_score = tri_scores[0];
+		for (auto t = 1u; t < tri_count; t++)
+		{
+			if (tri_scores[t] > best_score)
+			{
+				best_score = tri_scores[t];
+				best_tri = t;
+			}
+		}
+
+		for (auto emitted_count = 0u; emitted_count < tri_count; emitted_count++)
+		{
+			emitted[best_tri] = true;
+
+			// new triangle goes to the front of the lru cache
+			next_cache.clear();
+			for (auto o = 0u; o < 3; o++)
+			{
+				const auto v = local[best_tri * 3 + o];
+				result.emplace_back(indices[best_tri * 3 + o]);
+
+				if (std::find(next_cache.begin(), next_cache.end(), v) == next_cache.end())
+				{
+					next_cache.emplace_back(v);
+				}
+
+				auto& vertex = vertices[v];
+				const auto first = vertex_tris.begin() + vertex.first_tri;
+				std::iter_swap(std::find(first, first + vertex.live_tris, best_tri), first + vertex.live_tris - 1);
+				vertex.live_tris--;
+			}
+
+			const auto tri_vertices = next_cache.size();
+			for (const auto v : cache)
+			{
+				if (std::find(next_cache.begin(), next_cache.begin() + tri_vertices, v) == next_cache.begin() + tri_vertices)
+				{
+					next_cache.emplace_back(v);
+				}
+			}
+
+			std::swap(cache, next_cache);
+
+			for (auto i = 0u; i < cache.size(); i++)
+			{
+				vertices[cache[i]].cache_position = i < cache_size ? static_cast<int>(i) : -1;
+			}
+
+			auto found = false;
+			best_score = -1.0f;
+
+			// rescore everything that moved, including the vertices that just fell out of the cache
+			for (const auto v : cache)
+			{
+				auto& vertex = vertices[v];
+				const auto old_score = vertex.score;
+				vertex.score = get_vertex_score(vertex);
+				const auto delta = vertex.score - old_score;
+
+				for (auto i = 0u; i < vertex.live_tris; i++)
+				{
+					const auto t = vertex_tris[vertex.first_tri + i];
+					tri_scores[t] += delta;
+
+					if (tri_scores[t] > best_score)
+					{
+						best_score = tri_scores[t];
+						best_tri = t;
+						found = true;
+					}
+				}
+			}
+
+			if (cache.size() > cache_size)
+			{
+				cache.resize(cache_size);
+			}
+
+			if (!found)
+			{
+				// nothing left around the cache, continue with the next unused triangle
+				while (dead_end_cursor < tri_count && emitted[dead_end_cursor])
+				{
+					dead_end_cursor++;
+				}
+
+				if (dead_end_cursor == tri_count)
+				{
+					break;
+				}
+
+				best_tri = static_cast<std::uint32_t>(dead_end_cursor);
+			}
+		}
+
+		std::memcpy(indices, result.data(), index_count * sizeof(std::uint16_t));
+	}
+
+	std::vector<std::uint16_t> get_fetch_remap(const std::uint16_t* indices, const std::size_t tri_count,
+		const std::vector<index_range>& vertex_ranges, const std::size_t vertex_count)
+	{
+		constexpr auto unassigned = std::numeric_limits<std::uint32_t>::max();
+
+		std::vector<std::uint32_t> range_of_vertex(vertex_count, unassigned);
+		std::vector<std::uint32_t> next(vertex_ranges.size());
+		for (auto r = 0u; r < vertex_ranges.size(); r++)
+		{
+			const auto& range = vertex_ranges[r];
+			next[r] = range.begin;
+
+			for (auto v = range.begin; v < range.begin + range.count && v < vertex_count; v++)
+			{
+				range_of_vertex[v] = r;
+			}
+		}
+
+		std::vector<std::uint32_t> remap(vertex_count, unassigned);
+		for (auto i = 0u; i < tri_count * 3; i++)
+		{
+			const auto v = indices[i];
+			if (v >= vertex_count || remap[v] != unassigned || range_of_vertex[v] == unassigned)
+			{
+				continue;
+			}
+
+			remap[v] = next[range_of_vertex[v]]++;
+		}
+
+		std::vector<std::uint16_t> result(vertex_count);
+		for (auto v = 0u; v < vertex_count; v++)
+		{
+			if (range_of_vertex[v] == unassigned)
+			{
+				result[v] = static_cast<std::uint16_t>(v);
+				continue;
+			}
+
+			if (remap[v] == unassigned)
+			{
+				remap[v] = next[range_of_vertex[v]]++;
+			}
+
+			result[v] = static_cast<std::uint16_t>(remap[v]);
+		}
+
+		return result;
+	}
+
+	void remap_indices(std::uint16_t* indices, const std::size_t index_count, const std::vector<std::uint16_t>& remap)
+	{
+		for (auto i = 0u; i < index_count; i++)
+		{
+			indices[i] = remap[indices[i]];
+		}
+	}
+}
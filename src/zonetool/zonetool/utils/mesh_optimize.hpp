@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace zonetool::mesh_optimize
+{
+	struct index_range
+	{
+		std::uint32_t begin;
+		std::uint32_t count;
+	};
+
+	// average cache misses per triangle with a fifo post transform cache
+	double get_acmr(const std::uint16_t* indices, std::size_t tri_count, std::size_t cache_size = 16);
+
+	// forsyth's linear speed vertex cache optimisation, reorders the triangles in place
+	void optimize_vertex_cache(std::uint16_t* indices, std::size_t tri_count);
+
+	// new index for every vertex, in order of first use by the triangles. vertices only move inside their range,
+	// unused ones keep their order at the end of it
+	std::vector<std::uint16_t> get_fetch_remap(const std::uint16_t* indices, std::size_t tri_count,
+		const std::vector<index_range>& vertex_ranges, std::size_t vertex_count);
+
+	void remap_indices(std::uint16_t* indices, std::size_t index_count, const std::vector<std::uint16_t>& remap);
+
+	// stride is the number of elements per vertex
+	template <typename T>
+	void remap_vertices(T* dst, const T* src, const std::vector<std::uint16_t>& remap, const std::size_t stride = 1)
+	{
+		for (auto i = 0u; i < remap.size(); i++)
+		{
+			std::memcpy(&dst[remap[i] * stride], &src[i * stride], sizeof(T) * stride);
+		}
+	}
+}
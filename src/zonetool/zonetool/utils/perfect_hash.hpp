@@ -0,0 +1,282 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+// compile-time minimal-probe hash tables (hash and displace)
+// every key is found with a single slot lookup, tables are built entirely by the compiler
+namespace perfect_hash
+{
+	constexpr std::uint32_t invalid_index = 0xFFFFFFFF;
+
+	constexpr std::size_t next_pow2(std::size_t value)
+	{
+		std::size_t result = 1;
+		while (result < value)
+		{
+			result <<= 1;
+		}
+		return result;
+	}
+
+	constexpr std::uint32_t mix(std::uint32_t key, std::uint32_t seed)
+	{
+		// murmur3 finalizer
+		std::uint32_t h = key ^ (seed * 0x9E3779B9u);
+		h ^= h >> 16;
+		h *= 0x85EBCA6Bu;
+		h ^= h >> 13;
+		h *= 0xC2B2AE35u;
+		h ^= h >> 16;
+		return h;
+	}
+
+	constexpr std::uint32_t max_bucket_size = 32;
+
+	template <std::size_t N>
+	class table
+	{
+		static_assert(N > 0, "perfect_hash::table needs at least one key");
+
+	public:
+		static constexpr std::size_t bucket_count = next_pow2(N);
+		static constexpr std::size_t slot_count = bucket_count * 2;
+
+		// duplicate keys are allowed, the first occurrence wins
+		constexpr table(const std::array<std::uint32_t, N>& keys)
+			: keys_(keys)
+		{
+			for (auto& slot : this->slots_)
+			{
+				slot = invalid_index;
+			}
+
+			// counting sort keys into buckets
+			std::array<std::uint32_t, bucket_count + 1> bucket_start{};
+			std::array<std::uint32_t, N> bucket_items{};
+
+			for (std::size_t i = 0; i < N; i++)
+			{
+				bucket_start[bucket_of(keys[i]) + 1]++;
+			}
+
+			std::uint32_t largest_bucket = 0;
+			for (std::size_t b = 0; b < bucket_count; b++)
+			{
+				largest_bucket = bucket_start[b + 1] > largest_bucket ? bucket_start[b + 1] : largest_bucket;
+				bucket_start[b + 1] += bucket_start[b];
+			}
+
+			std::array<std::uint32_t, bucket_count> fill{};
+			for (std::size_t i = 0; i < N; i++)
+			{
+				const auto b = bucket_of(keys[i]);
+				bucket_items[bucket_start[b] + fill[b]++] = static_cast<std::uint32_t>(i);
+			}
+
+			if (largest_bucket > max_bucket_size)
+			{
+				throw "perfect_hash: too many keys share a bucket";
+			}
+
+			// order buckets by size, the largest ones are the hardest to fit so they go first
+			std::array<std::uint32_t, max_bucket_size + 2> size_start{};
+			std::array<std::uint32_t, bucket_count> bucket_order{};
+
+			for (std::size_t b = 0; b < bucket_count; b++)
+			{
+				size_start[max_bucket_size - (bucket_start[b + 1] - bucket_start[b]) + 1]++;
+			}
+
+			for (std::size_t i = 0; i <= max_bucket_size; i++)
+			{
+				size_start[i + 1] += size_start[i];
+			}
+
+			for (std::size_t b = 0; b < bucket_count; b++)
+			{
+				bucket_order[size_start[max_bucket_size - (bucket_start[b + 1] - bucket_start[b])]++] = static_cast<std::uint32_t>(b);
+			}
+
+			for (const auto b : bucket_order)
+			{
+				const auto size = bucket_start[b + 1] - bucket_start[b];
+				if (!size)
+				{
+					break;
+				}
+
+				this->place_bucket(b, &bucket_items[bucket_start[b]], size);
+			}
+		}
+
+		constexpr std::uint32_t find(std::uint32_t key) const
+		{
+			const auto index = this->slots_[slot_of(key, this->seeds_[bucket_of(key)])];
+			if (index != invalid_index && this->keys_[index] == key)
+			{
+				return index;
+			}
+			return invalid_index;
+		}
+
+		constexpr std::uint32_t key(std::size_t index) const
+		{
+			return this->keys_[index];
+		}
+
+	private:
+		std::array<std::uint32_t, N> keys_{};
+		std::array<std::uint32_t, bucket_count> seeds_{};
+		std::array<std::uint32_t, slot_count> slots_{};
+
+		static constexpr std::size_t bucket_of(std::uint32_t key)
+		{
+			return mix(key, 0) & (bucket_count - 1);
+		}
+
+		static constexpr std::size_t slot_of(std::uint32_t key, std::uint32_t seed)
+		{
+			return mix(key, seed + 1) & (slot_count - 1);
+		}
+
+		constexpr void place_bucket(std::size_t bucket, const std::uint32_t* items, std::uint32_t count)
+		{
+			for (std::uint32_t seed = 0; seed < 0x100000; seed++)
+			{
+				std::array<std::size_t, max_bucket_size> chosen{};
+				std::uint32_t chosen_count = 0;
+				auto fits = true;
+
+				for (std::uint32_t i = 0; i < count && fits; i++)
+				{
+					const auto key = this->keys_[items[i]];
+
+					// duplicates share the slot of their first occurrence
+					auto duplicate = false;
+					for (std::uint32_t j = 0; j < i; j++)
+					{
+						duplicate |= this->keys_[items[j]] == key;
+					}
+
+					if (duplicate)
+					{
+						continue;
+					}
+
+					const auto slot = slot_of(key, seed);
+					fits = this->slots_[slot] == invalid_index;
+
+					for (std::uint32_t j = 0; j < chosen_count && fits; j++)
+					{
+						fits = chosen[j] != slot;
+					}
+
+					chosen[chosen_count++] = slot;
+				}
+
+				if (!fits)
+				{
+					continue;
+				}
+
+				this->seeds_[bucket] = seed;
+
+				for (std::uint32_t i = 0, c = 0; i < count; i++)
+				{
+					auto duplicate = false;
+					for (std::uint32_t j = 0; j < i; j++)
+					{
+						duplicate |= this->keys_[items[j]] == this->keys_[items[i]];
+					}
+
+					if (!duplicate)
+					{
+						this->slots_[chosen[c++]] = items[i];
+					}
+				}
+
+				return;
+			}
+
+			throw "perfect_hash: unable to find a seed for bucket";
+		}
+	};
+
+	template <std::size_t N>
+	class string_table
+	{
+	public:
+		using hash_function = std::uint32_t(*)(std::string_view);
+
+		constexpr string_table(const std::string_view (&names)[N], hash_function hash)
+			: names_(names)
+			, hash_(hash)
+			, table_(make_keys(names, hash))
+		{
+		}
+
+		constexpr string_table(const std::array<std::string_view, N>& names, hash_function hash)
+			: names_(names.data())
+			, hash_(hash)
+			, table_(make_keys(names.data(), hash))
+		{
+		}
+
+		// exact (case sensitive) lookup, same semantics as a linear search for the first match
+		constexpr std::uint32_t index_of(std::string_view name) const
+		{
+			const auto index = this->table_.find(this->hash_(name));
+			if (index != invalid_index && this->names_[index] == name)
+			{
+				return index;
+			}
+
+			// the hash is allowed to fold case, so a miss on the slot can still be a case variant
+			if (index != invalid_index)
+			{
+				for (std::uint32_t i = 0; i < N; i++)
+				{
+					if (this->names_[i] == name)
+					{
+						return i;
+					}
+				}
+			}
+
+			return invalid_index;
+		}
+
+		constexpr std::string_view name_of_hash(std::uint32_t hash) const
+		{
+			const auto index = this->table_.find(hash);
+			return index != invalid_index ? this->names_[index] : std::string_view{};
+		}
+
+		constexpr std::string_view operator[](std::size_t index) const
+		{
+			return this->names_[index];
+		}
+
+		static constexpr std::size_t size()
+		{
+			return N;
+		}
+
+	private:
+		const std::string_view* names_;
+		hash_function hash_;
+		table<N> table_;
+
+		static constexpr std::array<std::uint32_t, N> make_keys(const std::string_view* names, hash_function hash)
+		{
+			std::array<std::uint32_t, N> keys{};
+			for (std::size_t i = 0; i < N; i++)
+			{
+				keys[i] = hash(names[i]);
+			}
+			return keys;
+		}
+	};
+}
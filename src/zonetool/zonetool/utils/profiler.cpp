@@ -0,0 +1,359 @@
+#include <std_include.hpp>
+#include "profiler.hpp"
+
+#include "utils.hpp"
+
+#include <utils/flags.hpp>
+#include <utils/io.hpp>
+
+namespace zonetool::profiler
+{
+	namespace
+	{
+		constexpr auto invalid_index = std::numeric_limits<std::size_t>::max();
+
+		struct event
+		{
+			const char* category;
+			std::string name;
+			const char* type;
+			std::uint32_t thread;
+			std::uint64_t start;
+			std::uint64_t duration;
+			// time spent in nested scopes on the same thread, duration minus this is the self time
+			std::uint64_t children;
+			std::vector<std::uint64_t> stream_bytes;
+			std::uint64_t bytes;
+		};
+
+		std::mutex mutex;
+		std::vector<event> events;
+		std::atomic_bool recording = false;
+		std::string zone_name;
+		std::uint64_t zone_start = 0;
+		std::uint32_t generation = 0;
+		std::uint32_t depth = 0;
+
+		// open scopes of this thread as event index and generation
+		thread_local std::vector<std::pair<std::size_t, std::uint32_t>> scope_stack;
+
+		std::uint64_t now()
+		{
+			return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+				std::chrono::steady_clock::now().time_since_epoch()).count());
+		}
+
+		double to_msec(const std::uint64_t nanoseconds)
+		{
+			return static_cast<double>(nanoseconds) / 1000000.0;
+		}
+
+		std::uint32_t get_thread_index()
+		{
+			static std::atomic_uint32_t next_thread = 0;
+			thread_local const auto index = next_thread++;
+			return index;
+		}
+
+		std::size_t push_event(const char* category, std::string&& name, const char* type)
+		{
+			std::lock_guard<std::mutex> _(mutex);
+
+			const auto index = events.size();
+			events.push_back({category, std::move(name), type, get_thread_index(), now(), 0, 0, {}, 0});
+			scope_stack.emplace_back(index, generation);
+			return index;
+		}
+
+		struct type_summary
+		{
+			std::size_t count;
+			std::uint64_t self;
+			std::uint64_t bytes;
+		};
+
+		void print_summary()
+		{
+			std::map<std::string, std::uint64_t> category_totals;
+			std::map<std::pair<std::string, std::string>, type_summary> type_totals;
+			std::vector<std::uint64_t> stream_totals;
+
+			for (const auto& event : events)
+			{
+				const auto self = event.duration - std::min(event.children, event.duration);
+				category_totals[event.category] += self;
+
+				if (event.type)
+				{
+					auto& summary = type_totals[{event.category, event.type}];
+					summary.count++;
+					summary.self += self;
+					summary.bytes += event.bytes;
+				}
+
+				stream_totals.resize(std::max(stream_totals.size(), event.stream_bytes.size()));
+				for (auto i = 0u; i < event.stream_bytes.size(); i++)
+				{
+					stream_totals[i] += event.stream_bytes[i];
+				}
+			}
+
+			ZONETOOL_INFO("Build profile for \"%s\" (self time):", zone_name.data());
+
+			// the table goes straight to stdout, keep it below the header
+			log::flush();
+
+			printf("  %-16s %12s\n", "category", "msec");
+			for (const auto& [category, self] : category_totals)
+			{
+				printf("  %-16s %12.2f\n", category.data(), to_msec(self));
+			}
+
+			std::vector<std::pair<std::pair<std::string, std::string>, type_summary>> types(type_totals.begin(), type_totals.end());
+			std::sort(types.begin(), types.end(), [](const auto& a, const auto& b)
+			{
+				return a.second.self > b.second.self;
+			});
+
+			printf("\n  %-16s %-24s %8s %12s %14s\n", "category", "type", "count", "msec", "bytes");
+			for (const auto& [key, summary] : types)
+			{
+				printf("  %-16s %-24s %8zu %12.2f %14llu\n", key.first.data(), key.second.data(), summary.count,
+					to_msec(summary.self), summary.bytes);
+			}
+
+			std::vector<const event*> slowest;
+			for (const auto& event : events)
+			{
+				if (event.type)
+				{
+					slowest.push_back(&event);
+				}
+			}
+
+			const auto count = std::min<std::size_t>(slowest.size(), 20);
+			std::partial_sort(slowest.begin(), slowest.begin() + count, slowest.end(), [](const event* a, const event* b)
+			{
+				return (a->duration - a->children) > (b->duration - b->children);
+			});
+
+			printf("\n  slowest assets\n");
+			for (auto i = 0u; i < count; i++)
+			{
+				printf("  %-16s %-24s %12.2f  %s\n", slowest[i]->category, slowest[i]->type,
+					to_msec(slowest[i]->duration - slowest[i]->children), slowest[i]->name.data());
+			}
+
+			printf("\n  bytes written per stream\n");
+			for (auto i = 0u; i < stream_totals.size(); i++)
+			{
+				printf("  %-4u %14llu\n", i, stream_totals[i]);
+			}
+		}
+
+		// chrome://tracing and perfetto read this directly
+		void write_trace()
+		{
+			auto trace_events = json::array();
+			for (const auto& event : events)
+			{
+				json entry;
+				entry["name"] = event.name;
+				entry["cat"] = event.category;
+				entry["ph"] = "X";
+				entry["ts"] = static_cast<double>(event.start - zone_start) / 1000.0;
+				entry["dur"] = static_cast<double>(event.duration) / 1000.0;
+				entry["pid"] = 0;
+				entry["tid"] = event.thread;
+
+				auto args = json::object();
+				if (event.type)
+				{
+					args["type"] = event.type;
+				}
+
+				if (!event.stream_bytes.empty())
+				{
+					args["bytes"] = event.bytes;
+					args["streams"] = event.stream_bytes;
+				}
+
+				entry["args"] = std::move(args);
+				trace_events.push_back(std::move(entry));
+			}
+
+			json trace;
+			trace["traceEvents"] = std::move(trace_events);
+			trace["displayTimeUnit"] = "ms";
+
+			const auto path = "zonetool\\_profile\\"s + zone_name + ".json"s;
+			utils::io::write_file(path, trace.dump());
+
+			ZONETOOL_INFO("Wrote build trace to \"%s\"", path.data());
+		}
+	}
+
+	void begin(const std::string& zone, const bool force)
+	{
+		std::lock_guard<std::mutex> _(mutex);
+
+		// a build inside a benchmark run records into the benchmark's recording
+		if (depth++)
+		{
+			return;
+		}
+
+		events.clear();
+		zone_name = zone;
+		zone_start = now();
+		generation++;
+
+		recording = force || utils::flags::has_flag("profile");
+	}
+
+	void end()
+	{
+		std::lock_guard<std::mutex> _(mutex);
+
+		if (!depth || --depth || !recording)
+		{
+			return;
+		}
+
+		recording = false;
+		generation++;
+
+		if (utils::flags::has_flag("profile"))
+		{
+			print_summary();
+			write_trace();
+		}
+	}
+
+	bool is_recording()
+	{
+		return recording;
+	}
+
+	std::vector<phase_time> get_phases()
+	{
+		std::lock_guard<std::mutex> _(mutex);
+
+		std::vector<phase_time> phases;
+		for (const auto& event : events)
+		{
+			if (std::strcmp(event.category, "phase"))
+			{
+				continue;
+			}
+
+			const auto phase = std::find_if(phases.begin(), phases.end(), [&](const phase_time& time)
+			{
+				return time.name == event.name;
+			});
+
+			if (phase != phases.end())
+			{
+				phase->msec += to_msec(event.duration);
+			}
+			else
+			{
+				phases.push_back({event.name, to_msec(event.duration)});
+			}
+		}
+
+		return phases;
+	}
+
+	scope::scope(const char* category, const char* name)
+		: index_(invalid_index)
+	{
+		if (recording)
+		{
+			this->generation_ = generation;
+			this->index_ = push_event(category, name, nullptr);
+		}
+	}
+
+	scope::scope(const char* category, const std::string& name, const char* type)
+		: index_(invalid_index)
+	{
+		if (recording)
+		{
+			this->generation_ = generation;
+			this->index_ = push_event(category, std::string(name), type);
+		}
+	}
+
+	scope::scope(const char* category, asset_interface* asset, const char* type)
+		: index_(invalid_index)
+	{
+		if (recording)
+		{
+			this->generation_ = generation;
+			this->index_ = push_event(category, asset->name(), type);
+		}
+	}
+
+	scope::~scope()
+	{
+		if (this->index_ == invalid_index)
+		{
+			return;
+		}
+
+		const auto end_time = now();
+
+		std::vector<std::uint64_t> stream_bytes;
+		std::uint64_t bytes = 0;
+		if (this->buf_)
+		{
+			for (auto i = 0u; i < this->stream_start_.size(); i++)
+			{
+				stream_bytes.push_back(this->buf_->stream_offset(static_cast<std::uint8_t>(i)) - this->stream_start_[i]);
+			}
+
+			bytes = this->buf_->size() - this->size_start_;
+		}
+
+		std::lock_guard<std::mutex> _(mutex);
+
+		if (!scope_stack.empty())
+		{
+			scope_stack.pop_back();
+		}
+
+		// the recording was restarted or stopped while this scope was open
+		if (this->generation_ != generation)
+		{
+			return;
+		}
+
+		auto& event = events[this->index_];
+		event.duration = end_time - event.start;
+		event.stream_bytes = std::move(stream_bytes);
+		event.bytes = bytes;
+
+		if (!scope_stack.empty() && scope_stack.back().second == generation)
+		{
+			events[scope_stack.back().first].children += event.duration;
+		}
+	}
+
+	void scope::track_streams(zone_buffer* buf, const std::size_t stream_count)
+	{
+		if (this->index_ == invalid_index)
+		{
+			return;
+		}
+
+		this->buf_ = buf;
+		this->size_start_ = buf->size();
+
+		this->stream_start_.resize(stream_count);
+		for (auto i = 0u; i < stream_count; i++)
+		{
+			this->stream_start_[i] = buf->stream_offset(static_cast<std::uint8_t>(i));
+		}
+	}
+}
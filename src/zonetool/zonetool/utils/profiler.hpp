@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace zonetool
+{
+	class asset_interface;
+	class zone_buffer;
+}
+
+namespace zonetool::profiler
+{
+	// records scoped timings while a zone is built, enabled with -profile or by a benchmark run
+	// begin/end bracket one build and may nest, everything recorded up to the outermost end ends up in the summary and the trace
+	void begin(const std::string& zone, bool force = false);
+	void end();
+	bool is_recording();
+
+	struct phase_time
+	{
+		std::string name;
+		double msec;
+	};
+
+	// inclusive time of every "phase" scope of the last recording, in first seen order
+	std::vector<phase_time> get_phases();
+
+	class scope
+	{
+	public:
+		scope(const char* category, const char* name);
+		scope(const char* category, const std::string& name, const char* type);
+		// the asset name is only fetched while recording
+		scope(const char* category, asset_interface* asset, const char* type);
+		~scope();
+
+		scope(const scope&) = delete;
+		scope& operator=(const scope&) = delete;
+
+		// attributes the growth of every stream of buf during this scope to it
+		void track_streams(zone_buffer* buf, std::size_t stream_count);
+
+	private:
+		std::size_t index_;
+		std::uint32_t generation_ = 0;
+		zone_buffer* buf_ = nullptr;
+		std::uint64_t size_start_ = 0;
+		std::vector<std::uint64_t> stream_start_;
+	};
+}
@@ -3,45 +3,14 @@
 #include "shader.hpp"
 #include <zlib.h>
 #include "dxbc_checksum.hpp"
+#include "dxbc_decoder.hpp"
 
-#include <utils/bit_buffer.hpp>
 #include <utils/io.hpp>
 
 namespace shader
 {
 	namespace
 	{
-		unsigned char* parse_shader_chunk(unsigned char* program, unsigned int program_size, unsigned int* chunk_size)
-		{
-			const auto header = reinterpret_cast<dx11_shader_header*>(program);
-
-			auto shader_chunk_offset = 0;
-			for (auto i = 0u; i < header->chunk_count; i++)
-			{
-				const auto offset = *reinterpret_cast<int*>(
-					reinterpret_cast<size_t>(program) + sizeof(dx11_shader_header) + sizeof(int) * i);
-
-				const auto type = *reinterpret_cast<int*>(reinterpret_cast<size_t>(program) + offset);
-				if (type == 'RDHS' || type == 'XEHS')
-				{
-					shader_chunk_offset = offset;
-				}
-
-				if (i >= header->chunk_count - 1)
-				{
-					*chunk_size = header->program_size - shader_chunk_offset;
-				}
-				else
-				{
-					const auto next_offset = *reinterpret_cast<int*>(
-						reinterpret_cast<size_t>(program) + sizeof(dx11_shader_header) + sizeof(int) * (i + 1));
-					*chunk_size = next_offset - shader_chunk_offset;
-				}
-			}
-
-			return reinterpret_cast<unsigned char*>(reinterpret_cast<size_t>(program) + shader_chunk_offset);
-		}
-
 		unsigned long get_crc32(void* data_address, std::uint32_t data_len)
 		{
 			unsigned long crc = crc32(0L, Z_NULL, 0);
@@ -53,166 +22,47 @@ namespace shader
 		{
 			return std::to_string(get_crc32(data_address, data_len));
 		}
-	}
-
-	std::vector<size_t> get_dest_reference_offsets(unsigned char* program, unsigned int program_size)
-	{
-		std::vector<size_t> offsets;
-
-		unsigned int chunk_size{};
-		auto chunk = parse_shader_chunk(program, program_size, &chunk_size);
-		const auto offset = chunk - program;
 
-		utils::bit_buffer_le bit_buffer({reinterpret_cast<char*>(chunk), chunk_size});
-
-		if (chunk_size == 0)
+		struct cached_program
 		{
-			utils::io::write_file("shader.cso", std::string{(char*)program, program_size}, false);
-		}
+			std::vector<unsigned char> source;
+			dest_remap_function remap;
+			remapped_program result;
+		};
 
-		[[maybe_unused]] const auto type = bit_buffer.read_bytes(4); // "SHEX"
-		assert(type == 'XEHS' || type == 'RDHS');
-		[[maybe_unused]] const auto len = bit_buffer.read_bytes(4);
-		[[maybe_unused]] const auto minor_version = bit_buffer.read_bits(4);
-		[[maybe_unused]] const auto major_version = bit_buffer.read_bits(4);
-		assert(major_version == 5);
-		[[maybe_unused]] const auto program_type = bit_buffer.read_bytes(1);
-		assert(program_type >= 0 && program_type <= 5);
+		std::mutex remap_cache_mutex;
+		std::unordered_map<std::uint64_t, std::vector<std::unique_ptr<cached_program>>> remap_cache;
 
-		bit_buffer.read_bytes(2);
-		[[maybe_unused]] const auto num_dwords = bit_buffer.read_bytes(4);
-
-		while (bit_buffer.total() < len * 8)
+		const remapped_program* find_remapped_program(const std::vector<std::unique_ptr<cached_program>>& entries,
+			const unsigned char* program, unsigned int program_size, dest_remap_function remap)
 		{
-			[[maybe_unused]] const auto opcode = bit_buffer.read_bits(10);
-			bit_buffer.read_bits(14);
-			[[maybe_unused]] const auto opcode_len = bit_buffer.read_bits(6);
-			auto extended = bit_buffer.read_bits(1);
-			bit_buffer.read_bits(1);
-
-			while (extended)
+			for (const auto& entry : entries)
 			{
-				bit_buffer.read_bits(31);
-				extended = bit_buffer.read_bits(1);
-			}
-
-			std::function<void()> read_operand;
-
-			read_operand = [&]()
-			{
-				const auto num_components_type = bit_buffer.read_bits(1);
-				bit_buffer.read_bits(11);
-				const auto operand_type = bit_buffer.read_bits(7);
-				bit_buffer.read_bits(1);
-				[[maybe_unused]] const auto dimension = bit_buffer.read_bits(1);
-
-				auto num_components = 0;
-				switch (num_components_type)
+				if (entry->remap == remap && std::memcmp(entry->source.data(), program, program_size) == 0)
 				{
-				case 0:
-					num_components = 0;
-					break;
-				case 1:
-					num_components = 1;
-					break;
-				case 2:
-					num_components = 4;
-					break;
-				case 3:
-					throw std::runtime_error("D3D10_SB_OPERAND_N_COMPONENT not supported");
-					break;
-				}
-
-				for (auto i = 0; i < 3; i++)
-				{
-					bit_buffer.read_bits(1);
-					bit_buffer.read_bits(2);
-				}
-
-				bit_buffer.read_bits(1);
-
-				const auto extended_operand = bit_buffer.read_bits(1);
-				if (extended_operand)
-				{
-					bit_buffer.read_bytes(4);
+					return &entry->result;
 				}
+			}
 
-				/*uint64_t values[3]{};
-				for (auto i = 0; i < dimension; i++)
-				{
-					switch (index_representations[i])
-					{
-					case 0:
-						values[i] = bit_buffer.read_bytes(4);
-						break;
-					case 1:
-						values[i] = bit_buffer.read_uint64();
-					case 2:
-						read_operand();
-						break;
-					case 3:
-						values[i] = bit_buffer.read_bytes(4);
-						read_operand();
-						break;
-					case 4:
-						values[i] = bit_buffer.read_uint64();
-						read_operand();
-						break;
-					default:
-						throw std::runtime_error("Invalid representation");
-					}
-					printf("%i ", values[i]);
-				}*/
-
-				if (operand_type == 8)
-				{
-					const auto cb_index = bit_buffer.read_bytes(4);
-					const auto dest_offset = bit_buffer.total() / 8;
-					const auto dest = bit_buffer.read_bytes(4);
-
-					if (cb_index <= 4 && dest < 70) // workaround
-					{
-						offsets.push_back(dest_offset + offset);
-					}
-				}
+			return nullptr;
+		}
+	}
 
-				switch (operand_type)
-				{
-				case (4):
-					for (auto i = 0; i < num_components; i++)
-					{
-						bit_buffer.read_bytes(4);
-					}
-					break;
-				case (5):
-					for (auto i = 0; i < num_components; i++)
-					{
-						bit_buffer.read_bytes(4);
-						bit_buffer.read_bytes(4);
-					}
-					break;
-				}
-			};
+	std::vector<size_t> get_dest_reference_offsets(unsigned char* program, unsigned int program_size)
+	{
+		std::vector<decoder::constant_buffer_reference> references;
+		if (!decoder::get_constant_buffer_references(program, program_size, references))
+		{
+			utils::io::write_file("shader.cso", std::string{(char*)program, program_size}, false);
+		}
 
-			// parse operands
-			if (opcode_len > 0)
+		std::vector<size_t> offsets;
+		for (const auto& reference : references)
+		{
+			// only the code constant buffers move between h2 and h1
+			if (reference.slot <= 4 && reference.reg < 70)
 			{
-				const auto bits_to_read = (4 * 8) * (opcode_len - 1);
-				const auto end = bit_buffer.total() + bits_to_read;
-				auto total = bit_buffer.total();
-
-				if (opcode == 120)
-				{
-					bit_buffer.read_bytes(4);
-				}
-
-				while (bit_buffer.total() < end)
-				{
-					read_operand();
-					total = bit_buffer.total();
-				}
-
-				bit_buffer.set_bit(end);
+				offsets.push_back(reference.offset);
 			}
 		}
 
@@ -235,4 +85,61 @@ namespace shader
 
 		return get_crc32(program, program_size);
 	}
+
+	void clear_remap_cache()
+	{
+		std::lock_guard<std::mutex> _(remap_cache_mutex);
+		remap_cache.clear();
+	}
+
+	const remapped_program& remap_dest_references(const unsigned char* program, const unsigned int program_size,
+		const dest_remap_function remap)
+	{
+		// the crc is far cheaper than decoding and checksumming, the source compare rules out collisions
+		const auto key = (static_cast<std::uint64_t>(get_crc32(const_cast<unsigned char*>(program), program_size)) << 32) | program_size;
+
+		{
+			std::lock_guard<std::mutex> _(remap_cache_mutex);
+			const auto iter = remap_cache.find(key);
+			if (iter != remap_cache.end())
+			{
+				if (const auto* result = find_remapped_program(iter->second, program, program_size, remap))
+				{
+					return *result;
+				}
+			}
+		}
+
+		auto entry = std::make_unique<cached_program>();
+		entry->source.assign(program, program + program_size);
+		entry->remap = remap;
+
+		auto& new_program = entry->result.program;
+		new_program = entry->source;
+
+		const auto offsets = get_dest_reference_offsets(new_program.data(), program_size);
+		for (const auto& offset : offsets)
+		{
+			const auto dest = reinterpret_cast<unsigned int*>(new_program.data() + offset);
+			*dest = remap(*dest);
+		}
+
+		const auto checksum = generate_checksum(new_program.data(), program_size);
+		const auto header = reinterpret_cast<dx11_shader_header*>(new_program.data());
+		std::memcpy(header->checksum, &checksum, sizeof(shader_checksum));
+
+		entry->result.crc32 = get_crc32(new_program.data(), program_size);
+
+		std::lock_guard<std::mutex> _(remap_cache_mutex);
+		auto& entries = remap_cache[key];
+
+		// another thread may have finished the same program first
+		if (const auto* result = find_remapped_program(entries, program, program_size, remap))
+		{
+			return *result;
+		}
+
+		entries.emplace_back(std::move(entry));
+		return entries.back()->result;
+	}
 }
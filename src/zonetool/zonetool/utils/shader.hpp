@@ -22,4 +22,20 @@ namespace shader
 	shader_checksum generate_checksum(unsigned char* program, unsigned int program_size);
 
 	unsigned int calc_crc32(unsigned char* program, unsigned int program_size);
+
+	struct remapped_program
+	{
+		std::vector<unsigned char> program;
+		unsigned int crc32;
+	};
+
+	using dest_remap_function = unsigned int(*)(unsigned int dest);
+
+	// rewrites every constant buffer register reference through remap and fixes up the dxbc checksum
+	// results are cached by program contents, so a program shared by many techsets is only processed once
+	const remapped_program& remap_dest_references(const unsigned char* program, unsigned int program_size,
+		dest_remap_function remap);
+
+	// references into the cache stay valid until this is called
+	void clear_remap_cache();
 }
@@ -0,0 +1,269 @@
+#include <std_include.hpp>
+#include "size_report.hpp"
+
+#include "utils.hpp"
+#include "compression.hpp"
+
+#include <utils/flags.hpp>
+#include <utils/string.hpp>
+
+namespace zonetool
+{
+	namespace
+	{
+		constexpr std::size_t block_size = 0x10000;
+
+		double get_ratio(const std::size_t compressed_size, const std::size_t size)
+		{
+			return size ? static_cast<double>(compressed_size) / static_cast<double>(size) : 0.0;
+		}
+
+		void write_file(const std::string& path, const std::string& data)
+		{
+			auto file = filesystem::file(path);
+			file.create_path();
+			file.open("wb", false, true);
+			file.write(data.data(), data.size(), 1);
+			file.close();
+		}
+
+		std::string get_report_path(const std::string& fastfile_path, const char* suffix)
+		{
+			return std::filesystem::path(fastfile_path).replace_extension().string() + suffix;
+		}
+
+		// asset names can contain commas
+		std::string escape_csv(const std::string& value)
+		{
+			if (value.find_first_of(",\"") == std::string::npos)
+			{
+				return value;
+			}
+
+			std::string escaped = "\"";
+			for (const auto c : value)
+			{
+				if (c == '"')
+				{
+					escaped += '"';
+				}
+
+				escaped += c;
+			}
+
+			return escaped + "\"";
+		}
+	}
+
+	size_report::size_report(zone_buffer* buf, const std::size_t stream_count)
+		: enabled_(utils::flags::has_flag("sizereport"))
+		, buf_(buf)
+		, stream_start_(stream_count)
+	{
+	}
+
+	bool size_report::is_enabled() const
+	{
+		return this->enabled_;
+	}
+
+	void size_report::begin_asset()
+	{
+		if (!this->enabled_)
+		{
+			return;
+		}
+
+		for (auto i = 0u; i < this->stream_start_.size(); i++)
+		{
+			this->stream_start_[i] = this->buf_->stream_offset(static_cast<std::uint8_t>(i));
+		}
+
+		this->size_start_ = this->buf_->size();
+	}
+
+	void size_report::end_asset(asset_interface* asset, const char* type)
+	{
+		if (!this->enabled_)
+		{
+			return;
+		}
+
+		asset_entry entry{asset->name(), type, this->size_start_, this->buf_->size() - this->size_start_, {}};
+		entry.streams.resize(this->stream_start_.size());
+
+		for (auto i = 0u; i < this->stream_start_.size(); i++)
+		{
+			entry.streams[i] = this->buf_->stream_offset(static_cast<std::uint8_t>(i)) - this->stream_start_[i];
+		}
+
+		this->assets_.emplace_back(std::move(entry));
+	}
+
+	std::vector<size_report::block_entry> size_report::compress_blocks(const codec block_codec) const
+	{
+		const auto size = this->buf_->size();
+		const auto* data = this->buf_->buffer();
+
+		std::vector<block_entry> blocks((size + block_size - 1) / block_size);
+
+		// blocks are compressed independently, so unlike the fastfile itself this can run on every core
+		std::atomic_size_t next_block = 0;
+		const auto compress_next = [&]
+		{
+			for (auto index = next_block++; index < blocks.size(); index = next_block++)
+			{
+				auto& block = blocks[index];
+				block.offset = index * block_size;
+				block.size = std::min(block_size, size - block.offset);
+				block.compressed_size = block_codec == codec::lz4
+					? compression::lz4::compress_lz4_block(data + block.offset, block.size).size()
+					: compression::compress_zlib(data + block.offset, block.size).size();
+			}
+		};
+
+		std::vector<std::thread> threads;
+		const auto thread_count = std::min<std::size_t>(std::max(1u, std::thread::hardware_concurrency()), blocks.size());
+		for (auto i = 1u; i < thread_count; i++)
+		{
+			threads.emplace_back(compress_next);
+		}
+
+		compress_next();
+
+		for (auto& thread : threads)
+		{
+			thread.join();
+		}
+
+		// assets were written in buffer order, walk both lists together
+		std::vector<std::size_t> largest_bytes(blocks.size());
+		std::size_t first_block = 0;
+		for (const auto& asset : this->assets_)
+		{
+			const auto asset_end = asset.offset + asset.size;
+			while (first_block < blocks.size() && blocks[first_block].offset + blocks[first_block].size <= asset.offset)
+			{
+				first_block++;
+			}
+
+			for (auto index = first_block; index < blocks.size() && blocks[index].offset < asset_end; index++)
+			{
+				auto& block = blocks[index];
+				const auto overlap = std::min(asset_end, block.offset + block.size) - std::max(asset.offset, block.offset);
+
+				block.asset_count++;
+				if (overlap > largest_bytes[index])
+				{
+					largest_bytes[index] = overlap;
+					block.largest_asset = &asset;
+				}
+			}
+		}
+
+		return blocks;
+	}
+
+	void size_report::save(const std::string& fastfile_path, const codec block_codec) const
+	{
+		if (!this->enabled_)
+		{
+			return;
+		}
+
+		const auto blocks = this->compress_blocks(block_codec);
+
+		struct type_entry
+		{
+			std::size_t count;
+			std::uint64_t size;
+			std::vector<std::uint64_t> streams;
+		};
+
+		std::map<std::string, type_entry> types;
+		std::vector<std::uint64_t> stream_totals(this->stream_start_.size());
+
+		for (const auto& asset : this->assets_)
+		{
+			auto& type = types[asset.type];
+			type.count++;
+			type.size += asset.size;
+			type.streams.resize(asset.streams.size());
+
+			for (auto i = 0u; i < asset.streams.size(); i++)
+			{
+				type.streams[i] += asset.streams[i];
+				stream_totals[i] += asset.streams[i];
+			}
+		}
+
+		std::size_t compressed_total = 0;
+		for (const auto& block : blocks)
+		{
+			compressed_total += block.compressed_size;
+		}
+
+		json report;
+		report["size"] = this->buf_->size();
+		report["compressed_size"] = compressed_total;
+		report["block_size"] = block_size;
+		report["streams"] = stream_totals;
+
+		auto& types_json = report["types"] = json::array();
+		for (const auto& [name, type] : types)
+		{
+			types_json.push_back({{"type", name}, {"count", type.count}, {"size", type.size}, {"streams", type.streams}});
+		}
+
+		auto& assets_json = report["assets"] = json::array();
+		for (const auto& asset : this->assets_)
+		{
+			assets_json.push_back({{"name", asset.name}, {"type", asset.type}, {"offset", asset.offset},
+				{"size", asset.size}, {"streams", asset.streams}});
+		}
+
+		auto& blocks_json = report["blocks"] = json::array();
+		for (const auto& block : blocks)
+		{
+			blocks_json.push_back({{"offset", block.offset}, {"size", block.size}, {"compressed_size", block.compressed_size},
+				{"ratio", get_ratio(block.compressed_size, block.size)}, {"assets", block.asset_count},
+				{"largest_asset", block.largest_asset ? block.largest_asset->name : ""}});
+		}
+
+		write_file(get_report_path(fastfile_path, "_sizes.json"), report.dump(4));
+
+		std::string assets_csv = "name,type,offset,size";
+		for (auto i = 0u; i < stream_totals.size(); i++)
+		{
+			assets_csv += utils::string::va(",stream_%u", i);
+		}
+		assets_csv += "\n";
+
+		for (const auto& asset : this->assets_)
+		{
+			assets_csv += utils::string::va("%s,%s,%zu,%zu", escape_csv(asset.name).data(), asset.type, asset.offset, asset.size);
+			for (const auto stream : asset.streams)
+			{
+				assets_csv += utils::string::va(",%llu", stream);
+			}
+			assets_csv += "\n";
+		}
+
+		write_file(get_report_path(fastfile_path, "_sizes.csv"), assets_csv);
+
+		std::string blocks_csv = "index,offset,size,compressed_size,ratio,assets,largest_asset,largest_type\n";
+		for (auto i = 0u; i < blocks.size(); i++)
+		{
+			const auto& block = blocks[i];
+			blocks_csv += utils::string::va("%u,%zu,%zu,%zu,%.4f,%zu,%s,%s\n", i, block.offset, block.size, block.compressed_size,
+				get_ratio(block.compressed_size, block.size), block.asset_count,
+				block.largest_asset ? escape_csv(block.largest_asset->name).data() : "",
+				block.largest_asset ? block.largest_asset->type : "");
+		}
+
+		write_file(get_report_path(fastfile_path, "_blocks.csv"), blocks_csv);
+
+		ZONETOOL_INFO("Wrote size report for %zu assets, %zu blocks at %.1f%% of their size", this->assets_.size(),
+			blocks.size(), get_ratio(compressed_total, this->buf_->size()) * 100.0);
+	}
+}
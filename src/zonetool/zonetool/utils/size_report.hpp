@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace zonetool
+{
+	class asset_interface;
+	class zone_buffer;
+
+	// records how many bytes every written asset adds to each stream and to the zone,
+	// enabled with -sizereport and saved next to the fastfile
+	class size_report
+	{
+	public:
+		// the codec the 64kb blocks are compressed with to estimate their ratio, should match the fastfile
+		enum class codec
+		{
+			zlib,
+			lz4,
+		};
+
+		size_report(zone_buffer* buf, std::size_t stream_count);
+
+		bool is_enabled() const;
+
+		// bracket one asset->write
+		void begin_asset();
+		void end_asset(asset_interface* asset, const char* type);
+
+		// writes <fastfile>_sizes.json, <fastfile>_sizes.csv and <fastfile>_blocks.csv,
+		// must be called before the zone buffer is cleared
+		void save(const std::string& fastfile_path, codec block_codec) const;
+
+	private:
+		struct asset_entry
+		{
+			std::string name;
+			const char* type;
+			std::size_t offset;
+			std::size_t size;
+			std::vector<std::uint64_t> streams;
+		};
+
+		struct block_entry
+		{
+			std::size_t offset;
+			std::size_t size;
+			std::size_t compressed_size;
+			std::size_t asset_count;
+			// the asset with the most bytes in this block
+			const asset_entry* largest_asset;
+		};
+
+		std::vector<block_entry> compress_blocks(codec block_codec) const;
+
+		bool enabled_;
+		zone_buffer* buf_;
+		std::vector<std::uint64_t> stream_start_;
+		std::size_t size_start_ = 0;
+		std::vector<asset_entry> assets_;
+	};
+}
@@ -0,0 +1,163 @@
+#include <std_include.hpp>
+#include "task_pipeline.hpp"
+
+#include <utils/thread.hpp>
+
+namespace zonetool
+{
+	task_pipeline::~task_pipeline()
+	{
+		this->stop();
+	}
+
+	void task_pipeline::add(handler&& callback, const std::chrono::milliseconds interval)
+	{
+		{
+			std::lock_guard<std::mutex> _(this->mutex_);
+
+			task entry{};
+			entry.callback = std::move(callback);
+			entry.interval = interval;
+			entry.next_call = clock::now() + interval;
+			this->push(std::move(entry));
+		}
+
+		this->task_available_.notify_one();
+	}
+
+	void task_pipeline::push(task&& entry)
+	{
+		entry.sequence = this->sequence_++;
+		this->tasks_.emplace_back(std::move(entry));
+		std::push_heap(this->tasks_.begin(), this->tasks_.end(), due_later{});
+	}
+
+	task_pipeline::task task_pipeline::pop()
+	{
+		std::pop_heap(this->tasks_.begin(), this->tasks_.end(), due_later{});
+		auto entry = std::move(this->tasks_.back());
+		this->tasks_.pop_back();
+		return entry;
+	}
+
+	void task_pipeline::reschedule(task&& entry, const clock::time_point now)
+	{
+		entry.next_call = now + std::max(entry.interval, this->min_interval_);
+		this->push(std::move(entry));
+	}
+
+	void task_pipeline::execute()
+	{
+		const auto now = clock::now();
+
+		{
+			std::lock_guard<std::mutex> _(this->mutex_);
+			while (!this->tasks_.empty() && this->tasks_.front().next_call <= now)
+			{
+				this->due_.emplace_back(this->pop());
+			}
+		}
+
+		if (this->due_.empty())
+		{
+			return;
+		}
+
+		// handlers run unlocked so they can schedule more tasks, those wait for the next pass
+		auto keep = this->due_.begin();
+		for (auto i = this->due_.begin(); i != this->due_.end(); ++i)
+		{
+			if (!i->callback())
+			{
+				*keep++ = std::move(*i);
+			}
+		}
+
+		{
+			std::lock_guard<std::mutex> _(this->mutex_);
+			for (auto i = this->due_.begin(); i != keep; ++i)
+			{
+				this->reschedule(std::move(*i), now);
+			}
+		}
+
+		this->due_.clear();
+	}
+
+	void task_pipeline::start(const std::string& name, const std::size_t worker_count,
+		const std::chrono::milliseconds min_interval)
+	{
+		std::lock_guard<std::mutex> _(this->mutex_);
+
+		this->stopping_ = false;
+		this->min_interval_ = min_interval;
+
+		const auto count = std::max(worker_count, std::size_t(1));
+		for (auto i = 0u; i < count; i++)
+		{
+			this->workers_.emplace_back(utils::thread::create_named_thread(name + " " + std::to_string(i), [this]
+			{
+				this->work();
+			}));
+		}
+	}
+
+	void task_pipeline::stop()
+	{
+		{
+			std::lock_guard<std::mutex> _(this->mutex_);
+			this->stopping_ = true;
+		}
+
+		this->task_available_.notify_all();
+
+		for (auto& worker : this->workers_)
+		{
+			if (worker.joinable())
+			{
+				worker.join();
+			}
+		}
+
+		this->workers_.clear();
+	}
+
+	void task_pipeline::work()
+	{
+		std::unique_lock<std::mutex> lock(this->mutex_);
+
+		while (!this->stopping_)
+		{
+			if (this->tasks_.empty())
+			{
+				this->task_available_.wait(lock);
+				continue;
+			}
+
+			// sleep until the earliest task is due, a new task or shutdown wakes us early
+			const auto next_call = this->tasks_.front().next_call;
+			if (next_call > clock::now())
+			{
+				this->task_available_.wait_until(lock, next_call);
+				continue;
+			}
+
+			// a popped task belongs to this worker alone, so a handler never runs concurrently with itself
+			auto entry = this->pop();
+			lock.unlock();
+
+			const auto now = clock::now();
+			const auto done = entry.callback();
+
+			lock.lock();
+
+			if (!done)
+			{
+				this->reschedule(std::move(entry), now);
+				lock.unlock();
+				this->task_available_.notify_one();
+				lock.lock();
+			}
+		}
+	}
+}
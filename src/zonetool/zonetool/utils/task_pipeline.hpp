@@ -0,0 +1,75 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace zonetool
+{
+	// timer queue backing the per-game scheduler components
+	// tasks sit in a min-heap keyed by their next due time, so a pass only touches tasks that are actually due
+	class task_pipeline
+	{
+	public:
+		using clock = std::chrono::steady_clock;
+		using handler = std::function<bool()>;
+
+		task_pipeline() = default;
+		~task_pipeline();
+
+		task_pipeline(const task_pipeline&) = delete;
+		task_pipeline& operator=(const task_pipeline&) = delete;
+
+		// a handler returning true is removed, false keeps it scheduled every interval
+		void add(handler&& callback, std::chrono::milliseconds interval);
+
+		// runs every task that is due on the calling thread
+		void execute();
+
+		// runs the pipeline on its own workers, min_interval caps how often a single task can repeat
+		void start(const std::string& name, std::size_t worker_count, std::chrono::milliseconds min_interval);
+		void stop();
+
+	private:
+		struct task
+		{
+			handler callback;
+			std::chrono::milliseconds interval;
+			clock::time_point next_call;
+			std::uint64_t sequence;
+		};
+
+		// std heap functions build a max-heap, so "less" means "due later"
+		struct due_later
+		{
+			bool operator()(const task& a, const task& b) const
+			{
+				if (a.next_call != b.next_call)
+				{
+					return a.next_call > b.next_call;
+				}
+
+				return a.sequence > b.sequence;
+			}
+		};
+
+		void push(task&& entry);
+		task pop();
+		void reschedule(task&& entry, clock::time_point now);
+		void work();
+
+		std::mutex mutex_;
+		std::condition_variable task_available_;
+
+		std::vector<task> tasks_;
+		std::vector<task> due_;
+		std::vector<std::thread> workers_;
+
+		std::uint64_t sequence_ = 0;
+		std::chrono::milliseconds min_interval_{};
+		bool stopping_ = false;
+	};
+}
@@ -6,6 +6,10 @@
 #include "io/assetmanager.hpp"
 
 #include "csv.hpp"
+#include "zone_load_event.hpp"
+#include "asset_order.hpp"
+#include "asset_prefetch.hpp"
+#include "log.hpp"
 
 #include "shader.hpp"
 #include "game/mode.hpp"
@@ -40,18 +44,19 @@ namespace nlohmann
 #define MAX_MEM_SIZE (1024ull * 1024ull * 1024ull) * 2ull
 
 #define ZONETOOL_INFO(__FMT__, ...) \
-	printf("[ INFO ][ %s ]: " __FMT__ "\n", zonetool::strip_template(__FUNCTION__), __VA_ARGS__)
+	zonetool::log::write(zonetool::log::level::info, __FUNCTION__, __FMT__, __VA_ARGS__)
 
 #define ZONETOOL_ERROR(__FMT__, ...) \
-	printf("[ ERROR ][ %s ]: " __FMT__ "\n", zonetool::strip_template(__FUNCTION__), __VA_ARGS__)
+	zonetool::log::write(zonetool::log::level::error, __FUNCTION__, __FMT__, __VA_ARGS__)
 
 #define ZONETOOL_FATAL(__FMT__, ...) \
-	printf("[ FATAL ][ %s ]: " __FMT__ "\n", zonetool::strip_template(__FUNCTION__), __VA_ARGS__); \
+	zonetool::log::write(zonetool::log::level::fatal, __FUNCTION__, __FMT__, __VA_ARGS__); \
+	zonetool::log::flush(); \
 	MessageBoxA(nullptr, &utils::string::va("Oops! An unexpected error occured. Error was: \n" __FMT__ "\n\nZoneTool must be restarted to resolve the error. Last error code reported by windows: 0x%08X (%u)", __VA_ARGS__, GetLastError(), GetLastError())[0], nullptr, MB_ICONERROR); \
 	std::quick_exit(EXIT_FAILURE)
 
 #define ZONETOOL_WARNING(__FMT__, ...) \
-	printf("[ WARNING ][ %s ]: " __FMT__ "\n", zonetool::strip_template(__FUNCTION__), __VA_ARGS__)
+	zonetool::log::write(zonetool::log::level::warning, __FUNCTION__, __FMT__, __VA_ARGS__)
 
 namespace zonetool
 {
@@ -63,5 +68,6 @@ namespace zonetool
 		bool dump_csv;
 		game::game_mode target_game;
 		filesystem::file csv_file;
+		zone_load_event load_finished;
 	};
 }
@@ -0,0 +1,127 @@
+#include <std_include.hpp>
+#include "vertex_convert.hpp"
+
+#include "game/half_float.hpp"
+
+#include <emmintrin.h>
+
+namespace zonetool::vertex_convert
+{
+	namespace
+	{
+		// keeps lanes 0-2 of a and lane 3 of b
+		__m128i select_xyz(const __m128i a, const __m128i b)
+		{
+			const auto mask = _mm_set_epi32(0, -1, -1, -1);
+			return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+		}
+
+		std::uint32_t get_influence_count(const stream_weight& weight)
+		{
+			return (weight.values[1] != 0) + (weight.values[2] != 0) + (weight.values[3] != 0);
+		}
+	}
+
+	void interleave(packed_vertex* dst, const float (*positions)[3], const stream_vertex* verts, const std::uint32_t w, const std::size_t count)
+	{
+		if (!count)
+		{
+			return;
+		}
+
+		const auto w_lane = _mm_set1_epi32(static_cast<int>(w));
+
+		// the 16 byte position load reads into the next position, the last one is done by hand
+		for (auto i = 0u; i < count - 1; i++)
+		{
+			const auto xyz = _mm_loadu_si128(reinterpret_cast<const __m128i*>(positions[i]));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(&dst[i]), select_xyz(xyz, w_lane));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(&dst[i].color), _mm_loadu_si128(reinterpret_cast<const __m128i*>(&verts[i])));
+		}
+
+		auto& last = dst[count - 1];
+		std::memcpy(last.xyz, positions[count - 1], sizeof(last.xyz));
+		last.w = w;
+		std::memcpy(&last.color, &verts[count - 1], sizeof(stream_vertex));
+	}
+
+	void extract_position_normals(position_normal* dst, const packed_vertex* verts, const std::size_t count)
+	{
+		for (auto i = 0u; i < count; i++)
+		{
+			const auto xyz = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&verts[i]));
+			const auto tail = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&verts[i].color));
+
+			// normal is lane 2 of the tail, move it to lane 3
+			const auto normal = _mm_shuffle_epi32(tail, _MM_SHUFFLE(2, 2, 2, 2));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(&dst[i]), select_xyz(xyz, normal));
+		}
+	}
+
+	void floats_to_halves(std::uint16_t* dst, const float* src, const std::size_t count)
+	{
+		const auto exponent_mask = _mm_set1_epi32(0x7F800000);
+		const auto mantissa_mask = _mm_set1_epi32(0x007FFFFF);
+		const auto sign_mask = _mm_set1_epi32(static_cast<int>(0x80000000));
+
+		auto i = 0u;
+		for (; i + 4 <= count; i += 4)
+		{
+			const auto b = _mm_add_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&src[i])), _mm_set1_epi32(0x00001000));
+			const auto e = _mm_srli_epi32(_mm_and_si128(b, exponent_mask), 23);
+			const auto m = _mm_and_si128(b, mantissa_mask);
+
+			// denormals need a per lane shift, sse2 has none
+			const auto denormal = _mm_and_si128(_mm_cmpgt_epi32(e, _mm_set1_epi32(101)), _mm_cmplt_epi32(e, _mm_set1_epi32(113)));
+			if (_mm_movemask_epi8(denormal))
+			{
+				for (auto j = i; j < i + 4; j++)
+				{
+					dst[j] = half_float::float_to_half(src[j]);
+				}
+
+				continue;
+			}
+
+			const auto normal = _mm_or_si128(
+				_mm_and_si128(_mm_slli_epi32(_mm_sub_epi32(e, _mm_set1_epi32(112)), 10), _mm_set1_epi32(0x7C00)),
+				_mm_srli_epi32(m, 13));
+
+			auto half = _mm_srli_epi32(_mm_and_si128(b, sign_mask), 16);
+			half = _mm_or_si128(half, _mm_and_si128(_mm_cmpgt_epi32(e, _mm_set1_epi32(112)), normal));
+			half = _mm_or_si128(half, _mm_and_si128(_mm_cmpgt_epi32(e, _mm_set1_epi32(143)), _mm_set1_epi32(0x7FFF)));
+
+			// sign extend the low 16 bits so the signed saturating pack keeps them as is
+			half = _mm_srai_epi32(_mm_slli_epi32(half, 16), 16);
+			_mm_storel_epi64(reinterpret_cast<__m128i*>(&dst[i]), _mm_packs_epi32(half, half));
+		}
+
+		for (; i < count; i++)
+		{
+			dst[i] = half_float::float_to_half(src[i]);
+		}
+	}
+
+	blend_buckets bucket_blend_weights(const stream_weight* weights, const std::size_t count)
+	{
+		blend_buckets buckets{};
+		for (auto i = 0u; i < count; i++)
+		{
+			buckets.counts[get_influence_count(weights[i])]++;
+		}
+
+		std::array<std::uint32_t, 4> offsets{};
+		for (auto i = 1u; i < offsets.size(); i++)
+		{
+			offsets[i] = offsets[i - 1] + buckets.counts[i - 1];
+		}
+
+		buckets.order.resize(count);
+		for (auto i = 0u; i < count; i++)
+		{
+			buckets.order[offsets[get_influence_count(weights[i])]++] = i;
+		}
+
+		return buckets;
+	}
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace zonetool::vertex_convert
+{
+	// the 32 byte vertex h1, iw6 and iw7 share: xyz, one game specific dword (binormal sign, self visibility, motion height)
+	// and the colour/texcoord/normal/tangent block
+	struct packed_vertex
+	{
+		float xyz[3];
+		std::uint32_t w;
+		std::uint32_t color;
+		std::uint32_t tex_coord;
+		std::uint32_t normal;
+		std::uint32_t tangent;
+	};
+
+	// t7 GfxStreamVertex, the same block as the tail of packed_vertex
+	struct stream_vertex
+	{
+		std::uint32_t color;
+		std::uint32_t tex_coord;
+		std::uint32_t normal;
+		std::uint32_t tangent;
+	};
+
+	// t7 GfxStreamWeight
+	struct stream_weight
+	{
+		std::uint8_t values[4];
+		std::uint16_t ids[4];
+	};
+
+	// h1 UnknownXSurface0
+	struct position_normal
+	{
+		float xyz[3];
+		std::uint32_t normal;
+	};
+
+	static_assert(sizeof(packed_vertex) == 32);
+	static_assert(sizeof(stream_vertex) == 16);
+	static_assert(sizeof(stream_weight) == 12);
+	static_assert(sizeof(position_normal) == 16);
+
+	// builds packed vertices from a position stream and a vertex stream, w is written to every vertex
+	void interleave(packed_vertex* dst, const float (*positions)[3], const stream_vertex* verts, std::uint32_t w, std::size_t count);
+
+	void extract_position_normals(position_normal* dst, const packed_vertex* verts, std::size_t count);
+
+	// bit exact with half_float::float_to_half
+	void floats_to_halves(std::uint16_t* dst, const float* src, std::size_t count);
+
+	// weights grouped by influence count (1-4), stable within a group
+	struct blend_buckets
+	{
+		std::array<std::uint16_t, 4> counts;
+		std::vector<std::uint32_t> order;
+	};
+
+	blend_buckets bucket_blend_weights(const stream_weight* weights, std::size_t count);
+}
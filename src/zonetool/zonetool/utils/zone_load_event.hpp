@@ -0,0 +1,106 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace zonetool
+{
+	// completion signal for zones loaded through DB_LoadXAssets
+	// armed by the thread requesting the load with the zones it waits for, signalled from the db_finish_load_x_file hook
+	class zone_load_event
+	{
+	public:
+		void arm(const std::string& zone)
+		{
+			this->arm(std::vector<std::string>{zone});
+		}
+
+		// the database finishes zones in the order they were requested
+		void arm(const std::vector<std::string>& zones)
+		{
+			std::lock_guard<std::mutex> _(this->mutex_);
+			this->zones_.assign(zones.begin(), zones.end());
+		}
+
+		void cancel()
+		{
+			std::lock_guard<std::mutex> _(this->mutex_);
+			this->zones_.clear();
+		}
+
+		// other zones finishing meanwhile, like ones the game loads itself, don't count
+		bool is_awaited(const std::string& zone)
+		{
+			std::lock_guard<std::mutex> _(this->mutex_);
+			return this->is_next(zone);
+		}
+
+		void signal(const std::string& zone)
+		{
+			{
+				std::lock_guard<std::mutex> _(this->mutex_);
+				if (!this->is_next(zone))
+				{
+					return;
+				}
+
+				this->zones_.pop_front();
+			}
+
+			this->cv_.notify_all();
+		}
+
+		// runs callback with the event locked, for state the requesting thread shares with the finish hook
+		template <typename Callback>
+		auto access(Callback&& callback)
+		{
+			std::lock_guard<std::mutex> _(this->mutex_);
+			return callback();
+		}
+
+		// false if the database went idle before every armed zone finished, a zone that fails to load never reaches
+		// the finish hook. is_database_idle is polled, it has to stay true for idle_timeout to count as a failure
+		bool wait(const std::function<bool()>& is_database_idle,
+			const std::chrono::milliseconds idle_timeout = std::chrono::milliseconds(2000))
+		{
+			constexpr auto poll_interval = std::chrono::milliseconds(50);
+
+			std::unique_lock<std::mutex> lock(this->mutex_);
+			auto idle_time = std::chrono::milliseconds(0);
+
+			while (!this->cv_.wait_for(lock, poll_interval, [this]
+			{
+				return this->zones_.empty();
+			}))
+			{
+				lock.unlock();
+				const auto idle = is_database_idle();
+				lock.lock();
+
+				idle_time = idle ? idle_time + poll_interval : std::chrono::milliseconds(0);
+				if (idle_time >= idle_timeout && !this->zones_.empty())
+				{
+					this->zones_.clear();
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+	private:
+		bool is_next(const std::string& zone) const
+		{
+			return !this->zones_.empty() && !_stricmp(zone.data(), this->zones_.front().data());
+		}
+
+		std::mutex mutex_;
+		std::condition_variable cv_;
+		std::deque<std::string> zones_;
+	};
+}